@@ -0,0 +1,691 @@
+/**
+ * @file bench.c
+ * @brief Space Mission Control System - Microbenchmark Harness
+ *
+ * Sweeps every core operation over decade sizes (1e3 .. 1e7 by default)
+ * and reports ns/op, allocations and peak RSS. Each (operation, size)
+ * case runs in its own forked child so that peak RSS is measured per
+ * case and a runaway case cannot take the whole sweep down.
+ *
+ * Built by `make bench` as a separate optimized target. Allocations are
+ * counted by linking with -Wl,--wrap for malloc/calloc/realloc/free, so
+ * only calls made from the library sources are seen.
+ *
+ * Usage: space_mission_bench [-s min] [-S max] [-r repeats] [-b budget_s]
+ *                            [-l label] [-o results.csv] [-k shards] [op ...]
+ *   op is any of: create add_comm add_comm_dedup add_comm_reorder load load_lazy save totals
+ *                 ack_by_id free shard_add
+ *   (default: all)
+ *   add_comm_dedup is add_comm with enable_comm_dedup() and no repeated logs
+ *   add_comm_reorder is add_comm with enable_comm_reorder(), each mission's logs
+ *   arriving up to BENCH_REORDER_SKEW minutes out of order
+ *   load_lazy is load through load_missions_from_file_lazy() (index only)
+ *   totals is one get_mission_totals() pass (build with HOTCOLD=1 to compare layouts)
+ *   ack_by_id is acknowledge_communication_by_id() on n logs in scattered ID order
+ *   shard_add is add_comm through a sharded front-end with -k shards
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "space_mission.h"
+
+#include <errno.h>
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <time.h>
+
+/* ========================================
+ * BENCHMARK CONSTANTS
+ * ======================================== */
+#define BENCH_MIN_SIZE_DEFAULT 1000L
+#define BENCH_MAX_SIZE_DEFAULT 10000000L
+#define BENCH_REPEATS_DEFAULT 5
+#define BENCH_MAX_REPEATS 101
+#define BENCH_BUDGET_DEFAULT 5.0     // Seconds a single case may take
+#define BENCH_COMM_MISSIONS 64       // Missions that receive add_comm traffic
+#define BENCH_COMMS_PER_MISSION 2    // Comms per mission for save/free setup
+#define BENCH_SHARDS_DEFAULT 4       // Shards for shard_add
+#define BENCH_DEDUP_MESSAGES 64      // Distinct messages for add_comm_dedup
+#define BENCH_REORDER_SKEW 3         // Arrival skew for add_comm_reorder (2^k - 1)
+
+/* ========================================
+ * ALLOCATION COUNTING (-Wl,--wrap)
+ * ======================================== */
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void __real_free(void* ptr);
+
+static long g_alloc_calls = 0;
+static long g_alloc_bytes = 0;
+
+// Atomic because shard workers allocate concurrently
+static void count_allocation(size_t bytes) {
+    __atomic_add_fetch(&g_alloc_calls, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&g_alloc_bytes, (long)bytes, __ATOMIC_RELAXED);
+}
+
+void* __wrap_malloc(size_t size) {
+    count_allocation(size);
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    count_allocation(count * size);
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+    count_allocation(size);
+    return __real_realloc(ptr, size);
+}
+
+void __wrap_free(void* ptr) {
+    __real_free(ptr);
+}
+
+/* ========================================
+ * RESULT TYPES
+ * ======================================== */
+typedef struct {
+    int ok;                 // 1 if the case ran to completion
+    int repeats;            // Repeats actually measured
+    double median_ns;       // Median ns/op across repeats
+    double min_ns;          // Fastest repeat, ns/op
+    double max_ns;          // Slowest repeat, ns/op
+    long allocs;            // Allocation calls in one timed run
+    long alloc_bytes;       // Bytes requested in one timed run
+    long peak_rss_kb;       // Peak RSS of the case process
+    double wall_s;          // Total wall time of the case incl. setup
+} BenchResult;
+
+typedef struct {
+    const char* name;
+    // Runs one repetition of size n and returns the timed nanoseconds
+    // (setup excluded), or a negative value on failure.
+    double (*run)(long n);
+} BenchOp;
+
+/* ========================================
+ * TIMING UTILITIES
+ * ======================================== */
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static int compare_doubles(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/* ========================================
+ * FIXTURE HELPERS (untimed)
+ * ======================================== */
+static const char* bench_timestamp(long i) {
+    static char ts[MAX_TIMESTAMP_LENGTH];
+    snprintf(ts, sizeof(ts), "2024-%02ld-%02ld %02ld:%02ld",
+             1 + (i / 1440) % 12, 1 + (i / 60) % 28, (i / 60) % 24, i % 60);
+    return ts;
+}
+
+static MissionControl* build_system(long missions, int comms_per_mission) {
+    MissionControl* system = create_mission_control(INITIAL_MISSION_CAPACITY);
+    if (system == NULL) {
+        return NULL;
+    }
+    for (long i = 0; i < missions; i++) {
+        if (create_mission_with_crew(system, (int)(i + 1), "Bench_Mission", "2024-06-15") != 0) {
+            free_mission_control(system);
+            return NULL;
+        }
+    }
+    for (int c = 0; c < comms_per_mission; c++) {
+        for (long i = 0; i < missions; i++) {
+            if (add_communication(system, (int)(i + 1), bench_timestamp(i),
+                                  (MessagePriority)(1 + (i + c) % 3), "Telemetry_nominal") != 0) {
+                free_mission_control(system);
+                return NULL;
+            }
+        }
+    }
+    return system;
+}
+
+static int write_mission_file(const char* path, long missions) {
+    FILE* fp = fopen(path, "w");
+    if (fp == NULL) {
+        return -1;
+    }
+    fprintf(fp, "%ld\n", missions);
+    for (long i = 0; i < missions; i++) {
+        fprintf(fp, "%ld Bench_Mission_%ld 2024-%02ld-%02ld\n",
+                i + 1, i, 1 + i % 12, 1 + i % 28);
+    }
+    return fclose(fp) == 0 ? 0 : -1;
+}
+
+static char g_tmp_dir[] = "/tmp/space_mission_bench_XXXXXX";
+static char g_data_path[300];
+static char g_report_path[300];
+
+/* ========================================
+ * BENCHMARKED OPERATIONS
+ * ======================================== */
+static double run_create(long n) {
+    MissionControl* system = create_mission_control(INITIAL_MISSION_CAPACITY);
+    if (system == NULL) {
+        return -1;
+    }
+    double start = now_ns();
+    for (long i = 0; i < n; i++) {
+        if (create_mission_with_crew(system, (int)(i + 1), "Bench_Mission", "2024-06-15") != 0) {
+            free_mission_control(system);
+            return -1;
+        }
+    }
+    double elapsed = now_ns() - start;
+    free_mission_control(system);
+    return elapsed;
+}
+
+static double time_add_comm(long n, int dedup) {
+    MissionControl* system = build_system(BENCH_COMM_MISSIONS, 0);
+    if (system == NULL || (dedup && enable_comm_dedup(system, 0) != 0)) {
+        free_mission_control(system);
+        return -1;
+    }
+    // Same length as "Telemetry_nominal"; a mission repeats a (message,
+    // priority) pair only every 3 * BENCH_DEDUP_MESSAGES of its logs
+    char messages[BENCH_DEDUP_MESSAGES][24];
+    for (int m = 0; m < BENCH_DEDUP_MESSAGES; m++) {
+        snprintf(messages[m], sizeof(messages[m]), "Telemetry_nomi_%02d", m);
+    }
+    double start = now_ns();
+    for (long i = 0; i < n; i++) {
+        const char* message = dedup ? messages[(i / BENCH_COMM_MISSIONS) % BENCH_DEDUP_MESSAGES]
+                                    : "Telemetry_nominal";
+        if (add_communication(system, (int)(1 + i % BENCH_COMM_MISSIONS), "2024-06-15 12:00",
+                              (MessagePriority)(1 + i % 3), message) != 0) {
+            free_mission_control(system);
+            return -1;
+        }
+    }
+    double elapsed = now_ns() - start;
+    free_mission_control(system);
+    return elapsed;
+}
+
+static double run_add_comm(long n) {
+    return time_add_comm(n, 0);
+}
+
+static double run_add_comm_dedup(long n) {
+    return time_add_comm(n, 1);
+}
+
+static double run_add_comm_reorder(long n) {
+    // A mission's j-th log is stamped minute j ^ BENCH_REORDER_SKEW: each
+    // group of four arrives newest first
+    long minutes = n / BENCH_COMM_MISSIONS + BENCH_REORDER_SKEW + 1;
+    char (*timestamps)[MAX_TIMESTAMP_LENGTH] = malloc((size_t)minutes * MAX_TIMESTAMP_LENGTH);
+    MissionControl* system = build_system(BENCH_COMM_MISSIONS, 0);
+    if (timestamps == NULL || system == NULL ||
+        enable_comm_reorder(system, BENCH_REORDER_SKEW, 0) != 0) {
+        free(timestamps);
+        free_mission_control(system);
+        return -1;
+    }
+    for (long m = 0; m < minutes; m++) {
+        time_t at = (time_t)1704067200 + (time_t)m * 60;    // From 2024-01-01 00:00 UTC
+        struct tm fields;
+        gmtime_r(&at, &fields);
+        strftime(timestamps[m], MAX_TIMESTAMP_LENGTH, "%Y-%m-%d %H:%M", &fields);
+    }
+    double start = now_ns();
+    int failed = 0;
+    for (long i = 0; i < n && !failed; i++) {
+        long minute = (i / BENCH_COMM_MISSIONS) ^ BENCH_REORDER_SKEW;
+        failed = add_communication(system, (int)(1 + i % BENCH_COMM_MISSIONS), timestamps[minute],
+                                   (MessagePriority)(1 + i % 3), "Telemetry_nominal") != 0;
+    }
+    failed = failed || flush_comm_reorder(system) < 0;
+    double elapsed = now_ns() - start;
+    free_mission_control(system);
+    free(timestamps);
+    return failed ? -1 : elapsed;
+}
+
+static double time_load(long n, int (*load)(MissionControl*, const char*)) {
+    static long written = -1;
+    if (written != n) {
+        if (write_mission_file(g_data_path, n) != 0) {
+            return -1;
+        }
+        written = n;
+    }
+    MissionControl* system = create_mission_control(INITIAL_MISSION_CAPACITY);
+    if (system == NULL) {
+        return -1;
+    }
+    double start = now_ns();
+    int result = load(system, g_data_path);
+    double elapsed = now_ns() - start;
+    free_mission_control(system);
+    return result == 0 ? elapsed : -1;
+}
+
+static double run_load(long n) {
+    return time_load(n, load_missions_from_file);
+}
+
+static double run_load_lazy(long n) {
+    return time_load(n, load_missions_from_file_lazy);
+}
+
+static double run_save(long n) {
+    MissionControl* system = build_system(n, BENCH_COMMS_PER_MISSION);
+    if (system == NULL) {
+        return -1;
+    }
+    double start = now_ns();
+    int result = save_mission_report(system, g_report_path);
+    double elapsed = now_ns() - start;
+    free_mission_control(system);
+    return result == 0 ? elapsed : -1;
+}
+
+static double run_totals(long n) {
+    MissionControl* system = build_system(n, BENCH_COMMS_PER_MISSION);
+    if (system == NULL) {
+        return -1;
+    }
+    MissionTotals totals;
+    double start = now_ns();
+    int result = get_mission_totals(system, &totals);
+    double elapsed = now_ns() - start;
+    free_mission_control(system);
+    return result == 0 && totals.missions == n ? elapsed : -1;
+}
+
+static double run_ack_by_id(long n) {
+    MissionControl* system = build_system(n, BENCH_COMMS_PER_MISSION);
+    if (system == NULL) {
+        return -1;
+    }
+    long logs = n * BENCH_COMMS_PER_MISSION;
+    int failed = 0;
+    double start = now_ns();
+    for (long i = 0; i < n && !failed; i++) {
+        // A large prime stride visits the IDs in no particular mission order
+        failed = acknowledge_communication_by_id(system, (int)(1 + (i * 1000003L) % logs)) != 0;
+    }
+    double elapsed = now_ns() - start;
+    free_mission_control(system);
+    return failed ? -1 : elapsed;
+}
+
+static double run_free(long n) {
+    MissionControl* system = build_system(n, BENCH_COMMS_PER_MISSION);
+    if (system == NULL) {
+        return -1;
+    }
+    double start = now_ns();
+    free_mission_control(system);
+    return now_ns() - start;
+}
+
+static int g_shard_count = BENCH_SHARDS_DEFAULT;
+
+// Missions are spread over the shards; timing includes the final drain
+static double run_shard_add(long n) {
+    ShardedMissionControl* sharded = create_sharded_mission_control(g_shard_count,
+                                                                    INITIAL_MISSION_CAPACITY, 1);
+    if (sharded == NULL) {
+        return -1;
+    }
+    int missions = BENCH_COMM_MISSIONS * g_shard_count;
+    for (int id = 1; id <= missions; id++) {
+        sharded_create_mission(sharded, id, "Bench_Mission", "2024-06-15");
+    }
+    if (sharded_sync(sharded) != 0) {
+        free_sharded_mission_control(sharded);
+        return -1;
+    }
+    double start = now_ns();
+    for (long i = 0; i < n; i++) {
+        sharded_add_communication(sharded, (int)(1 + i % missions), "2024-06-15 12:00",
+                                  (MessagePriority)(1 + i % 3), "Telemetry_nominal");
+    }
+    long rejected = sharded_sync(sharded);
+    double elapsed = now_ns() - start;
+    free_sharded_mission_control(sharded);
+    return rejected == 0 ? elapsed : -1;
+}
+
+static const BenchOp g_ops[] = {
+    {"create", run_create},
+    {"add_comm", run_add_comm},
+    {"add_comm_dedup", run_add_comm_dedup},
+    {"add_comm_reorder", run_add_comm_reorder},
+    {"load", run_load},
+    {"load_lazy", run_load_lazy},
+    {"save", run_save},
+    {"totals", run_totals},
+    {"ack_by_id", run_ack_by_id},
+    {"free", run_free},
+    {"shard_add", run_shard_add},
+};
+#define BENCH_OP_COUNT ((int)(sizeof(g_ops) / sizeof(g_ops[0])))
+
+/* ========================================
+ * CASE EXECUTION (one forked child per case)
+ * ======================================== */
+static void run_case_child(const BenchOp* op, long n, int repeats, int out_fd) {
+    BenchResult result = {0};
+    double samples[BENCH_MAX_REPEATS];
+    double case_start = now_ns();
+
+    for (int r = 0; r < repeats; r++) {
+        long calls_before = g_alloc_calls;
+        long bytes_before = g_alloc_bytes;
+        double ns = op->run(n);
+        if (ns < 0) {
+            break;
+        }
+        if (r == 0) {
+            // Includes the untimed fixture; main() subtracts it afterwards
+            result.allocs = g_alloc_calls - calls_before;
+            result.alloc_bytes = g_alloc_bytes - bytes_before;
+        }
+        samples[result.repeats++] = ns / (double)n;
+    }
+
+    if (result.repeats == repeats) {
+        qsort(samples, (size_t)repeats, sizeof(double), compare_doubles);
+        result.ok = 1;
+        result.median_ns = samples[repeats / 2];
+        result.min_ns = samples[0];
+        result.max_ns = samples[repeats - 1];
+    }
+
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        result.peak_rss_kb = usage.ru_maxrss;
+    }
+    result.wall_s = (now_ns() - case_start) / 1e9;
+
+    ssize_t written = write(out_fd, &result, sizeof(result));
+    _exit(written == (ssize_t)sizeof(result) ? 0 : 1);
+}
+
+static int run_case(const BenchOp* op, long n, int repeats, BenchResult* result) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return -1;
+    }
+
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return -1;
+    }
+    if (pid == 0) {
+        close(fds[0]);
+        run_case_child(op, n, repeats, fds[1]);
+    }
+
+    close(fds[1]);
+    ssize_t got = read(fds[0], result, sizeof(*result));
+    close(fds[0]);
+
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+    }
+    if (got != (ssize_t)sizeof(*result) || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        return -1;
+    }
+    return result->ok ? 0 : -1;
+}
+
+/* ========================================
+ * FIXTURE SUBTRACTION
+ * ======================================== */
+// Allocation counts from the child include the untimed fixture. For the
+// fixture-heavy ops, measure the fixture alone and report the difference.
+static long g_fixture_allocs = 0;
+static long g_fixture_bytes = 0;
+
+static double run_fixture_only(long n) {
+    MissionControl* system = build_system(n, BENCH_COMMS_PER_MISSION);
+    if (system == NULL) {
+        return -1;
+    }
+    free_mission_control(system);
+    return 1;
+}
+
+static double run_comm_fixture_only(long n) {
+    (void)n;
+    MissionControl* system = build_system(BENCH_COMM_MISSIONS, 0);
+    if (system == NULL) {
+        return -1;
+    }
+    free_mission_control(system);
+    return 1;
+}
+
+static double run_empty_system_only(long n) {
+    (void)n;
+    MissionControl* system = create_mission_control(INITIAL_MISSION_CAPACITY);
+    if (system == NULL) {
+        return -1;
+    }
+    free_mission_control(system);
+    return 1;
+}
+
+static double run_shard_fixture_only(long n) {
+    (void)n;
+    ShardedMissionControl* sharded = create_sharded_mission_control(g_shard_count,
+                                                                    INITIAL_MISSION_CAPACITY, 1);
+    if (sharded == NULL) {
+        return -1;
+    }
+    for (int id = 1; id <= BENCH_COMM_MISSIONS * g_shard_count; id++) {
+        sharded_create_mission(sharded, id, "Bench_Mission", "2024-06-15");
+    }
+    sharded_sync(sharded);
+    free_sharded_mission_control(sharded);
+    return 1;
+}
+
+static void measure_fixture(const BenchOp* op, long n) {
+    BenchOp fixture = {"fixture", run_empty_system_only};
+    if (strcmp(op->name, "save") == 0 || strcmp(op->name, "free") == 0 ||
+        strcmp(op->name, "totals") == 0 || strcmp(op->name, "ack_by_id") == 0) {
+        fixture.run = run_fixture_only;
+    } else if (strcmp(op->name, "add_comm") == 0 || strcmp(op->name, "add_comm_dedup") == 0 ||
+               strcmp(op->name, "add_comm_reorder") == 0) {
+        fixture.run = run_comm_fixture_only;
+    } else if (strcmp(op->name, "shard_add") == 0) {
+        fixture.run = run_shard_fixture_only;
+    }
+
+    BenchResult base;
+    g_fixture_allocs = 0;
+    g_fixture_bytes = 0;
+    if (run_case(&fixture, n, 1, &base) == 0) {
+        g_fixture_allocs = base.allocs;
+        g_fixture_bytes = base.alloc_bytes;
+    }
+}
+
+/* ========================================
+ * REPORTING
+ * ======================================== */
+// Wide enough for the longest op name
+static int op_column_width(void) {
+    int width = (int)strlen("op");
+    for (int k = 0; k < BENCH_OP_COUNT; k++) {
+        int length = (int)strlen(g_ops[k].name);
+        if (length > width) {
+            width = length;
+        }
+    }
+    return width;
+}
+
+static void print_header(void) {
+    printf("%-*s %10s %7s %12s %12s %12s %12s %14s %12s\n",
+           op_column_width(), "op", "size", "repeats", "median_ns", "min_ns", "max_ns",
+           "allocs", "alloc_bytes", "peak_rss_kb");
+}
+
+static void print_result(FILE* csv, const char* label, const char* op, long n,
+                         const BenchResult* r) {
+    printf("%-*s %10ld %7d %12.1f %12.1f %12.1f %12ld %14ld %12ld\n",
+           op_column_width(), op, n, r->repeats, r->median_ns, r->min_ns, r->max_ns,
+           r->allocs, r->alloc_bytes, r->peak_rss_kb);
+    if (csv != NULL) {
+        fprintf(csv, "%s,%s,%ld,%d,%.1f,%.1f,%.1f,%ld,%ld,%ld\n",
+                label, op, n, r->repeats, r->median_ns, r->min_ns, r->max_ns,
+                r->allocs, r->alloc_bytes, r->peak_rss_kb);
+    }
+}
+
+static void usage(const char* prog) {
+    fprintf(stderr, "Usage: %s [-s min] [-S max] [-r repeats] [-b budget_s] "
+                    "[-l label] [-o results.csv] [-k shards] [op ...]\n", prog);
+    fprintf(stderr, "  ops:");
+    for (int i = 0; i < BENCH_OP_COUNT; i++) {
+        fprintf(stderr, " %s", g_ops[i].name);
+    }
+    fprintf(stderr, "\n");
+}
+
+/* ========================================
+ * MAIN FUNCTION
+ * ======================================== */
+int main(int argc, char* argv[]) {
+    long min_size = BENCH_MIN_SIZE_DEFAULT;
+    long max_size = BENCH_MAX_SIZE_DEFAULT;
+    int repeats = BENCH_REPEATS_DEFAULT;
+    double budget = BENCH_BUDGET_DEFAULT;
+    const char* label = "local";
+    const char* csv_path = NULL;
+    int selected[BENCH_OP_COUNT] = {0};
+    int any_selected = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (arg[0] == '-' && value == NULL) {
+            usage(argv[0]);
+            return 1;
+        }
+        if (strcmp(arg, "-s") == 0) {
+            min_size = atol(value); i++;
+        } else if (strcmp(arg, "-S") == 0) {
+            max_size = atol(value); i++;
+        } else if (strcmp(arg, "-r") == 0) {
+            repeats = atoi(value); i++;
+        } else if (strcmp(arg, "-b") == 0) {
+            budget = atof(value); i++;
+        } else if (strcmp(arg, "-l") == 0) {
+            label = value; i++;
+        } else if (strcmp(arg, "-o") == 0) {
+            csv_path = value; i++;
+        } else if (strcmp(arg, "-k") == 0) {
+            g_shard_count = atoi(value); i++;
+        } else {
+            int found = 0;
+            for (int k = 0; k < BENCH_OP_COUNT; k++) {
+                if (strcmp(arg, g_ops[k].name) == 0) {
+                    selected[k] = 1;
+                    found = any_selected = 1;
+                }
+            }
+            if (!found) {
+                usage(argv[0]);
+                return 1;
+            }
+        }
+    }
+
+    if (min_size <= 0 || max_size < min_size || max_size > 2000000000L ||
+        repeats <= 0 || repeats > BENCH_MAX_REPEATS || budget <= 0 || g_shard_count <= 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (mkdtemp(g_tmp_dir) == NULL) {
+        perror("mkdtemp");
+        return 1;
+    }
+    snprintf(g_data_path, sizeof(g_data_path), "%s/missions.txt", g_tmp_dir);
+    snprintf(g_report_path, sizeof(g_report_path), "%s/report.txt", g_tmp_dir);
+
+    FILE* csv = NULL;
+    if (csv_path != NULL) {
+        csv = fopen(csv_path, "w");
+        if (csv == NULL) {
+            perror(csv_path);
+            return 1;
+        }
+        fprintf(csv, "label,op,size,repeats,median_ns_per_op,min_ns_per_op,max_ns_per_op,"
+                     "allocs,alloc_bytes,peak_rss_kb\n");
+    }
+
+    print_header();
+    for (int k = 0; k < BENCH_OP_COUNT; k++) {
+        if (any_selected && !selected[k]) {
+            continue;
+        }
+        const BenchOp* op = &g_ops[k];
+        double prev_wall = 0;
+        double last_wall = 0;
+
+        for (long n = min_size; n <= max_size; n *= 10) {
+            // Extrapolate from the observed growth between the last two
+            // sizes so quadratic paths stop before they blow the budget.
+            if (last_wall > 0) {
+                double growth = prev_wall > 0 ? last_wall / prev_wall : 10.0;
+                if (growth < 10.0) {
+                    growth = 10.0;
+                }
+                if (last_wall * growth > budget) {
+                    printf("%-*s %10ld skipped (estimated %.1fs > budget %.1fs)\n",
+                           op_column_width(), op->name, n, last_wall * growth, budget);
+                    break;
+                }
+            }
+
+            BenchResult result;
+            if (run_case(op, n, repeats, &result) != 0) {
+                printf("%-*s %10ld FAILED\n", op_column_width(), op->name, n);
+                break;
+            }
+            measure_fixture(op, n);
+            result.allocs -= g_fixture_allocs;
+            result.alloc_bytes -= g_fixture_bytes;
+            print_result(csv, label, op->name, n, &result);
+
+            prev_wall = last_wall;
+            last_wall = result.wall_s / repeats;
+        }
+    }
+
+    if (csv != NULL) {
+        fclose(csv);
+    }
+    remove(g_data_path);
+    remove(g_report_path);
+    rmdir(g_tmp_dir);
+    return 0;
+}
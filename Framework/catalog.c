@@ -0,0 +1,393 @@
+/**
+ * @file catalog.c
+ * @brief Space Mission Control System - Lazy Mission Catalog
+ *
+ * load_missions_from_file_lazy() scans a mission file once and keeps only
+ * each record's ID and byte offset. A mission is created from its record
+ * the first time it is looked up by ID, without a log array until its
+ * first append, so startup time and memory follow the missions actually
+ * used rather than the size of the catalog.
+ *
+ * Entries stay in file order, which is the order reports list them in,
+ * and are found by ID through an open-addressing table of entry numbers
+ * laid out like mission_index.c. Catalogued files stay open so pending
+ * records can be read back.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mission_internal.h"
+
+#include <limits.h>
+
+#define SLOT_EMPTY (-1)
+#define SLOT_MIN_CAPACITY 16
+
+typedef enum {
+    ENTRY_PENDING = 0,          // Only in the catalog
+    ENTRY_LOADED = 1,           // Created in system->missions
+    ENTRY_REMOVED = 2           // Removed with remove_mission()
+} EntryState;
+
+typedef struct {
+    off_t offset;               // Start of the record in its file
+    int mission_id;
+    int state;                  // EntryState
+} CatalogEntry;
+
+typedef struct {
+    FILE *fp;
+    int first_entry;            // Its records are entries [first_entry, next file's first_entry)
+} CatalogFile;
+
+struct MissionCatalog {
+    CatalogEntry *entries;      // File order, files in load order
+    int entry_count;
+    int entry_capacity;
+    int *slots;                 // Entry numbers keyed by mission_id (latest entry per ID)
+    int slot_capacity;
+    CatalogFile *files;
+    int file_count;
+    int file_capacity;
+    int pending;                // Entries still ENTRY_PENDING
+};
+
+/* ========================================
+ * ENTRY TABLE
+ * ======================================== */
+static unsigned int entry_slot(int mission_id, int capacity) {
+    // Fibonacci hashing, as in mission_index.c
+    return ((unsigned int)mission_id * 2654435769u) & (unsigned int)(capacity - 1);
+}
+
+// Point the slot of the entry's ID at it, replacing an older entry for that ID
+static void place_entry(MissionCatalog* catalog, int entry) {
+    unsigned int mask = (unsigned int)(catalog->slot_capacity - 1);
+    int mission_id = catalog->entries[entry].mission_id;
+    unsigned int slot = entry_slot(mission_id, catalog->slot_capacity);
+    while (catalog->slots[slot] != SLOT_EMPTY &&
+           catalog->entries[catalog->slots[slot]].mission_id != mission_id) {
+        slot = (slot + 1) & mask;
+    }
+    catalog->slots[slot] = entry;
+}
+
+static int find_entry(const MissionCatalog* catalog, int mission_id) {
+    if (catalog->slots == NULL) {
+        return -1;
+    }
+    unsigned int mask = (unsigned int)(catalog->slot_capacity - 1);
+    unsigned int slot = entry_slot(mission_id, catalog->slot_capacity);
+    int entry;
+    while ((entry = catalog->slots[slot]) != SLOT_EMPTY) {
+        if (catalog->entries[entry].mission_id == mission_id) {
+            return entry;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return -1;
+}
+
+// Room for `entry_count` entries, with the table at most half full
+static int reserve_entries(MissionCatalog* catalog, int entry_count) {
+    if (entry_count > catalog->entry_capacity) {
+        CatalogEntry *entries = realloc(catalog->entries, (size_t)entry_count * sizeof(CatalogEntry));
+        if (entries == NULL) {
+            return -1;
+        }
+        catalog->entries = entries;
+        catalog->entry_capacity = entry_count;
+    }
+
+    int capacity = SLOT_MIN_CAPACITY;
+    while (capacity < entry_count * 2) {
+        capacity *= 2;
+    }
+    if (capacity <= catalog->slot_capacity) {
+        return 0;
+    }
+    int *slots = malloc((size_t)capacity * sizeof(int));
+    if (slots == NULL) {
+        return -1;
+    }
+    for (int i = 0; i < capacity; i++) {
+        slots[i] = SLOT_EMPTY;
+    }
+    free(catalog->slots);
+    catalog->slots = slots;
+    catalog->slot_capacity = capacity;
+    for (int entry = 0; entry < catalog->entry_count; entry++) {
+        place_entry(catalog, entry);
+    }
+    return 0;
+}
+
+static int add_file(MissionCatalog* catalog, FILE* fp) {
+    if (catalog->file_count >= catalog->file_capacity) {
+        int new_capacity = catalog->file_capacity > 0 ? catalog->file_capacity * 2 : 4;
+        CatalogFile *files = realloc(catalog->files, (size_t)new_capacity * sizeof(CatalogFile));
+        if (files == NULL) {
+            return -1;
+        }
+        catalog->files = files;
+        catalog->file_capacity = new_capacity;
+    }
+    catalog->files[catalog->file_count].fp = fp;
+    catalog->files[catalog->file_count].first_entry = catalog->entry_count;
+    catalog->file_count++;
+    return 0;
+}
+
+static const CatalogFile* file_of(const MissionCatalog* catalog, int entry) {
+    int lo = 0;
+    int hi = catalog->file_count - 1;
+    while (lo < hi) {
+        int mid = lo + (hi - lo + 1) / 2;
+        if (catalog->files[mid].first_entry <= entry) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return &catalog->files[lo];
+}
+
+/* ========================================
+ * MATERIALIZATION
+ * ======================================== */
+static int materialize(MissionControl* system, int entry_number) {
+    MissionCatalog *catalog = MISSION_SYSTEM(system)->catalog;
+    CatalogEntry *entry = &catalog->entries[entry_number];
+    FILE *fp = file_of(catalog, entry_number)->fp;
+
+    // The record was validated when it was catalogued; a mismatch means
+    // the file changed underneath us
+    MissionRecord record;
+    if (fseeko(fp, entry->offset, SEEK_SET) != 0 || !read_mission_record(fp, &record) ||
+        record.mission_id != entry->mission_id ||
+        !parse_date_to_epoch_day(record.launch_date, NULL)) {
+        return -1;
+    }
+    int position = append_lazy_mission(system, record.mission_id, record.mission_name,
+                                       record.launch_date);
+    if (position >= 0) {
+        entry->state = ENTRY_LOADED;
+        catalog->pending--;
+    }
+    return position;
+}
+
+int mission_index_find_or_load(MissionControl* system, int mission_id) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    int position = mission_index_find(system, mission_id);
+    if (position >= 0 || sys->catalog == NULL) {
+        return position;
+    }
+    int entry = find_entry(sys->catalog, mission_id);
+    if (entry < 0 || sys->catalog->entries[entry].state != ENTRY_PENDING) {
+        return -1;
+    }
+    return materialize(system, entry);
+}
+
+/* ========================================
+ * MAINTENANCE HOOKS
+ * ======================================== */
+int catalog_is_pending(const MissionControl* system, int mission_id) {
+    const MissionSystem *sys = MISSION_SYSTEM(system);
+    int entry = find_entry(sys->catalog, mission_id);
+    return entry >= 0 && sys->catalog->entries[entry].state == ENTRY_PENDING;
+}
+
+int catalog_lists_mission(const MissionControl* system, int mission_id) {
+    const MissionSystem *sys = MISSION_SYSTEM(system);
+    int entry = find_entry(sys->catalog, mission_id);
+    return entry >= 0 && sys->catalog->entries[entry].state == ENTRY_LOADED;
+}
+
+int catalog_remove(MissionControl* system, int mission_id) {
+    MissionCatalog *catalog = MISSION_SYSTEM(system)->catalog;
+    int entry = find_entry(catalog, mission_id);
+    if (entry < 0 || catalog->entries[entry].state == ENTRY_REMOVED) {
+        return -1;
+    }
+    int was_pending = catalog->entries[entry].state == ENTRY_PENDING;
+    catalog->entries[entry].state = ENTRY_REMOVED;
+    if (was_pending) {
+        catalog->pending--;
+        return 0;
+    }
+    return -1;
+}
+
+/*
+ * Pending records are read back in file order. Consecutive entries are
+ * consecutive records, so the file is only repositioned after a gap of
+ * created or removed missions.
+ */
+int catalog_write_report(const MissionControl* system, FILE* fp, int* index, int* total_comms) {
+    const MissionCatalog *catalog = MISSION_SYSTEM(system)->catalog;
+    char block[REPORT_BLOCK_MAX];
+
+    for (int f = 0; f < catalog->file_count; f++) {
+        FILE *in = catalog->files[f].fp;
+        int end = f + 1 < catalog->file_count ? catalog->files[f + 1].first_entry
+                                              : catalog->entry_count;
+        int positioned = 0;
+        for (int e = catalog->files[f].first_entry; e < end; e++) {
+            const CatalogEntry *entry = &catalog->entries[e];
+            if (entry->state == ENTRY_PENDING) {
+                MissionRecord record;
+                if ((!positioned && fseeko(in, entry->offset, SEEK_SET) != 0) ||
+                    !read_mission_record(in, &record) || record.mission_id != entry->mission_id) {
+                    return -1;
+                }
+                positioned = 1;
+                MissionView view = { record.mission_id, record.mission_name, record.launch_date,
+                                     PLANNED, NULL, 0 };
+                fwrite(block, 1, report_format_mission(block, sizeof(block), (*index)++, &view),
+                       fp);
+                continue;
+            }
+            positioned = 0;
+            int position = entry->state == ENTRY_LOADED
+                               ? mission_index_find(system, entry->mission_id) : -1;
+            if (position < 0) {
+                continue;
+            }
+            const Mission *m = &system->missions[position];
+            const MissionCold *cold = MISSION_COLD(system, position);
+            MissionView view = { m->mission_id, cold->mission_name, cold->launch_date, m->status,
+                                 m->communications, m->comm_count };
+            *total_comms += m->comm_count;
+            fwrite(block, 1, report_format_mission(block, sizeof(block), (*index)++, &view), fp);
+        }
+    }
+    return 0;
+}
+
+void catalog_memory(const MissionControl* system, MemoryFigure* figure) {
+    const MissionCatalog *catalog = MISSION_SYSTEM(system)->catalog;
+    if (catalog == NULL) {
+        return;
+    }
+    figure->used += sizeof(MissionCatalog) +
+                    (size_t)catalog->entry_count * (sizeof(CatalogEntry) + sizeof(int)) +
+                    (size_t)catalog->file_count * sizeof(CatalogFile);
+    figure->reserved += sizeof(MissionCatalog) +
+                        (size_t)catalog->entry_capacity * sizeof(CatalogEntry) +
+                        (size_t)catalog->slot_capacity * sizeof(int) +
+                        (size_t)catalog->file_capacity * sizeof(CatalogFile);
+}
+
+void catalog_free(MissionControl* system) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    MissionCatalog *catalog = sys->catalog;
+    if (catalog == NULL) {
+        return;
+    }
+    for (int f = 0; f < catalog->file_count; f++) {
+        fclose(catalog->files[f].fp);
+    }
+    free(catalog->files);
+    free(catalog->slots);
+    free(catalog->entries);
+    free(catalog);
+    sys->catalog = NULL;
+}
+
+/* ========================================
+ * PUBLIC API
+ * ======================================== */
+// Catalogue up to `count` records from the current position of `fp`.
+// Offsets are summed from the record lengths: ftello() per record would
+// cost a system call each.
+static int catalog_records(MissionControl* system, FILE* fp, int count) {
+    MissionCatalog *catalog = MISSION_SYSTEM(system)->catalog;
+    off_t offset = ftello(fp);
+    if (offset < 0) {
+        return 0;
+    }
+    int catalogued = 0;
+    while (catalogued < count) {
+        MissionRecord record;
+        int launch_day;
+        // Same acceptance as create_missions_bulk(), pending IDs included
+        if (!read_mission_record(fp, &record) || !is_valid_mission_record(&record) ||
+            !parse_date_to_epoch_day(record.launch_date, &launch_day) ||
+            mission_index_find(system, record.mission_id) >= 0 ||
+            catalog_is_pending(system, record.mission_id)) {
+            break;
+        }
+        CatalogEntry *entry = &catalog->entries[catalog->entry_count];
+        entry->offset = offset;
+        offset += record.length;
+        entry->mission_id = record.mission_id;
+        entry->state = ENTRY_PENDING;
+        place_entry(catalog, catalog->entry_count++);
+        catalog->pending++;
+        catalogued++;
+    }
+    return catalogued;
+}
+
+int load_missions_from_file_lazy(MissionControl* system, const char* filename) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    if (system == NULL || filename == NULL || filename[0] == '\0') {
+        return -1;
+    }
+    FILE *fp = fopen(filename, "r");
+    if (fp == NULL) {
+        return -1;
+    }
+
+    int num_missions = 0;
+    if (fscanf(fp, "%d", &num_missions) != 1 || num_missions < 0) {
+        fclose(fp);
+        return -1;
+    }
+    if (num_missions == 0) {
+        fclose(fp);
+        return 0;
+    }
+    // Pending records are read back by offset, which a pipe or FIFO cannot
+    // do, so a stream is loaded eagerly. A regular file's size bounds how
+    // many records can follow whatever the declared count.
+    struct stat st;
+    if (fstat(fileno(fp), &st) != 0 || !S_ISREG(st.st_mode)) {
+        int result = load_mission_records(system, fp, num_missions);
+        fclose(fp);
+        return result;
+    }
+    if (st.st_size / MIN_RECORD_BYTES + 1 < num_missions) {
+        num_missions = (int)(st.st_size / MIN_RECORD_BYTES + 1);
+    }
+
+    if (sys->catalog == NULL) {
+        sys->catalog = calloc(1, sizeof(MissionCatalog));
+        if (sys->catalog == NULL) {
+            fclose(fp);
+            return -1;
+        }
+    }
+    MissionCatalog *catalog = sys->catalog;
+    if (num_missions > INT_MAX / 4 - catalog->entry_count ||
+        reserve_entries(catalog, catalog->entry_count + num_missions) != 0 ||
+        add_file(catalog, fp) != 0) {
+        fclose(fp);
+        return -1;
+    }
+
+    int catalogued = catalog_records(system, fp, num_missions);
+    if (catalogued == 0) {
+        // Nothing to read back later
+        catalog->file_count--;
+        fclose(fp);
+    }
+    return catalogued < num_missions ? -1 : 0;
+}
+
+int pending_mission_count(const MissionControl* system) {
+    const MissionSystem *sys = MISSION_SYSTEM(system);
+    return system != NULL && sys->catalog != NULL ? sys->catalog->pending : 0;
+}
@@ -0,0 +1,488 @@
+/**
+ * @file comm_store.c
+ * @brief Space Mission Control System - Communication Log Storage
+ *
+ * The library side of FUNCTION 3 (the reference add_communication()
+ * delegates to append_communication()) and everything else that reads or
+ * rewrites a mission's log array: growth, lookup by log_id,
+ * acknowledgement, time-range queries, purging and compaction.
+ */
+
+#include "mission_internal.h"
+#include "metrics.h"
+
+#define COMPACT_STEP_LOGS 4096       // Logs copied by the compaction step of each purge
+
+void release_comm_buffer(MissionControl* system, CommLog* base, int pooled) {
+    if (base == NULL || pooled) {
+        return;
+    }
+    if (MISSION_SYSTEM(system)->snapshots != NULL) {
+        retire_shared_array(system, base);
+    } else {
+        free(base);
+    }
+}
+
+/*
+ * Resize a mission's communications array. A buffer carved out of a bulk
+ * creation pool cannot be realloc()ed, so it is copied into a private
+ * allocation instead; its pool slot stays owned by the system. So is a
+ * buffer whose front was purged (the allocation starts comm_offset logs
+ * earlier). While snapshots are enabled private buffers are copied too,
+ * and the old one is retired after the new one is published.
+ */
+int grow_mission_comms(MissionControl* system, Mission* mission, int capacity) {
+    MissionCold *cold = MISSION_COLD_OF(system, mission);
+    MissionMeta *meta = MISSION_META(system, MISSION_POSITION(system, mission));
+    CommLog *old_comm_logs = mission->communications;
+    CommLog *old_base = old_comm_logs - meta->comm_offset;
+    int copy = meta->comm_pooled || meta->comm_offset > 0 ||
+               MISSION_SYSTEM(system)->snapshots != NULL;
+    CommLog *new_comm_logs;
+    if (copy) {
+        new_comm_logs = malloc(capacity * sizeof(CommLog));
+        if (new_comm_logs != NULL && mission->comm_count > 0) {
+            memcpy(new_comm_logs, old_comm_logs, mission->comm_count * sizeof(CommLog));
+        }
+    } else {
+        new_comm_logs = realloc(old_comm_logs, capacity * sizeof(CommLog));
+    }
+    if (new_comm_logs == NULL) {
+        return -1;
+    }
+    METRICS_GROWTH(system, METRIC_GROWTH_COMMS, mission->communications, new_comm_logs,
+                   mission->comm_count * sizeof(CommLog));
+
+    cold->comm_capacity = capacity;
+    __atomic_store_n(&mission->communications, new_comm_logs, __ATOMIC_SEQ_CST);
+    if (copy) {
+        release_comm_buffer(system, old_base, meta->comm_pooled);
+    }
+    meta->comm_pooled = 0;
+    meta->comm_offset = 0;
+    return 0;
+}
+
+void count_mission_logs(const CommLog* logs, int count, MissionLogCounts* out) {
+    memset(out, 0, sizeof(MissionLogCounts));
+    for (int i = 0; i < count; i++) {
+        if (logs[i].priority >= ROUTINE && logs[i].priority <= EMERGENCY) {
+            out->priority_counts[logs[i].priority]++;
+        }
+        if (!logs[i].acknowledged) {
+            out->unacked_count++;
+        }
+    }
+}
+
+// First index whose log_id is above `log_id`; IDs increase along the array
+static int logs_up_to(const Mission* mission, int log_id) {
+    int lo = 0;
+    int hi = mission->comm_count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (mission->communications[mid].log_id <= log_id) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+CommLog* find_mission_log(const Mission* mission, int log_id) {
+    int index = logs_up_to(mission, log_id) - 1;
+    if (index >= 0 && mission->communications[index].log_id == log_id) {
+        return &mission->communications[index];
+    }
+    return NULL;
+}
+
+// First index whose timestamp sorts after `timestamp` (at or after it if
+// !past_equal); the mission's logs must be in timestamp order
+static int logs_before_time(const Mission* mission, const char* timestamp, int past_equal) {
+    int lo = 0;
+    int hi = mission->comm_count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        int order = strcmp(mission->communications[mid].timestamp, timestamp);
+        if (order < 0 || (order == 0 && past_equal)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+void logs_in_time_range(const Mission* mission, const char* from_timestamp,
+                        const char* to_timestamp, int* begin, int* end) {
+    *begin = from_timestamp != NULL ? logs_before_time(mission, from_timestamp, 0) : 0;
+    *end = to_timestamp != NULL ? logs_before_time(mission, to_timestamp, 1) : mission->comm_count;
+    if (*end < *begin) {
+        *end = *begin;
+    }
+}
+
+int find_communications_by_time(const MissionControl* system, int mission_id,
+                                const char* from_timestamp, const char* to_timestamp,
+                                const CommLog** first) {
+    if (system == NULL || first == NULL ||
+        (from_timestamp != NULL && !is_valid_timestamp_format(from_timestamp)) ||
+        (to_timestamp != NULL && !is_valid_timestamp_format(to_timestamp))) {
+        return -1;
+    }
+    int position = mission_index_find(system, mission_id);
+    if (position < 0) {
+        // A pending lazily loaded mission has no logs yet
+        *first = NULL;
+        return MISSION_SYSTEM(system)->catalog != NULL &&
+               catalog_is_pending(system, mission_id) ? 0 : -1;
+    }
+    if (MISSION_META(system, position)->logs_unsorted) {
+        return -1;
+    }
+    const Mission *mission = &system->missions[position];
+    int begin;
+    int end;
+    logs_in_time_range(mission, from_timestamp, to_timestamp, &begin, &end);
+    *first = mission->communications != NULL ? &mission->communications[begin] : NULL;
+    return end - begin;
+}
+
+/*
+ * The library side of FUNCTION 3: validate, find (or lazily create) the
+ * mission, then filter duplicates and either buffer the log for reordering
+ * or commit it.
+ */
+static CommAddStatus submit_communication(MissionControl* system, int mission_id,
+                                          const char* timestamp, MessagePriority priority,
+                                          const char* message) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    if (system == NULL || timestamp == NULL || message == NULL || mission_id <= 0 ||
+        message[0] == '\0' || strlen(message) >= MAX_MESSAGE_LENGTH ||
+        !is_valid_timestamp_format(timestamp) || priority < ROUTINE || priority > EMERGENCY) {
+        return COMM_ADD_REJECTED;
+    }
+
+    // A lazily loaded mission is created by its first log
+    int position = mission_index_find_or_load(system, mission_id);
+    if (position < 0) {
+        return COMM_ADD_REJECTED;
+    }
+
+    uint64_t fingerprint = 0;
+    if (sys->dedup != NULL &&
+        dedup_check(system, position, timestamp, priority, message, &fingerprint)) {
+        return COMM_ADD_DUPLICATE;  // Counted in comm_duplicates_suppressed()
+    }
+    if (sys->reorder != NULL) {
+        return reorder_add(system, position, timestamp, priority, message, fingerprint);
+    }
+    return commit_communication(system, position, timestamp, priority, message, fingerprint) == 0
+               ? COMM_ADD_OK : COMM_ADD_REJECTED;
+}
+
+int append_communication(MissionControl* system, int mission_id, const char* timestamp,
+                         MessagePriority priority, const char* message) {
+    return submit_communication(system, mission_id, timestamp, priority, message) == COMM_ADD_OK
+               ? 0 : -1;
+}
+
+CommAddStatus add_communication_ex(MissionControl* system, int mission_id, const char* timestamp,
+                                   MessagePriority priority, const char* message) {
+    METRICS_RETURN(system, METRIC_API_ADD_COMM,
+                   submit_communication(system, mission_id, timestamp, priority, message));
+}
+
+/*
+ * Store an already validated log at the end of the mission's array and
+ * run the maintenance hooks. Reordered logs arrive here from reorder.c.
+ */
+int commit_communication(MissionControl* system, int position, const char* timestamp,
+                         MessagePriority priority, const char* message, uint64_t fingerprint) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    Mission *target_mission = &system->missions[position];
+    MissionCold *target_cold = MISSION_COLD(system, position);
+    MissionMeta *target_meta = MISSION_META(system, position);
+
+    if (target_mission->comm_count >= target_cold->comm_capacity &&
+        grow_mission_comms(system, target_mission,
+                           target_mission->comm_count > 0
+                               ? grown_capacity(system, target_mission->comm_count,
+                                                target_mission->comm_count + 1)
+                               : INITIAL_COMM_CAPACITY) != 0) {
+        return -1;
+    }
+
+    // One system-wide sequence, never reused, so IDs stay unique across
+    // missions and after purges
+    int log_id = log_directory_add(system, target_mission->mission_id,
+                                   target_meta->comm_appended);
+    if (log_id < 0) {
+        return -1;
+    }
+    target_meta->comm_appended++;
+
+    int index = target_mission->comm_count;
+    CommLog *new_comm = &target_mission->communications[index];
+    if (index > 0 && strcmp(timestamp, new_comm[-1].timestamp) < 0) {
+        target_meta->logs_unsorted = 1;
+    }
+    new_comm->log_id = log_id;
+
+    strncpy(new_comm->timestamp, timestamp, sizeof(new_comm->timestamp) - 1);
+    new_comm->timestamp[sizeof(new_comm->timestamp) - 1] = '\0';
+    strncpy(new_comm->message, message, sizeof(new_comm->message) - 1);
+    new_comm->message[sizeof(new_comm->message) - 1] = '\0';
+
+    new_comm->priority = priority;
+    new_comm->acknowledged = 0;
+
+    // Publish the entry before snapshots may see it (see snapshot.c)
+    __atomic_store_n(&target_mission->comm_count, index + 1, __ATOMIC_RELEASE);
+    if (sys->snapshots != NULL) {
+        snapshot_publish_log(system);
+    }
+    MissionLogCounts delta = { { 0 }, 1 };
+    delta.priority_counts[priority] = 1;
+    if (sys->leaderboard != NULL) {
+        leaderboard_update(system, position, &delta);
+    }
+    if (sys->rollups != NULL) {
+        rollups_record(system, position, new_comm);
+    }
+    if (sys->dedup != NULL) {
+        dedup_record(system, position, fingerprint, new_comm->log_id);
+    }
+    if (sys->shared_view != NULL) {
+        shared_view_update(system, position, &delta);
+    }
+    if (sys->subscriptions != NULL) {
+        notify_subscribers(system, target_mission->mission_id, new_comm);
+    }
+
+    return 0;
+}
+
+int reserve_communications(MissionControl* system, int mission_id, int capacity) {
+    if (system == NULL || capacity <= 0) {
+        return -1;
+    }
+    int position = mission_index_find_or_load(system, mission_id);
+    if (position < 0) {
+        return -1;
+    }
+    Mission *mission = &system->missions[position];
+    if (capacity <= MISSION_COLD(system, position)->comm_capacity) {
+        return 0;
+    }
+    return grow_mission_comms(system, mission, capacity);
+}
+
+// Mark a stored log acknowledged and update the per-mission counters
+static void acknowledge_log(MissionControl* system, int position, CommLog* comm) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    if (!comm->acknowledged) {
+        __atomic_store_n(&comm->acknowledged, 1, __ATOMIC_RELAXED);
+        MissionLogCounts delta = { { 0 }, -1 };
+        if (sys->leaderboard != NULL) {
+            leaderboard_update(system, position, &delta);
+        }
+        if (sys->shared_view != NULL) {
+            shared_view_update(system, position, &delta);
+        }
+    }
+}
+
+int acknowledge_communication(MissionControl* system, int mission_id, int log_id) {
+    if (system == NULL || log_id <= 0) {
+        return -1;
+    }
+    int position;
+    CommLog *comm = log_directory_find(system, log_id, &position);
+    if (comm == NULL || system->missions[position].mission_id != mission_id) {
+        return -1;
+    }
+    acknowledge_log(system, position, comm);
+    return 0;
+}
+
+int acknowledge_communication_by_id(MissionControl* system, int log_id) {
+    if (system == NULL) {
+        return -1;
+    }
+    int position;
+    CommLog *comm = log_directory_find(system, log_id, &position);
+    if (comm == NULL) {
+        return -1;
+    }
+    acknowledge_log(system, position, comm);
+    return 0;
+}
+
+const CommLog* get_communication(const MissionControl* system, int log_id, int* mission_id) {
+    if (system == NULL) {
+        return NULL;
+    }
+    int position;
+    const CommLog *comm = log_directory_find(system, log_id, &position);
+    if (comm != NULL && mission_id != NULL) {
+        *mission_id = system->missions[position].mission_id;
+    }
+    return comm;
+}
+
+/* ========================================
+ * PURGING AND COMPACTION
+ * ======================================== */
+// Is at least half of the allocation of the mission at `position` unused?
+static int wastes_comm_space(const MissionControl* system, int position) {
+    const MissionMeta *meta = MISSION_META(system, position);
+    int allocated = meta->comm_offset + MISSION_COLD(system, position)->comm_capacity;
+    return !meta->comm_pooled && allocated > INITIAL_COMM_CAPACITY &&
+           system->missions[position].comm_count * 2 < allocated;
+}
+
+static void queue_compaction(MissionControl* system, int position) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    MissionMeta *meta = MISSION_META(system, position);
+    if (meta->compact_queued || !wastes_comm_space(system, position)) {
+        return;
+    }
+    if (sys->compact_count >= sys->compact_capacity) {
+        int new_capacity = sys->compact_capacity > 0 ? sys->compact_capacity * 2 : 16;
+        int *grown = realloc(sys->compact_queue, new_capacity * sizeof(int));
+        if (grown == NULL) {
+            return;    // The memory is reclaimed on the next growth instead
+        }
+        sys->compact_queue = grown;
+        sys->compact_capacity = new_capacity;
+    }
+    sys->compact_queue[sys->compact_count++] = system->missions[position].mission_id;
+    meta->compact_queued = 1;
+}
+
+/*
+ * Removing the oldest logs only advances the start of the array, so it
+ * costs O(removed) for the counters and nothing to copy. A range with
+ * logs before it shifts the later logs down, in a copy while snapshots
+ * are enabled. Either way the counts and the array change together under
+ * the layout seqlock (see snapshot.c). `delta` receives the change to the
+ * mission's log counts.
+ */
+static long purge_range(MissionControl* system, int position, int from_log_id, int to_log_id,
+                        MissionLogCounts* delta) {
+    Mission *mission = &system->missions[position];
+    MissionCold *cold = MISSION_COLD(system, position);
+    MissionMeta *meta = MISSION_META(system, position);
+    int first = logs_up_to(mission, from_log_id - 1);
+    int end = logs_up_to(mission, to_log_id);
+    int removed = end - first;
+    if (removed <= 0) {
+        return 0;
+    }
+
+    CommLog *logs = mission->communications;
+    CommLog *copy = NULL;
+    if (first > 0 && MISSION_SYSTEM(system)->snapshots != NULL) {
+        copy = malloc(cold->comm_capacity * sizeof(CommLog));
+        if (copy == NULL) {
+            return -1;
+        }
+        memcpy(copy, logs, first * sizeof(CommLog));
+        memcpy(&copy[first], &logs[end], (mission->comm_count - end) * sizeof(CommLog));
+    }
+
+    memset(delta, 0, sizeof(MissionLogCounts));
+    for (int i = first; i < end; i++) {
+        delta->priority_counts[logs[i].priority]--;
+        if (!logs[i].acknowledged) {
+            delta->unacked_count--;
+        }
+    }
+    log_directory_drop(system, &logs[first], removed);
+
+    layout_change_begin(system);
+    if (first == 0) {
+        __atomic_store_n(&mission->communications, logs + removed, __ATOMIC_SEQ_CST);
+        meta->comm_offset += removed;
+        cold->comm_capacity -= removed;
+    } else if (copy != NULL) {
+        __atomic_store_n(&mission->communications, copy, __ATOMIC_SEQ_CST);
+    } else {
+        memmove(&logs[first], &logs[end], (mission->comm_count - end) * sizeof(CommLog));
+    }
+    __atomic_store_n(&mission->comm_count, mission->comm_count - removed, __ATOMIC_RELEASE);
+    layout_change_end(system);
+
+    if (copy != NULL) {
+        release_comm_buffer(system, logs - meta->comm_offset, meta->comm_pooled);
+        meta->comm_offset = 0;
+        meta->comm_pooled = 0;
+    }
+    return removed;
+}
+
+long purge_communications(MissionControl* system, int mission_id, int from_log_id, int to_log_id) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    if (system == NULL || from_log_id <= 0 || to_log_id < from_log_id) {
+        return -1;
+    }
+    int position = mission_index_find(system, mission_id);
+    if (position < 0) {
+        // A pending lazily loaded mission has no logs yet
+        return sys->catalog != NULL && catalog_is_pending(system, mission_id) ? 0 : -1;
+    }
+
+    if (sys->report_service != NULL) {
+        report_service_capture_queued(system);
+    }
+    MissionLogCounts delta;
+    long removed = purge_range(system, position, from_log_id, to_log_id, &delta);
+    if (removed <= 0) {
+        return removed;
+    }
+    if (sys->leaderboard != NULL) {
+        leaderboard_update(system, position, &delta);
+    }
+    if (sys->shared_view != NULL) {
+        shared_view_update(system, position, &delta);
+    }
+    queue_compaction(system, position);
+    compact_communications(system, COMPACT_STEP_LOGS);
+    return removed;
+}
+
+int compact_communications(MissionControl* system, int max_logs) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    if (system == NULL || max_logs < 0) {
+        return -1;
+    }
+    // Best effort: the holes are reclaimed on a later pass or growth instead
+    log_directory_compact(system);
+    long copied = 0;
+    while (sys->compact_count > 0 && copied < max_logs) {
+        int mission_id = sys->compact_queue[--sys->compact_count];
+        int position = mission_index_find(system, mission_id);
+        if (position < 0) {
+            continue;  // Removed since it was queued
+        }
+        Mission *mission = &system->missions[position];
+        MISSION_META(system, position)->compact_queued = 0;
+        if (!wastes_comm_space(system, position)) {
+            continue;
+        }
+        int capacity = mission->comm_count + mission->comm_count / 2;
+        if (capacity < INITIAL_COMM_CAPACITY) {
+            capacity = INITIAL_COMM_CAPACITY;
+        }
+        if (grow_mission_comms(system, mission, capacity) != 0) {
+            queue_compaction(system, position);
+            break;
+        }
+        copied += mission->comm_count;
+    }
+    return sys->compact_count;
+}
@@ -0,0 +1,285 @@
+/**
+ * @file dedup.c
+ * @brief Space Mission Control System - Duplicate Communication Suppression
+ *
+ * While dedup is enabled each mission remembers its last `window` logs by
+ * fingerprint, a 64-bit hash of (timestamp, priority, message), in a
+ * linear-probing table of four times the window. Entries carry their
+ * insert number, so one that has fallen out of the window is recognised
+ * as stale without any eviction work: appends reuse stale slots along
+ * their probe run, and every `window` inserts a sweep drops the rest.
+ * The table is therefore at most half occupied, and an append touches
+ * the set header and usually one cache line of the table.
+ *
+ * A fingerprint hit is confirmed against the stored log before the append
+ * is refused and counted, so a hash collision never drops a real log. If
+ * that log has been purged since, the fingerprint alone decides.
+ *
+ * A mission's set is allocated with its first log; the key includes the
+ * mission implicitly because every mission has its own set.
+ */
+
+#include "mission_internal.h"
+
+#define DEDUP_DEFAULT_WINDOW 32
+#define DEDUP_MAX_WINDOW (1 << 20)
+
+typedef struct {
+    uint64_t fingerprint;
+    int log_id;             // 0 for an empty slot
+    unsigned int seq;       // Set insert number
+} DedupEntry;
+
+// Followed in the same allocation by DedupEntry table[table_mask + 1]
+struct CommDedupSet {
+    unsigned int inserted;  // Insert number of the newest entry
+    unsigned int swept;     // `inserted` at the last sweep
+};
+
+struct CommDedup {
+    unsigned int window;    // Logs remembered per mission
+    int table_mask;         // Table size - 1 (a power of two >= 4 * window)
+    long duplicates;        // Appends refused so far
+    MissionSideTable sets;  // CommDedupSet* by mission position
+};
+
+/* ========================================
+ * FINGERPRINTS
+ * ======================================== */
+static uint64_t mix(uint64_t hash, uint64_t value) {
+    hash = (hash ^ value) * 0x9E3779B97F4A7C15ull;
+    return hash ^ (hash >> 29);
+}
+
+// Eight bytes per step; the final partial word is zero-padded
+static uint64_t hash_string(uint64_t hash, const char* text, size_t length) {
+    uint64_t word;
+    for (; length >= sizeof(word); text += sizeof(word), length -= sizeof(word)) {
+        memcpy(&word, text, sizeof(word));
+        hash = mix(hash, word);
+    }
+    word = 0;
+    memcpy(&word, text, length);
+    return mix(hash, word ^ ((uint64_t)length << 56));
+}
+
+uint64_t comm_fingerprint(const char* timestamp, MessagePriority priority,
+                          const char* message) {
+    uint64_t hash = hash_string((uint64_t)priority, timestamp, strlen(timestamp));
+    return hash_string(hash, message, strlen(message));
+}
+
+/* ========================================
+ * PER-MISSION SET
+ * ======================================== */
+static DedupEntry* set_table(const CommDedupSet* set) {
+    return (DedupEntry*)(set + 1);
+}
+
+static size_t set_bytes(const CommDedup* dedup) {
+    return sizeof(CommDedupSet) + (size_t)(dedup->table_mask + 1) * sizeof(DedupEntry);
+}
+
+static CommDedupSet* create_set(const CommDedup* dedup) {
+    CommDedupSet *set = malloc(set_bytes(dedup));
+    if (set == NULL) {
+        return NULL;
+    }
+    set->inserted = 0;
+    set->swept = 0;
+    DedupEntry *table = set_table(set);
+    for (int i = 0; i <= dedup->table_mask; i++) {
+        table[i].log_id = 0;
+    }
+    return set;
+}
+
+// Unsigned arithmetic, so wrapping insert numbers still compare correctly
+static int is_live(const CommDedup* dedup, const CommDedupSet* set, const DedupEntry* entry) {
+    return entry->log_id != 0 && set->inserted - entry->seq < dedup->window;
+}
+
+static void place(const CommDedup* dedup, DedupEntry* table, const DedupEntry* entry) {
+    int i = (int)(entry->fingerprint & (uint64_t)dedup->table_mask);
+    while (table[i].log_id != 0) {
+        i = (i + 1) & dedup->table_mask;
+    }
+    table[i] = *entry;
+}
+
+/*
+ * Empty the stale slots, then re-place the live entries in table order
+ * starting after an empty slot. Each moves at most back towards its home,
+ * into a slot already visited, so every probe run ends up unbroken.
+ */
+static void sweep(const CommDedup* dedup, CommDedupSet* set) {
+    int mask = dedup->table_mask;
+    DedupEntry *table = set_table(set);
+    int start = 0;
+    for (int i = 0; i <= mask; i++) {
+        if (!is_live(dedup, set, &table[i])) {
+            table[i].log_id = 0;
+            start = i;
+        }
+    }
+    for (int k = 1; k <= mask + 1; k++) {
+        DedupEntry *slot = &table[(start + k) & mask];
+        if (slot->log_id != 0) {
+            DedupEntry entry = *slot;
+            slot->log_id = 0;
+            place(dedup, table, &entry);
+        }
+    }
+    set->swept = set->inserted;
+}
+
+static void set_insert(const CommDedup* dedup, CommDedupSet* set, uint64_t fingerprint,
+                       int log_id) {
+    if (set->inserted - set->swept >= dedup->window) {
+        sweep(dedup, set);
+    }
+    // Every entry older than the window is stale once the new one counts
+    set->inserted++;
+    int mask = dedup->table_mask;
+    DedupEntry *table = set_table(set);
+    int i = (int)(fingerprint & (uint64_t)mask);
+    while (is_live(dedup, set, &table[i])) {
+        i = (i + 1) & mask;
+    }
+    table[i].fingerprint = fingerprint;
+    table[i].log_id = log_id;
+    table[i].seq = set->inserted;
+}
+
+// Is the remembered log `log_id` (if still held) the same communication?
+static int confirms(const MissionControl* system, int log_id, const char* timestamp,
+                    MessagePriority priority, const char* message) {
+    const CommLog *log = log_directory_find(system, log_id, NULL);
+    return log == NULL || (log->priority == priority && strcmp(log->timestamp, timestamp) == 0 &&
+                           strcmp(log->message, message) == 0);
+}
+
+/* ========================================
+ * APPEND HOOKS
+ * ======================================== */
+int dedup_check(MissionControl* system, int position, const char* timestamp,
+                MessagePriority priority, const char* message, uint64_t* fingerprint) {
+    CommDedup *dedup = MISSION_SYSTEM(system)->dedup;
+    *fingerprint = comm_fingerprint(timestamp, priority, message);
+    const CommDedupSet *set = side_table_get(&dedup->sets, position);
+    if (set == NULL) {
+        return 0;
+    }
+    int mask = dedup->table_mask;
+    const DedupEntry *table = set_table(set);
+    for (int i = (int)(*fingerprint & (uint64_t)mask); table[i].log_id != 0; i = (i + 1) & mask) {
+        const DedupEntry *entry = &table[i];
+        if (entry->fingerprint == *fingerprint && is_live(dedup, set, entry) &&
+            confirms(system, entry->log_id, timestamp, priority, message)) {
+            dedup->duplicates++;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void dedup_record(MissionControl* system, int position, uint64_t fingerprint, int log_id) {
+    CommDedup *dedup = MISSION_SYSTEM(system)->dedup;
+    CommDedupSet *set = side_table_get(&dedup->sets, position);
+    if (set == NULL) {
+        // Without a set the mission is simply not protected
+        set = create_set(dedup);
+        if (set == NULL || side_table_set(&dedup->sets, system, position, set) != 0) {
+            free(set);
+            return;
+        }
+    }
+    set_insert(dedup, set, fingerprint, log_id);
+}
+
+void dedup_remove_mission(MissionControl* system, int position) {
+    free(side_table_take(&MISSION_SYSTEM(system)->dedup->sets, position,
+                         system->mission_count - 1));
+}
+
+void dedup_note_duplicate(MissionControl* system) {
+    MISSION_SYSTEM(system)->dedup->duplicates++;
+}
+
+void dedup_free(MissionControl* system) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    if (sys->dedup == NULL) {
+        return;
+    }
+    for (int i = 0; i < sys->dedup->sets.capacity; i++) {
+        free(sys->dedup->sets.entries[i]);
+    }
+    side_table_free(&sys->dedup->sets);
+    free(sys->dedup);
+    sys->dedup = NULL;
+}
+
+void dedup_memory(const MissionControl* system, MemoryFigure* figure) {
+    const CommDedup *dedup = MISSION_SYSTEM(system)->dedup;
+    if (dedup == NULL) {
+        return;
+    }
+    size_t bytes = sizeof(CommDedup);
+    for (int i = 0; i < system->mission_count; i++) {
+        if (side_table_get(&dedup->sets, i) != NULL) {
+            bytes += set_bytes(dedup);
+        }
+    }
+    figure->used += bytes;
+    figure->reserved += bytes;
+    side_table_memory(&dedup->sets, figure);
+}
+
+/* ========================================
+ * ENABLE / DISABLE
+ * ======================================== */
+int enable_comm_dedup(MissionControl* system, int window) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    if (system == NULL || window < 0 || window > DEDUP_MAX_WINDOW) {
+        return -1;
+    }
+    if (sys->dedup != NULL) {
+        return 0;
+    }
+    CommDedup *dedup = calloc(1, sizeof(CommDedup));
+    if (dedup == NULL) {
+        return -1;
+    }
+    dedup->window = (unsigned int)(window > 0 ? window : DEDUP_DEFAULT_WINDOW);
+    int table_size = 4;
+    while (table_size < 4 * (int)dedup->window) {
+        table_size *= 2;
+    }
+    dedup->table_mask = table_size - 1;
+    dedup->duplicates = 0;
+    sys->dedup = dedup;
+
+    // Remember the most recent logs already held
+    for (int i = 0; i < system->mission_count; i++) {
+        const Mission *mission = &system->missions[i];
+        int first = mission->comm_count > (int)dedup->window
+                        ? mission->comm_count - (int)dedup->window : 0;
+        for (int j = first; j < mission->comm_count; j++) {
+            const CommLog *log = &mission->communications[j];
+            dedup_record(system, i, comm_fingerprint(log->timestamp, log->priority, log->message),
+                         log->log_id);
+        }
+    }
+    return 0;
+}
+
+void disable_comm_dedup(MissionControl* system) {
+    if (system != NULL) {
+        dedup_free(system);
+    }
+}
+
+long comm_duplicates_suppressed(const MissionControl* system) {
+    const MissionSystem *sys = MISSION_SYSTEM(system);
+    return system != NULL && sys->dedup != NULL ? sys->dedup->duplicates : 0;
+}
@@ -0,0 +1,263 @@
+/**
+ * @file export.c
+ * @brief Space Mission Control System - Streaming Communication Export
+ *
+ * Walks missions and their logs once, formatting matching rows straight
+ * into a fixed-size buffer that is written out whenever it fills, so
+ * memory use is constant however many logs are exported. Rows are built
+ * by hand rather than with printf; messages are copied verbatim unless
+ * they contain a character that needs escaping.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mission_internal.h"
+
+#include <errno.h>
+#include <fcntl.h>
+
+#define EXPORT_BUFFER_BYTES (256 * 1024)
+#define EXPORT_ROW_MAX 2048     // Worst case: every message byte escaped as \u00XX
+
+typedef struct {
+    int fd;
+    char *data;
+    size_t length;
+    int failed;
+} ExportBuffer;
+
+/* ========================================
+ * OUTPUT BUFFER
+ * ======================================== */
+static void flush_export(ExportBuffer* out) {
+    const char *p = out->data;
+    size_t left = out->length;
+    while (left > 0 && !out->failed) {
+        ssize_t written = write(out->fd, p, left);
+        if (written < 0) {
+            if (errno != EINTR) {
+                out->failed = 1;
+            }
+            continue;
+        }
+        p += written;
+        left -= (size_t)written;
+    }
+    out->length = 0;
+}
+
+static char* reserve_row(ExportBuffer* out) {
+    if (EXPORT_BUFFER_BYTES - out->length < EXPORT_ROW_MAX) {
+        flush_export(out);
+    }
+    return out->data + out->length;
+}
+
+static char* put_text(char* p, const char* text) {
+    size_t length = strlen(text);
+    memcpy(p, text, length);
+    return p + length;
+}
+
+static char* put_int(char* p, int value) {
+    char digits[12];
+    int n = 0;
+    unsigned int magnitude = value < 0 ? 0u - (unsigned int)value : (unsigned int)value;
+    do {
+        digits[n++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (value < 0) {
+        *p++ = '-';
+    }
+    while (n > 0) {
+        *p++ = digits[--n];
+    }
+    return p;
+}
+
+/* ========================================
+ * FIELD ESCAPING
+ * ======================================== */
+// RFC 4180: quote the field only if it holds a comma, quote or line break
+static char* put_csv_field(char* p, const char* text) {
+    size_t length = strcspn(text, ",\"\r\n");
+    if (text[length] == '\0') {
+        memcpy(p, text, length);
+        return p + length;
+    }
+    *p++ = '"';
+    for (; *text != '\0'; text++) {
+        if (*text == '"') {
+            *p++ = '"';
+        }
+        *p++ = *text;
+    }
+    *p++ = '"';
+    return p;
+}
+
+static int needs_json_escape(unsigned char c) {
+    return c < 0x20 || c == '"' || c == '\\';
+}
+
+static char* put_json_string(char* p, const char* text) {
+    static const char hex[] = "0123456789abcdef";
+    *p++ = '"';
+    for (;;) {
+        // Fast path: copy the longest run that needs no escaping
+        const char *run = text;
+        while (*text != '\0' && !needs_json_escape((unsigned char)*text)) {
+            text++;
+        }
+        memcpy(p, run, (size_t)(text - run));
+        p += text - run;
+        if (*text == '\0') {
+            break;
+        }
+
+        unsigned char c = (unsigned char)*text++;
+        *p++ = '\\';
+        switch (c) {
+            case '"': *p++ = '"'; break;
+            case '\\': *p++ = '\\'; break;
+            case '\n': *p++ = 'n'; break;
+            case '\r': *p++ = 'r'; break;
+            case '\t': *p++ = 't'; break;
+            default:
+                p = put_text(p, "u00");
+                *p++ = hex[c >> 4];
+                *p++ = hex[c & 0x0f];
+                break;
+        }
+    }
+    *p++ = '"';
+    return p;
+}
+
+/* ========================================
+ * ROW FORMATTERS
+ * ======================================== */
+static void put_csv_row(ExportBuffer* out, int mission_id, const CommLog* log) {
+    char *p = reserve_row(out);
+    p = put_int(p, mission_id);
+    *p++ = ',';
+    p = put_int(p, log->log_id);
+    *p++ = ',';
+    p = put_text(p, log->timestamp);
+    *p++ = ',';
+    p = put_text(p, priority_to_string(log->priority));
+    *p++ = ',';
+    *p++ = log->acknowledged ? '1' : '0';
+    *p++ = ',';
+    p = put_csv_field(p, log->message);
+    *p++ = '\n';
+    out->length = (size_t)(p - out->data);
+}
+
+static void put_json_row(ExportBuffer* out, int mission_id, const CommLog* log) {
+    char *p = reserve_row(out);
+    p = put_text(p, "{\"mission_id\":");
+    p = put_int(p, mission_id);
+    p = put_text(p, ",\"log_id\":");
+    p = put_int(p, log->log_id);
+    p = put_text(p, ",\"timestamp\":\"");
+    p = put_text(p, log->timestamp);
+    p = put_text(p, "\",\"priority\":\"");
+    p = put_text(p, priority_to_string(log->priority));
+    p = put_text(p, log->acknowledged ? "\",\"acknowledged\":true,\"message\":"
+                                      : "\",\"acknowledged\":false,\"message\":");
+    p = put_json_string(p, log->message);
+    p = put_text(p, "}\n");
+    out->length = (size_t)(p - out->data);
+}
+
+/* ========================================
+ * EXPORT WALK
+ * ======================================== */
+static int log_matches(const CommLog* log, const ExportFilter* filter) {
+    if ((int)log->priority < filter->min_priority) {
+        return 0;
+    }
+    // Fixed-width "YYYY-MM-DD HH:MM" timestamps compare chronologically as strings
+    if (filter->from_timestamp != NULL && strcmp(log->timestamp, filter->from_timestamp) < 0) {
+        return 0;
+    }
+    if (filter->to_timestamp != NULL && strcmp(log->timestamp, filter->to_timestamp) > 0) {
+        return 0;
+    }
+    return 1;
+}
+
+static long export_mission(ExportBuffer* out, const Mission* mission, ExportFormat format,
+                           const ExportFilter* filter) {
+    long exported = 0;
+    for (int i = 0; i < mission->comm_count && !out->failed; i++) {
+        const CommLog *log = &mission->communications[i];
+        if (!log_matches(log, filter)) {
+            continue;
+        }
+        if (format == EXPORT_CSV) {
+            put_csv_row(out, mission->mission_id, log);
+        } else {
+            put_json_row(out, mission->mission_id, log);
+        }
+        exported++;
+    }
+    return exported;
+}
+
+long export_communications_fd(const MissionControl* system, int fd, ExportFormat format,
+                              const ExportFilter* filter) {
+    ExportFilter all = { 0, 0, NULL, NULL };
+    if (filter == NULL) {
+        filter = &all;
+    }
+    if (system == NULL || fd < 0 || (format != EXPORT_CSV && format != EXPORT_JSON_LINES) ||
+        filter->mission_id < 0 ||
+        (filter->from_timestamp != NULL && !is_valid_timestamp_format(filter->from_timestamp)) ||
+        (filter->to_timestamp != NULL && !is_valid_timestamp_format(filter->to_timestamp))) {
+        return -1;
+    }
+
+    ExportBuffer out = { fd, malloc(EXPORT_BUFFER_BYTES), 0, 0 };
+    if (out.data == NULL) {
+        return -1;
+    }
+    if (format == EXPORT_CSV) {
+        char *p = put_text(out.data, "mission_id,log_id,timestamp,priority,acknowledged,message\n");
+        out.length = (size_t)(p - out.data);
+    }
+
+    long exported = 0;
+    if (filter->mission_id > 0) {
+        int position = mission_index_find(system, filter->mission_id);
+        if (position >= 0) {
+            exported = export_mission(&out, &system->missions[position], format, filter);
+        }
+    } else {
+        for (int i = 0; i < system->mission_count && !out.failed; i++) {
+            exported += export_mission(&out, &system->missions[i], format, filter);
+        }
+    }
+    flush_export(&out);
+
+    free(out.data);
+    return out.failed ? -1 : exported;
+}
+
+long export_communications(const MissionControl* system, const char* filename,
+                           ExportFormat format, const ExportFilter* filter) {
+    if (system == NULL || filename == NULL || filename[0] == '\0') {
+        return -1;
+    }
+    int fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return -1;
+    }
+    long exported = export_communications_fd(system, fd, format, filter);
+    if (close(fd) != 0) {
+        exported = -1;
+    }
+    return exported;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file footprint.c
+ * @brief Space Mission Control System - Memory Footprint
+ *
+ * Reports how much memory a system uses against what it has reserved, per
+ * area, and hands slack back: per-mission log buffers, the mission arrays
+ * and the indexes that were sized for their peak.
+ */
+
+#include "mission_internal.h"
+
+/* ===== FOOTPRINT ===== */
+
+int mission_control_memory_usage(const MissionControl* system, MemoryUsage* out) {
+    const MissionSystem *sys = MISSION_SYSTEM(system);
+    if (system == NULL || out == NULL) {
+        return -1;
+    }
+    memset(out, 0, sizeof(MemoryUsage));
+
+    // In the hot/cold layout MissionCold is a side table, else Mission again
+    size_t per_mission = sizeof(Mission) + sizeof(MissionMeta);
+#ifdef MISSION_HOT_COLD
+    per_mission += sizeof(MissionCold);
+#endif
+    out->missions.used = (size_t)system->mission_count * per_mission;
+    out->missions.reserved = (size_t)system->capacity * per_mission;
+
+    // Pooled logs are covered by comm_pool_bytes, including abandoned slots
+    out->comm_logs.reserved = sys->comm_pool_bytes +
+                              (size_t)sys->comm_pool_capacity * sizeof(CommLog*);
+    for (int i = 0; i < system->mission_count; i++) {
+        const MissionMeta *meta = MISSION_META(system, i);
+        out->comm_logs.used += (size_t)system->missions[i].comm_count * sizeof(CommLog);
+        if (!meta->comm_pooled) {
+            out->comm_logs.reserved += (size_t)(meta->comm_offset +
+                                                MISSION_COLD(system, i)->comm_capacity) *
+                                       sizeof(CommLog);
+        }
+    }
+
+    mission_index_memory(system, &out->indexes);
+    log_directory_memory(system, &out->indexes);
+    leaderboard_memory(system, &out->indexes);
+    launch_index_memory(system, &out->indexes);
+    rollups_memory(system, &out->indexes);
+    dedup_memory(system, &out->indexes);
+    reorder_memory(system, &out->indexes);
+    catalog_memory(system, &out->indexes);
+    out->indexes.reserved += (size_t)sys->compact_capacity * sizeof(int);
+
+    out->total.used = sizeof(MissionSystem) + out->missions.used + out->comm_logs.used +
+                      out->indexes.used;
+    out->total.reserved = sizeof(MissionSystem) + out->missions.reserved +
+                          out->comm_logs.reserved + out->indexes.reserved;
+    return 0;
+}
+
+/* ===== SHRINK TO FIT ===== */
+
+int mission_control_shrink_to_fit(MissionControl* system) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    if (system == NULL) {
+        return -1;
+    }
+    int result = 0;
+    for (int i = 0; i < system->mission_count; i++) {
+        Mission *mission = &system->missions[i];
+        MissionMeta *meta = MISSION_META(system, i);
+        int fit = mission->comm_count > 0 ? mission->comm_count : 1;
+        int allocated = meta->comm_offset + MISSION_COLD(system, i)->comm_capacity;
+        meta->compact_queued = 0;
+        if (!meta->comm_pooled && allocated > fit &&
+            grow_mission_comms(system, mission, fit) != 0) {
+            result = -1;
+        }
+    }
+    // Every purged allocation was just compacted
+    free(sys->compact_queue);
+    sys->compact_queue = NULL;
+    sys->compact_count = 0;
+    sys->compact_capacity = 0;
+
+    int fit = system->mission_count > 0 ? system->mission_count : 1;
+    if (system->capacity > fit && resize_missions(system, fit) != 0) {
+        result = -1;
+    }
+    if (mission_index_shrink(system) != 0 || log_directory_shrink(system) != 0 ||
+        leaderboard_shrink(system) != 0 || launch_index_shrink(system) != 0) {
+        result = -1;
+    }
+    return result;
+}
@@ -0,0 +1,1484 @@
+/**
+ * @file grader.c
+ * @brief Space Mission Control System - Parallel Batch Grader
+ *
+ * Native replacement for batchgrader_space_mission_system.sh and the
+ * autograder it runs per submission. Submissions are graded concurrently,
+ * each in its own temporary directory, so nothing is copied into (or
+ * removed from) the framework directory while other jobs run.
+ *
+ * The framework sources (everything in the Makefile's SOURCES except the
+ * four student files) are compiled once into GRADER_CACHE_DIR and only
+ * recompiled when a source, a header or the compiler flags change; each
+ * submission then compiles just its own four files and links against the
+ * cached objects. Outputs are compared in-process against
+ * EXPECTED_OUTPUT.txt, which is read once. Scoring, grade files,
+ * GRADING_SUMMARY.txt and batch_grading.log follow the shell scripts;
+ * summary and log entries are written in submission order.
+ *
+ * Usage: space_mission_grader [options] [submission.zip ...]
+ *   -j jobs      Submissions graded concurrently (default: one per CPU)
+ *   -t seconds   Time limit per submission (default 20)
+ *   -o dir       Results directory (default GRADING_RESULTS)
+ * Without arguments every *.zip in the current directory is graded.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <glob.h>
+#include <limits.h>
+#include <pthread.h>
+#include <regex.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+// Filled in from the Makefile so cached objects match a regular build
+#ifndef GRADER_CC
+#define GRADER_CC "gcc"
+#endif
+#ifndef GRADER_CFLAGS
+#define GRADER_CFLAGS "-std=c17 -Wall -Wextra -Werror -pedantic -g -O0"
+#endif
+#ifndef GRADER_LDLIBS
+#define GRADER_LDLIBS "-pthread -lrt"
+#endif
+#ifndef GRADER_FRAMEWORK_SOURCES
+#define GRADER_FRAMEWORK_SOURCES "driver.c"
+#endif
+#ifndef GRADER_HEADERS
+#define GRADER_HEADERS "space_mission.h"
+#endif
+
+#define GRADER_CACHE_DIR ".grader_cache"
+#define GRADER_MAX_ARGS 256
+#define GRADER_BUILD_SECONDS 15
+#define GRADER_RUN_SECONDS 20
+#define GRADER_VALGRIND_SECONDS 30
+#define GRADER_MAX_POINTS 90
+
+static const char* const g_student_files[] = {
+    "mission_control.c", "communication.c", "file_io.c", "memory_mgmt.c"
+};
+#define STUDENT_FILE_COUNT 4
+
+/* ========================================
+ * TEXT BUFFERS
+ * ======================================== */
+typedef struct {
+    char *data;
+    size_t length;
+    size_t capacity;
+} Buffer;
+
+static void buffer_append(Buffer* buffer, const char* text, size_t length) {
+    if (buffer->length + length + 1 > buffer->capacity) {
+        size_t capacity = buffer->capacity > 0 ? buffer->capacity : 1024;
+        while (capacity < buffer->length + length + 1) {
+            capacity *= 2;
+        }
+        char *data = realloc(buffer->data, capacity);
+        if (data == NULL) {
+            return;     // Drop the text rather than abort the batch
+        }
+        buffer->data = data;
+        buffer->capacity = capacity;
+    }
+    memcpy(buffer->data + buffer->length, text, length);
+    buffer->length += length;
+    buffer->data[buffer->length] = '\0';
+}
+
+static void buffer_printf(Buffer* buffer, const char* format, ...) {
+    char line[4096];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    if (length > 0) {
+        buffer_append(buffer, line, (size_t)length < sizeof(line) ? (size_t)length : sizeof(line) - 1);
+    }
+}
+
+static void buffer_free(Buffer* buffer) {
+    free(buffer->data);
+    buffer->data = NULL;
+    buffer->length = buffer->capacity = 0;
+}
+
+static int read_file(const char* path, Buffer* out) {
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL) {
+        return -1;
+    }
+    char chunk[8192];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), fp)) > 0) {
+        buffer_append(out, chunk, n);
+    }
+    fclose(fp);
+    return 0;
+}
+
+// dir + "/" + name; -1 if it does not fit
+static int join_path(char* out, size_t size, const char* dir, const char* name) {
+    size_t dir_length = strlen(dir);
+    size_t name_length = strlen(name);
+    if (dir_length + 1 + name_length >= size) {
+        return -1;
+    }
+    memcpy(out, dir, dir_length);
+    out[dir_length] = '/';
+    memcpy(out + dir_length + 1, name, name_length + 1);
+    return 0;
+}
+
+static void format_date(char* out, size_t size) {
+    // Same layout as date(1)
+    time_t now = time(NULL);
+    struct tm tm;
+    localtime_r(&now, &tm);
+    strftime(out, size, "%a %b %e %H:%M:%S %Z %Y", &tm);
+}
+
+/* ========================================
+ * OUTPUT COMPARISON
+ * ======================================== */
+typedef struct {
+    const char *prefix;
+    const char *name;
+    int max_points;
+} GradedFunction;
+
+static const GradedFunction g_functions[] = {
+    { "CREATE_SYSTEM", "Function1_create_mission_control", 10 },
+    { "CREATE_MISSION", "Function2_create_mission_with_crew", 25 },
+    { "ADD_COMM", "Function3_add_communication", 20 },
+    { "LOAD_FILE", "Function4_load_missions_from_file", 15 },
+    { "SAVE_REPORT", "Function5_save_mission_report", 10 },
+};
+#define GRADED_FUNCTION_COUNT ((int)(sizeof(g_functions) / sizeof(g_functions[0])))
+
+typedef struct {
+    char **lines;
+    int count;
+} LineList;
+
+// Lines starting with `prefix`, trailing whitespace removed, empty ones skipped
+static void select_lines(const char* text, const char* prefix, LineList* out) {
+    size_t prefix_length = strlen(prefix);
+    out->lines = NULL;
+    out->count = 0;
+    int capacity = 0;
+    for (const char *line = text; line != NULL && *line != '\0'; ) {
+        const char *end = strchr(line, '\n');
+        size_t length = end != NULL ? (size_t)(end - line) : strlen(line);
+        if (length >= prefix_length && memcmp(line, prefix, prefix_length) == 0) {
+            while (length > 0 && (line[length - 1] == ' ' || line[length - 1] == '\t' ||
+                                  line[length - 1] == '\r')) {
+                length--;
+            }
+            if (out->count == capacity) {
+                capacity = capacity > 0 ? capacity * 2 : 16;
+                char **lines = realloc(out->lines, (size_t)capacity * sizeof(char*));
+                if (lines == NULL) {
+                    return;
+                }
+                out->lines = lines;
+            }
+            char *copy = malloc(length + 1);
+            if (copy == NULL) {
+                return;
+            }
+            memcpy(copy, line, length);
+            copy[length] = '\0';
+            out->lines[out->count++] = copy;
+        }
+        line = end != NULL ? end + 1 : NULL;
+    }
+}
+
+static void free_lines(LineList* list) {
+    for (int i = 0; i < list->count; i++) {
+        free(list->lines[i]);
+    }
+    free(list->lines);
+    list->lines = NULL;
+    list->count = 0;
+}
+
+// Exact line-by-line match; a different line count scores 0
+static int match_percentage(const LineList* student, const LineList* expected) {
+    if (expected->count == 0 || student->count == 0 || student->count != expected->count) {
+        return 0;
+    }
+    int correct = 0;
+    for (int i = 0; i < expected->count; i++) {
+        correct += strcmp(student->lines[i], expected->lines[i]) == 0;
+    }
+    return correct * 100 / expected->count;
+}
+
+static void report_differences(Buffer* out, const LineList* student, const LineList* expected,
+                               const char* name) {
+    buffer_printf(out, "\n   🔍 DETAILED ANALYSIS for %s:\n", name);
+    buffer_printf(out, "   ==========================================\n");
+    buffer_printf(out, "   📊 EXPECTED OUTPUT (%d lines):\n", expected->count);
+    for (int i = 0; i < expected->count; i++) {
+        buffer_printf(out, "   %2d: %s\n", i + 1, expected->lines[i]);
+    }
+    buffer_printf(out, "\n   📊 YOUR OUTPUT (%d lines):\n", student->count);
+    for (int i = 0; i < student->count; i++) {
+        buffer_printf(out, "   %2d: %s\n", i + 1, student->lines[i]);
+    }
+    buffer_printf(out, "\n   🔍 LINE-BY-LINE COMPARISON:\n");
+    int max_lines = expected->count > student->count ? expected->count : student->count;
+    int mismatches = 0;
+    for (int i = 0; i < max_lines; i++) {
+        const char *want = i < expected->count ? expected->lines[i] : "";
+        const char *got = i < student->count ? student->lines[i] : "";
+        if (strcmp(want, got) == 0) {
+            buffer_printf(out, "   %2d: ✅ MATCH    %s\n", i + 1, want);
+        } else {
+            buffer_printf(out, "   %2d: ❌ DIFF     Expected Output: %s\n", i + 1, want);
+            buffer_printf(out, "   %2s \t           Your Output:     %s\n", "", got);
+            mismatches++;
+        }
+    }
+    buffer_printf(out, "\n   📈 SUMMARY: %d mismatches out of %d lines\n", mismatches, max_lines);
+    buffer_printf(out, "   ==========================================\n\n");
+}
+
+/* ========================================
+ * CHILD PROCESSES
+ * ======================================== */
+typedef enum {
+    RUN_EXITED,         // Finished; see exit_code
+    RUN_TIMED_OUT,      // Killed at the time limit
+    RUN_FAILED          // Could not be started
+} RunResult;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/*
+ * Run argv[0] (an absolute path) in `cwd` with stdout and stderr sent to
+ * `output_path` (NULL discards them). The child leads its own process
+ * group, so a timeout also kills anything it started.
+ */
+static RunResult run_process(char* const argv[], const char* cwd, const char* output_path,
+                             double limit_seconds, int* exit_code) {
+    pid_t pid = fork();
+    if (pid < 0) {
+        return RUN_FAILED;
+    }
+    if (pid == 0) {
+        // Only async-signal-safe calls between fork() and exec
+        setpgid(0, 0);
+        int in = open("/dev/null", O_RDONLY);
+        int out = open(output_path != NULL ? output_path : "/dev/null",
+                       O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (in < 0 || out < 0 || chdir(cwd) != 0) {
+            _exit(127);
+        }
+        dup2(in, STDIN_FILENO);
+        dup2(out, STDOUT_FILENO);
+        dup2(out, STDERR_FILENO);
+        execv(argv[0], argv);
+        _exit(127);
+    }
+    setpgid(pid, pid);
+
+    double deadline = now_seconds() + limit_seconds;
+    struct timespec pause = { 0, 2000000 };     // 2 ms
+    int status;
+    for (;;) {
+        pid_t done = waitpid(pid, &status, WNOHANG);
+        if (done == pid) {
+            break;
+        }
+        if (done < 0 && errno != EINTR) {
+            return RUN_FAILED;
+        }
+        if (now_seconds() >= deadline) {
+            kill(-pid, SIGKILL);
+            waitpid(pid, &status, 0);
+            return RUN_TIMED_OUT;
+        }
+        nanosleep(&pause, NULL);
+    }
+    *exit_code = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+    return RUN_EXITED;
+}
+
+// Absolute path of `name` on PATH, or NULL
+static char* find_program(const char* name) {
+    const char *path = getenv("PATH");
+    if (path == NULL) {
+        path = "/usr/bin:/bin";
+    }
+    while (*path != '\0') {
+        size_t length = strcspn(path, ":");
+        char candidate[PATH_MAX];
+        if (length > 0 && snprintf(candidate, sizeof(candidate), "%.*s/%s", (int)length, path,
+                                   name) < (int)sizeof(candidate) &&
+            access(candidate, X_OK) == 0) {
+            return strdup(candidate);
+        }
+        path += length + (path[length] == ':');
+    }
+    return NULL;
+}
+
+// Split a space-separated flag list into argv (modifies `text`)
+static int split_args(char* text, char** argv, int max) {
+    int count = 0;
+    for (char *token = strtok(text, " \t"); token != NULL && count < max;
+         token = strtok(NULL, " \t")) {
+        argv[count++] = token;
+    }
+    return count;
+}
+
+/* ========================================
+ * FILE SYSTEM HELPERS
+ * ======================================== */
+static int copy_file(const char* from, const char* to) {
+    int in = open(from, O_RDONLY);
+    if (in < 0) {
+        return -1;
+    }
+    int out = open(to, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (out < 0) {
+        close(in);
+        return -1;
+    }
+    char chunk[65536];
+    ssize_t n;
+    int result = 0;
+    while ((n = read(in, chunk, sizeof(chunk))) > 0) {
+        if (write(out, chunk, (size_t)n) != n) {
+            result = -1;
+            break;
+        }
+    }
+    if (n < 0) {
+        result = -1;
+    }
+    close(in);
+    return close(out) == 0 ? result : -1;
+}
+
+static void remove_tree(const char* path) {
+    struct stat st;
+    if (lstat(path, &st) != 0) {
+        return;
+    }
+    if (S_ISDIR(st.st_mode)) {
+        DIR *dir = opendir(path);
+        if (dir != NULL) {
+            struct dirent *entry;
+            while ((entry = readdir(dir)) != NULL) {
+                if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+                    continue;
+                }
+                char child[PATH_MAX];
+                if (snprintf(child, sizeof(child), "%s/%s", path, entry->d_name) < (int)sizeof(child)) {
+                    remove_tree(child);
+                }
+            }
+            closedir(dir);
+        }
+        rmdir(path);
+    } else {
+        unlink(path);
+    }
+}
+
+static int copy_tree(const char* from, const char* to) {
+    struct stat st;
+    if (lstat(from, &st) != 0) {
+        return -1;
+    }
+    if (!S_ISDIR(st.st_mode)) {
+        return S_ISREG(st.st_mode) ? copy_file(from, to) : 0;
+    }
+    if (mkdir(to, 0755) != 0 && errno != EEXIST) {
+        return -1;
+    }
+    DIR *dir = opendir(from);
+    if (dir == NULL) {
+        return -1;
+    }
+    int result = 0;
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+            continue;
+        }
+        char a[PATH_MAX], b[PATH_MAX];
+        if (snprintf(a, sizeof(a), "%s/%s", from, entry->d_name) >= (int)sizeof(a) ||
+            snprintf(b, sizeof(b), "%s/%s", to, entry->d_name) >= (int)sizeof(b) ||
+            copy_tree(a, b) != 0) {
+            result = -1;
+        }
+    }
+    closedir(dir);
+    return result;
+}
+
+static int contains_ignore_case(const char* text, const char* word) {
+    size_t length = strlen(word);
+    for (; *text != '\0'; text++) {
+        if (strncasecmp(text, word, length) == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+typedef int (*FileVisitor)(void* context, const char* path, const char* name);
+
+// Pre-order walk in directory order, like find(1); stops when visit returns non-zero
+static int walk_files(const char* root, FileVisitor visit, void* context) {
+    DIR *dir = opendir(root);
+    if (dir == NULL) {
+        return 0;
+    }
+    int stop = 0;
+    struct dirent *entry;
+    while (!stop && (entry = readdir(dir)) != NULL) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+            continue;
+        }
+        char path[PATH_MAX];
+        struct stat st;
+        if (snprintf(path, sizeof(path), "%s/%s", root, entry->d_name) >= (int)sizeof(path) ||
+            lstat(path, &st) != 0) {
+            continue;
+        }
+        if (S_ISREG(st.st_mode)) {
+            stop = visit(context, path, entry->d_name);
+        } else if (S_ISDIR(st.st_mode)) {
+            stop = walk_files(path, visit, context);
+        }
+    }
+    closedir(dir);
+    return stop;
+}
+
+typedef struct {
+    const char *name;
+    char path[PATH_MAX];
+} FileSearch;
+
+static int visit_find_first(void* context, const char* path, const char* name) {
+    FileSearch *search = context;
+    if (strcmp(name, search->name) != 0) {
+        return 0;
+    }
+    snprintf(search->path, sizeof(search->path), "%s", path);
+    return 1;
+}
+
+typedef struct {
+    char paths[64][PATH_MAX];
+    int count;
+} ReadmeCandidates;
+
+static int visit_readme(void* context, const char* path, const char* name) {
+    ReadmeCandidates *found = context;
+    if (contains_ignore_case(name, "readme") && found->count < 64) {
+        snprintf(found->paths[found->count++], PATH_MAX, "%s", path);
+    }
+    return 0;
+}
+
+// Preference: PDF > DOCX > TXT > MD > no extension (as the batch script)
+static const char* pick_readme(const ReadmeCandidates* found) {
+    static const char* const extensions[] = { ".pdf", ".docx", ".txt", ".md" };
+    for (int e = 0; e < 4; e++) {
+        for (int i = 0; i < found->count; i++) {
+            if (contains_ignore_case(found->paths[i], extensions[e])) {
+                return found->paths[i];
+            }
+        }
+    }
+    for (int i = 0; i < found->count; i++) {
+        const char *slash = strrchr(found->paths[i], '/');
+        if (slash != NULL && strcasecmp(slash + 1, "readme") == 0) {
+            return found->paths[i];
+        }
+    }
+    return NULL;
+}
+
+/* ========================================
+ * GRADER STATE
+ * ======================================== */
+typedef enum {
+    OUTCOME_GRADED,         // Autograder finished with a passing exit status
+    OUTCOME_FAILED,         // Extraction, missing files, README, or code errors
+    OUTCOME_TIMEOUT
+} GradeOutcome;
+
+typedef struct {
+    const char *zip_path;
+    char student_name[256];
+    char clean_name[256];
+    Buffer log;
+    char summary[512];
+    GradeOutcome outcome;
+    int perfect;
+    int compile_failed;
+    int done;               // Set (release) once log and summary are final
+} Submission;
+
+typedef struct {
+    int jobs;
+    double time_limit;
+    const char *results_dir;
+    char framework_dir[PATH_MAX];
+    char cache_dir[PATH_MAX];
+    char *cc;
+    char *unzip;
+    char *valgrind;         // NULL if not installed
+    char cflags[1024];
+    char ldlibs[256];
+    char *framework_sources[GRADER_MAX_ARGS];
+    char *framework_objects[GRADER_MAX_ARGS];
+    int framework_source_count;
+    char *load_files[16];   // Data files TESTCASES.txt loads
+    int load_file_count;
+    char *expected;         // EXPECTED_OUTPUT.txt
+    LineList expected_lines[GRADED_FUNCTION_COUNT];
+    regex_t name_patterns[5];
+    Submission *submissions;
+    int submission_count;
+    int next_task;          // Claimed with __atomic_fetch_add
+    int next_to_print;      // Submissions whose log has gone to stdout
+    int build_failed;
+    pthread_mutex_t print_lock;
+} Grader;
+
+static Grader g_grader;
+
+/* ========================================
+ * WORKER POOL
+ * ======================================== */
+typedef void (*GraderTask)(int index);
+
+typedef struct {
+    GraderTask task;
+    int count;
+} TaskBatch;
+
+static void* drain_tasks(void* arg) {
+    TaskBatch *batch = arg;
+    for (;;) {
+        int index = __atomic_fetch_add(&g_grader.next_task, 1, __ATOMIC_RELAXED);
+        if (index >= batch->count) {
+            return NULL;
+        }
+        batch->task(index);
+    }
+}
+
+static void run_tasks(GraderTask task, int count) {
+    TaskBatch batch = { task, count };
+    g_grader.next_task = 0;
+    int threads = g_grader.jobs < count ? g_grader.jobs : count;
+    pthread_t workers[GRADER_MAX_ARGS];
+    int started = 0;
+    for (int i = 1; i < threads && i < GRADER_MAX_ARGS; i++) {
+        if (pthread_create(&workers[started], NULL, drain_tasks, &batch) == 0) {
+            started++;
+        }
+    }
+    drain_tasks(&batch);
+    for (int i = 0; i < started; i++) {
+        pthread_join(workers[i], NULL);
+    }
+}
+
+/* ========================================
+ * FRAMEWORK OBJECT CACHE
+ * ======================================== */
+static time_t modified_time(const char* path) {
+    struct stat st;
+    return stat(path, &st) == 0 ? st.st_mtime : 0;
+}
+
+static char* object_path(const char* source) {
+    char path[PATH_MAX];
+    if (snprintf(path, sizeof(path), "%s/%.*s.o", g_grader.cache_dir, (int)(strlen(source) - 2),
+                 source) >= (int)sizeof(path)) {
+        return NULL;
+    }
+    return strdup(path);
+}
+
+static time_t g_newest_input;       // Newest header, or the flags stamp
+
+static void build_cached_object(int index) {
+    const char *source = g_grader.framework_sources[index];
+    char *object = g_grader.framework_objects[index];
+    time_t built = modified_time(object);
+    if (built != 0 && built >= modified_time(source) && built >= g_newest_input) {
+        return;
+    }
+
+    char flags[sizeof(g_grader.cflags)];
+    memcpy(flags, g_grader.cflags, sizeof(flags));
+    char *argv[GRADER_MAX_ARGS];
+    int argc = 0;
+    argv[argc++] = g_grader.cc;
+    argc += split_args(flags, argv + argc, GRADER_MAX_ARGS - 8);
+    argv[argc++] = "-c";
+    argv[argc++] = "-o";
+    argv[argc++] = object;
+    argv[argc++] = (char*)source;
+    argv[argc] = NULL;
+
+    char log_path[PATH_MAX];
+    snprintf(log_path, sizeof(log_path), "%s.log", object);
+    int exit_code;
+    if (run_process(argv, g_grader.framework_dir, log_path, 120, &exit_code) != RUN_EXITED ||
+        exit_code != 0) {
+        fprintf(stderr, "❌ ERROR: Failed to compile framework file %s (see %s)\n", source, log_path);
+        unlink(object);
+        __atomic_store_n(&g_grader.build_failed, 1, __ATOMIC_RELAXED);
+        return;
+    }
+    unlink(log_path);
+}
+
+static int build_framework_cache(void) {
+    if (mkdir(g_grader.cache_dir, 0755) != 0 && errno != EEXIST) {
+        return -1;
+    }
+
+    // Objects built with other flags are stale even if newer than the sources
+    char stamp_path[PATH_MAX];
+    if (join_path(stamp_path, sizeof(stamp_path), g_grader.cache_dir, "flags") != 0) {
+        return -1;
+    }
+    char stamp[sizeof(g_grader.cflags) + 64];
+    snprintf(stamp, sizeof(stamp), "%s %s\n", GRADER_CC, g_grader.cflags);
+    Buffer previous = { 0 };
+    if (read_file(stamp_path, &previous) != 0 || previous.data == NULL ||
+        strcmp(previous.data, stamp) != 0) {
+        FILE *fp = fopen(stamp_path, "w");
+        if (fp == NULL) {
+            buffer_free(&previous);
+            return -1;
+        }
+        fputs(stamp, fp);
+        fclose(fp);
+    }
+    buffer_free(&previous);
+    g_newest_input = modified_time(stamp_path);
+
+    char headers[1024];
+    snprintf(headers, sizeof(headers), "%s", GRADER_HEADERS);
+    char *names[GRADER_MAX_ARGS];
+    int header_count = split_args(headers, names, GRADER_MAX_ARGS);
+    for (int i = 0; i < header_count; i++) {
+        time_t t = modified_time(names[i]);
+        if (t > g_newest_input) {
+            g_newest_input = t;
+        }
+    }
+
+    run_tasks(build_cached_object, g_grader.framework_source_count);
+    return g_grader.build_failed ? -1 : 0;
+}
+
+/* ========================================
+ * STUDENT NAMES
+ * ======================================== */
+static const char* const g_name_patterns[5] = {
+    "^[Ss]pace.*[_.-]([A-Za-z]+[_[:space:]-]+[A-Za-z]+)",       // Space_Mission_First_Last
+    "^[Aa]ssignment.*[_.-]([A-Za-z]+[_[:space:]-]+[A-Za-z]+)",  // Assignment4_First_Last
+    "^([A-Za-z]+[_[:space:]-]+[A-Za-z]+)[_.-].*[Aa]ssignment",  // First_Last_Assignment4
+    "^([A-Za-z]+[_[:space:]-]+[A-Za-z]+)",                      // First_Last
+    "([A-Za-z]+)[._-]([A-Za-z]+)",                              // john.doe
+};
+
+static void copy_match(char* out, size_t size, const char* text, const regmatch_t* match) {
+    size_t length = (size_t)(match->rm_eo - match->rm_so);
+    if (length >= size) {
+        length = size - 1;
+    }
+    memcpy(out, text + match->rm_so, length);
+    out[length] = '\0';
+}
+
+static void extract_student_name(const char* zip_path, char* out, size_t size) {
+    const char *slash = strrchr(zip_path, '/');
+    char base[256];
+    snprintf(base, sizeof(base), "%s", slash != NULL ? slash + 1 : zip_path);
+    size_t length = strlen(base);
+    if (length > 4 && strcmp(base + length - 4, ".zip") == 0) {
+        base[length - 4] = '\0';
+    }
+
+    regmatch_t match[3];
+    out[0] = '\0';
+    for (int p = 0; p < 5; p++) {
+        if (regexec(&g_grader.name_patterns[p], base, 3, match, 0) != 0) {
+            continue;
+        }
+        if (p < 4) {
+            copy_match(out, size, base, &match[1]);
+        } else {
+            char first[128], last[128];
+            copy_match(first, sizeof(first), base, &match[1]);
+            copy_match(last, sizeof(last), base, &match[2]);
+            snprintf(out, size, "%s %s", first, last);
+        }
+        break;
+    }
+    if (out[0] == '\0') {
+        // Fallback: the file name, separators as spaces, other symbols dropped
+        size_t n = 0;
+        for (const char *c = base; *c != '\0' && n + 1 < size; c++) {
+            char ch = (*c == '_' || *c == '-') ? ' ' : *c;
+            if ((ch >= 'A' && ch <= 'Z') || (ch >= 'a' && ch <= 'z') ||
+                (ch >= '0' && ch <= '9') || ch == ' ') {
+                out[n++] = ch;
+            }
+        }
+        out[n] = '\0';
+    }
+    for (char *c = out; *c != '\0'; c++) {
+        if (*c == '_' || *c == '-') {
+            *c = ' ';
+        }
+    }
+    if (strspn(out, " \t") == strlen(out)) {
+        snprintf(out, size, "%s", base);
+    }
+}
+
+static void create_clean_name(const char* name, char* out, size_t size) {
+    size_t n = 0;
+    for (const char *c = name; *c != '\0' && n + 1 < size; c++) {
+        char ch = *c == ' ' ? '_' : *c;
+        if ((ch >= 'A' && ch <= 'Z') || (ch >= 'a' && ch <= 'z') || (ch >= '0' && ch <= '9') ||
+            ch == '_' || ch == '-') {
+            out[n++] = ch;
+        }
+    }
+    out[n] = '\0';
+}
+
+/* ========================================
+ * PER-SUBMISSION AUTOGRADER
+ * ======================================== */
+typedef enum {
+    AUTOGRADER_PASS,        // Exit status 0 in the shell version
+    AUTOGRADER_FAIL,        // Non-zero exit status
+    AUTOGRADER_TIMEOUT      // Submission time limit reached
+} AutograderResult;
+
+static double remaining(double deadline) {
+    double left = deadline - now_seconds();
+    return left > 0 ? left : 0;
+}
+
+// Step limit capped by the submission's deadline; *hit_deadline tells which one applied
+static double step_limit(double step_seconds, double deadline, int* hit_deadline) {
+    double left = remaining(deadline);
+    *hit_deadline = left <= step_seconds;
+    return *hit_deadline ? left : step_seconds;
+}
+
+static int link_data_files(const char* build_dir) {
+    static const char* const fixed[] = { "TESTCASES.txt" };
+    char from[PATH_MAX], to[PATH_MAX];
+    for (int i = 0; i < 1 + g_grader.load_file_count; i++) {
+        const char *name = i == 0 ? fixed[0] : g_grader.load_files[i - 1];
+        if (join_path(from, sizeof(from), g_grader.framework_dir, name) != 0 ||
+            join_path(to, sizeof(to), build_dir, name) != 0) {
+            return -1;
+        }
+        if (access(from, F_OK) == 0 && symlink(from, to) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int compile_submission(const char* build_dir, double deadline, Buffer* out,
+                              int* hit_deadline) {
+    char flags[sizeof(g_grader.cflags)];
+    char libs[sizeof(g_grader.ldlibs)];
+    memcpy(flags, g_grader.cflags, sizeof(flags));
+    memcpy(libs, g_grader.ldlibs, sizeof(libs));
+    char include[PATH_MAX + 2];
+    snprintf(include, sizeof(include), "-I%s", g_grader.framework_dir);
+
+    char *argv[GRADER_MAX_ARGS * 2];
+    int argc = 0;
+    argv[argc++] = g_grader.cc;
+    argc += split_args(flags, argv + argc, GRADER_MAX_ARGS);
+    argv[argc++] = include;
+    argv[argc++] = "-o";
+    argv[argc++] = "space_mission";
+    for (int i = 0; i < STUDENT_FILE_COUNT; i++) {
+        argv[argc++] = (char*)g_student_files[i];
+    }
+    for (int i = 0; i < g_grader.framework_source_count; i++) {
+        argv[argc++] = g_grader.framework_objects[i];
+    }
+    argc += split_args(libs, argv + argc, GRADER_MAX_ARGS / 2);
+    argv[argc] = NULL;
+
+    char log_path[PATH_MAX];
+    join_path(log_path, sizeof(log_path), build_dir, "compile.log");
+    int exit_code;
+    RunResult result = run_process(argv, build_dir, log_path,
+                                   step_limit(GRADER_BUILD_SECONDS, deadline, hit_deadline),
+                                   &exit_code);
+    if (result == RUN_EXITED && exit_code == 0) {
+        return 0;
+    }
+    if (result == RUN_TIMED_OUT && *hit_deadline) {
+        return -1;
+    }
+    *hit_deadline = 0;
+
+    // First ten lines of the compiler's complaints
+    Buffer errors = { 0 };
+    read_file(log_path, &errors);
+    buffer_printf(out, "❌ Compilation failed\n\nCompilation errors:\n");
+    int lines = 0;
+    for (const char *line = errors.data; line != NULL && *line != '\0' && lines < 10; lines++) {
+        const char *end = strchr(line, '\n');
+        size_t length = end != NULL ? (size_t)(end - line + 1) : strlen(line);
+        buffer_append(out, line, length);
+        line = end != NULL ? end + 1 : NULL;
+    }
+    buffer_free(&errors);
+    buffer_printf(out, "\nPlease fix compilation errors and resubmit.\n");
+    return -1;
+}
+
+static AutograderResult run_autograder(Submission* sub, const char* build_dir, double deadline,
+                                       Buffer* out) {
+    buffer_printf(out, "==========================================\n"
+                       "  Space Mission Control Autograder\n"
+                       "==========================================\n\n");
+    buffer_printf(out, "🔍 Checking required files...\n✅ All required files found\n");
+
+    // Build against the cached framework objects
+    buffer_printf(out, "🔨 Building space mission system...\n   Clean completed\n");
+    int hit_deadline;
+    if (compile_submission(build_dir, deadline, out, &hit_deadline) != 0) {
+        sub->compile_failed = !hit_deadline;
+        return hit_deadline ? AUTOGRADER_TIMEOUT : AUTOGRADER_FAIL;
+    }
+    buffer_printf(out, "✅ Compilation successful\n");
+
+    // Run the test driver
+    buffer_printf(out, "🚀 Running space mission system...\n");
+    char binary[PATH_MAX], raw_path[PATH_MAX];
+    if (join_path(binary, sizeof(binary), build_dir, "space_mission") != 0 ||
+        join_path(raw_path, sizeof(raw_path), build_dir, "STUDENT_OUTPUT_RAW.txt") != 0) {
+        return AUTOGRADER_FAIL;
+    }
+    char *run_argv[] = { binary, NULL };
+    int exit_code;
+    RunResult result = run_process(run_argv, build_dir, raw_path,
+                                   step_limit(GRADER_RUN_SECONDS, deadline, &hit_deadline),
+                                   &exit_code);
+    if (result == RUN_TIMED_OUT && hit_deadline) {
+        return AUTOGRADER_TIMEOUT;
+    }
+    if (result != RUN_EXITED || exit_code != 0) {
+        buffer_printf(out, result == RUN_TIMED_OUT ?
+                      "❌ Space mission system timed out (possible infinite loop)\n" :
+                      "❌ Space mission system crashed or failed\n");
+        buffer_printf(out, "\nDebug your implementation and try again.\n"
+                           "Common issues:\n"
+                           "  - Infinite loops in functions\n"
+                           "  - Segmentation faults (NULL pointer access)\n"
+                           "  - Missing return statements\n");
+        return AUTOGRADER_FAIL;
+    }
+    buffer_printf(out, "✅ Space mission system executed\n\n");
+
+    // Compare against the expected output, function by function
+    Buffer student = { 0 };
+    read_file(raw_path, &student);
+    buffer_printf(out, "🔍 Grading Function Implementations...\n");
+    int scores[GRADED_FUNCTION_COUNT + 1];
+    for (int f = 0; f < GRADED_FUNCTION_COUNT; f++) {
+        const GradedFunction *fn = &g_functions[f];
+        const LineList *expected = &g_grader.expected_lines[f];
+        LineList got;
+        select_lines(student.data != NULL ? student.data : "", fn->prefix, &got);
+        buffer_printf(out, "   Testing %s...\n", fn->name);
+        if (expected->count == 0) {
+            buffer_printf(out, "   ⚠️  No expected data found for %s\n", fn->name);
+        }
+        int percentage = match_percentage(&got, expected);
+        scores[f] = fn->max_points * percentage / 100;
+        if (percentage == 100) {
+            buffer_printf(out, "   ✅ %s: Perfect implementation (%d/%d points)\n", fn->name,
+                          scores[f], fn->max_points);
+        } else {
+            buffer_printf(out, percentage >= 70 ?
+                          "   🟡 %s: Good implementation (%d%% match, %d/%d points)\n" :
+                          "   ❌ %s: Issues detected (%d%% match, %d/%d points)\n",
+                          fn->name, percentage, scores[f], fn->max_points);
+            report_differences(out, &got, expected, fn->name);
+        }
+        free_lines(&got);
+    }
+    buffer_free(&student);
+
+    // Function 6 (free_mission_control) is scored by a valgrind run
+    buffer_printf(out, "   Testing Function6_free_mission_control...\n");
+    if (g_grader.valgrind != NULL) {
+        buffer_printf(out, "      💧 Running valgrind memory leak detection\n");
+        char *vg_argv[] = { g_grader.valgrind, "--leak-check=full", "--error-exitcode=1",
+                            "--quiet", binary, NULL };
+        result = run_process(vg_argv, build_dir, NULL,
+                             step_limit(GRADER_VALGRIND_SECONDS, deadline, &hit_deadline),
+                             &exit_code);
+        if (result == RUN_TIMED_OUT && hit_deadline) {
+            return AUTOGRADER_TIMEOUT;
+        }
+        if (result == RUN_EXITED && exit_code == 0) {
+            scores[GRADED_FUNCTION_COUNT] = 10;
+            buffer_printf(out, "   ✅ Function6_free_mission_control: No memory leaks detected (10/10 points)\n");
+        } else {
+            scores[GRADED_FUNCTION_COUNT] = 0;
+            buffer_printf(out, "   ❌ Function6_free_mission_control: Memory leaks detected (0/10 points)\n"
+                               "   💡 Run 'valgrind --leak-check=full ./space_mission' to debug\n");
+        }
+    } else {
+        scores[GRADED_FUNCTION_COUNT] = 5;      // Partial credit without valgrind
+        buffer_printf(out, "   ⚠️  Valgrind not available - giving partial credit (5/10 points)\n"
+                           "   📝 Install valgrind: sudo apt install valgrind\n");
+    }
+
+    int total = 0;
+    for (int f = 0; f <= GRADED_FUNCTION_COUNT; f++) {
+        total += scores[f];
+    }
+    int percentage = total * 100 / GRADER_MAX_POINTS;
+    buffer_printf(out, "\n==========================================\n"
+                       "           AUTOGRADER RESULTS\n"
+                       "==========================================\n");
+    buffer_printf(out, "Function 1 (create_mission_control):     %d/10 points\n", scores[0]);
+    buffer_printf(out, "Function 2 (create_mission_with_crew):   %d/25 points\n", scores[1]);
+    buffer_printf(out, "Function 3 (add_communication):          %d/20 points\n", scores[2]);
+    buffer_printf(out, "Function 4 (load_missions_from_file):    %d/15 points\n", scores[3]);
+    buffer_printf(out, "Function 5 (save_mission_report):        %d/10 points\n", scores[4]);
+    buffer_printf(out, "Function 6 (free_mission_control):       %d/10 points\n", scores[5]);
+    buffer_printf(out, "----------------------------------------\n");
+    buffer_printf(out, "AUTOGRADER TOTAL:         %d/%d points\n", total, GRADER_MAX_POINTS);
+    buffer_printf(out, "AUTOGRADER PERCENTAGE:    %d%%\n", percentage);
+    buffer_printf(out, "----------------------------------------\n");
+    buffer_printf(out, "Manual Grading:           /10 points (README + Code Quality)\n");
+    buffer_printf(out, "FINAL TOTAL:              /%d points\n", GRADER_MAX_POINTS + 10);
+    buffer_printf(out, "==========================================\n\n");
+
+    if (total == GRADER_MAX_POINTS) {
+        buffer_printf(out, "🎉 PERFECT! All functions working correctly!\n");
+    } else if (total >= 81) {
+        buffer_printf(out, "🌟 EXCELLENT! Outstanding implementation!\n");
+    } else if (total >= 72) {
+        buffer_printf(out, "👍 VERY GOOD! Strong implementation!\n");
+    } else if (total >= 63) {
+        buffer_printf(out, "✅ GOOD! Solid implementation!\n");
+    } else if (total >= 54) {
+        buffer_printf(out, "⚠️  SATISFACTORY! Needs some improvement!\n");
+    } else {
+        buffer_printf(out, "❌ NEEDS SIGNIFICANT WORK!\n");
+    }
+    buffer_printf(out, "\n📄 Debug files available:\n"
+                       "   - STUDENT_OUTPUT.txt (your program's output)\n"
+                       "   - EXPECTED_OUTPUT.txt (reference output)\n"
+                       "   - Run 'diff STUDENT_OUTPUT.txt EXPECTED_OUTPUT.txt' for detailed comparison\n"
+                       "   - Mission reports saved to Mission_Report/ directory\n");
+    buffer_printf(out, "\n📈 Test Levels Available:\n"
+                       "   SIMPLE (5 tests):   cp simple_input.txt INPUT.txt; cp simple_expected_output.txt EXPECTED_OUTPUT.txt\n"
+                       "   MODERATE (15 tests): cp moderate_input.txt INPUT.txt; cp moderate_expected_output.txt EXPECTED_OUTPUT.txt\n"
+                       "   RIGOROUS (30 tests): cp rigorous_input.txt INPUT.txt; cp rigorous_expected_output.txt EXPECTED_OUTPUT.txt\n");
+
+    // Same outcome rule as the shell autograder's exit status
+    if (percentage < 70) {
+        return AUTOGRADER_FAIL;
+    }
+    snprintf(sub->summary, sizeof(sub->summary), "%s: %d/%d (%d%%)", sub->student_name, total,
+             GRADER_MAX_POINTS, percentage);
+    sub->perfect = percentage == 100;
+    return AUTOGRADER_PASS;
+}
+
+/* ========================================
+ * PER-SUBMISSION BATCH STEPS
+ * ======================================== */
+#define SUB_LOG(sub, ...) buffer_printf(&(sub)->log, __VA_ARGS__)
+
+static void fail_submission(Submission* sub, const char* reason) {
+    snprintf(sub->summary, sizeof(sub->summary), "%s: %s", sub->student_name, reason);
+    sub->outcome = OUTCOME_FAILED;
+}
+
+static void write_grade_file(Submission* sub, const char* grade_path, const Buffer* autograder,
+                             AutograderResult result) {
+    FILE *fp = fopen(grade_path, "w");
+    if (fp == NULL) {
+        return;
+    }
+    char date[64];
+    format_date(date, sizeof(date));
+    fprintf(fp, "==========================================================================\n"
+                "              GRADE REPORT FOR: %s\n"
+                "==========================================================================\n"
+                "Submission File: %s\n"
+                "Graded on: %s\n"
+                "Graded by: Space Mission Control System Autograder\n\n",
+            sub->student_name, sub->zip_path, date);
+    fprintf(fp, "Implementation Files Submitted:\n-------------------------------\n");
+    for (int i = 0; i < STUDENT_FILE_COUNT; i++) {
+        fprintf(fp, "✅ %s\n", g_student_files[i]);
+    }
+    fprintf(fp, "\nAutograder Results:\n===================\n\n");
+    // Like the shell's $(...) capture: trailing newlines collapse to one
+    size_t length = autograder->length;
+    while (length > 0 && autograder->data[length - 1] == '\n') {
+        length--;
+    }
+    if (length > 0) {
+        fwrite(autograder->data, 1, length, fp);
+    }
+    fputc('\n', fp);
+    if (result == AUTOGRADER_TIMEOUT) {
+        fprintf(fp, "\nERROR: Autograder timed out after %.0f seconds\n"
+                    "This usually indicates infinite loops in your C implementations.\n"
+                    "Common causes in C programming:\n"
+                    "- Missing pointer increment statements in loops\n"
+                    "- Missing loop increment statements (i++ missing)\n"
+                    "- Incorrect pointer arithmetic causing endless loops\n"
+                    "- Wrong loop conditions or array bounds\n"
+                    "- Check mission_control.c, communication.c, file_io.c, and memory_mgmt.c functions\n",
+                g_grader.time_limit);
+    } else if (result == AUTOGRADER_FAIL) {
+        fprintf(fp, "\nERROR: Your C code caused the autograder to fail\n"
+                    "This indicates problems in your implementation:\n"
+                    "- Compilation errors (syntax errors, missing semicolons, etc.)\n"
+                    "- Runtime crashes (segmentation faults, null pointer access)\n"
+                    "- Infinite loops (missing pointer increments or incorrect conditions)\n"
+                    "- Missing or incomplete function implementations\n"
+                    "- Memory allocation/deallocation errors\n"
+                    "- Check your C code carefully for these common issues\n\n"
+                    "The problem is in YOUR CODE, not the grading system.\n");
+    }
+    fclose(fp);
+}
+
+static void grade_in_directory(Submission* sub, const char* temp_dir) {
+    char extract_dir[PATH_MAX], build_dir[PATH_MAX];
+    snprintf(extract_dir, sizeof(extract_dir), "%s/submission", temp_dir);
+    snprintf(build_dir, sizeof(build_dir), "%s/build", temp_dir);
+    double deadline = now_seconds() + g_grader.time_limit;
+
+    SUB_LOG(sub, "  📦 Extracting submission...\n");
+    char *unzip_argv[] = { g_grader.unzip, "-q", (char*)sub->zip_path, "-d", extract_dir, NULL };
+    int exit_code;
+    if (mkdir(extract_dir, 0755) != 0 || mkdir(build_dir, 0755) != 0 ||
+        run_process(unzip_argv, g_grader.framework_dir, NULL, 60, &exit_code) != RUN_EXITED ||
+        exit_code != 0) {
+        SUB_LOG(sub, "  ❌ ERROR: Failed to extract %s\n", sub->zip_path);
+        fail_submission(sub, "EXTRACTION_FAILED - Could not extract ZIP file");
+        return;
+    }
+
+    SUB_LOG(sub, "  🔍 Searching for required C implementation files...\n");
+    char found[STUDENT_FILE_COUNT][PATH_MAX];
+    char missing[256] = "";
+    for (int i = 0; i < STUDENT_FILE_COUNT; i++) {
+        FileSearch search = { g_student_files[i], "" };
+        walk_files(extract_dir, visit_find_first, &search);
+        snprintf(found[i], PATH_MAX, "%s", search.path);
+        if (search.path[0] != '\0') {
+            SUB_LOG(sub, "    ✅ Found: %s\n", g_student_files[i]);
+        } else {
+            SUB_LOG(sub, "    ❌ Missing: %s\n", g_student_files[i]);
+            size_t used = strlen(missing);
+            snprintf(missing + used, sizeof(missing) - used, "%s%s", used > 0 ? " " : "",
+                     g_student_files[i]);
+        }
+    }
+    if (missing[0] != '\0') {
+        SUB_LOG(sub, "  ❌ ERROR: Missing required implementation files: %s\n", missing);
+        char reason[300];
+        snprintf(reason, sizeof(reason), "MISSING_FILES - Missing: %s", missing);
+        fail_submission(sub, reason);
+        return;
+    }
+
+    SUB_LOG(sub, "  📋 Copying student implementation files...\n");
+    for (int i = 0; i < STUDENT_FILE_COUNT; i++) {
+        char to[PATH_MAX];
+        if (join_path(to, sizeof(to), build_dir, g_student_files[i]) != 0 ||
+            copy_file(found[i], to) != 0) {
+            SUB_LOG(sub, "  ❌ ERROR: Failed to copy %s\n", g_student_files[i]);
+            char reason[300];
+            snprintf(reason, sizeof(reason), "COPY_FAILED - Could not copy %s", g_student_files[i]);
+            fail_submission(sub, reason);
+            return;
+        }
+        SUB_LOG(sub, "    ✅ Copied: %s\n", g_student_files[i]);
+    }
+
+    ReadmeCandidates *readmes = calloc(1, sizeof(ReadmeCandidates));
+    const char *readme = NULL;
+    if (readmes != NULL) {
+        walk_files(extract_dir, visit_readme, readmes);
+        readme = pick_readme(readmes);
+    }
+    if (readme == NULL) {
+        free(readmes);
+        SUB_LOG(sub, "  ❌ ERROR: Missing README file\n");
+        fail_submission(sub, "MISSING_README - No README file found");
+        return;
+    }
+    SUB_LOG(sub, "    ✅ Found README: %s\n", strrchr(readme, '/') + 1);
+    free(readmes);
+
+    char grade_path[PATH_MAX];
+    snprintf(grade_path, sizeof(grade_path), "%s/%s_Grade.txt", g_grader.results_dir,
+             sub->clean_name);
+    SUB_LOG(sub, "  🚀 Running autograder...\n");
+
+    Buffer autograder = { 0 };
+    AutograderResult result = link_data_files(build_dir) == 0 ?
+                              run_autograder(sub, build_dir, deadline, &autograder) :
+                              AUTOGRADER_FAIL;
+    write_grade_file(sub, grade_path, &autograder, result);
+    buffer_free(&autograder);
+
+    if (result == AUTOGRADER_PASS) {
+        SUB_LOG(sub, "  ✅ Grading completed successfully\n");
+        SUB_LOG(sub, "  📊 Score: %s\n", sub->summary + strlen(sub->student_name) + 2);
+        sub->outcome = OUTCOME_GRADED;
+    } else if (result == AUTOGRADER_TIMEOUT) {
+        SUB_LOG(sub, "  ⏱️  ERROR: Autograder timed out (%.0f-second limit)\n", g_grader.time_limit);
+        snprintf(sub->summary, sizeof(sub->summary), "%s: TIMEOUT - Infinite loop detected",
+                 sub->student_name);
+        sub->outcome = OUTCOME_TIMEOUT;
+    } else {
+        SUB_LOG(sub, "  ❌ ERROR: Student code caused autograder failure\n");
+        fail_submission(sub, "CODE_ERROR - Student implementation issue");
+    }
+
+    char reports[PATH_MAX];
+    struct stat st;
+    if (join_path(reports, sizeof(reports), build_dir, "Mission_Report") == 0 &&
+        stat(reports, &st) == 0 && S_ISDIR(st.st_mode)) {
+        char saved[PATH_MAX];
+        snprintf(saved, sizeof(saved), "%s/%s_Mission_Report", g_grader.results_dir,
+                 sub->clean_name);
+        SUB_LOG(sub, "  📁 Saving Mission_Report directory...\n");
+        remove_tree(saved);
+        copy_tree(reports, saved);
+        SUB_LOG(sub, "    ✅ Mission reports saved to: %s\n", saved);
+    } else {
+        SUB_LOG(sub, "  ⚠️  No Mission_Report directory generated\n");
+    }
+    SUB_LOG(sub, "  💾 Grade saved to: %s\n", grade_path);
+}
+
+// Prints finished logs to stdout in submission order
+static void flush_logs(void) {
+    pthread_mutex_lock(&g_grader.print_lock);
+    while (g_grader.next_to_print < g_grader.submission_count) {
+        Submission *sub = &g_grader.submissions[g_grader.next_to_print];
+        if (!__atomic_load_n(&sub->done, __ATOMIC_ACQUIRE)) {
+            break;
+        }
+        fputs(sub->log.data != NULL ? sub->log.data : "", stdout);
+        g_grader.next_to_print++;
+    }
+    fflush(stdout);
+    pthread_mutex_unlock(&g_grader.print_lock);
+}
+
+static void grade_submission(int index) {
+    Submission *sub = &g_grader.submissions[index];
+    extract_student_name(sub->zip_path, sub->student_name, sizeof(sub->student_name));
+    create_clean_name(sub->student_name, sub->clean_name, sizeof(sub->clean_name));
+    SUB_LOG(sub, "Processing: %s (%s)\n", sub->student_name, sub->zip_path);
+
+    char temp_dir[] = "/tmp/space_mission_grade.XXXXXX";
+    if (mkdtemp(temp_dir) == NULL) {
+        SUB_LOG(sub, "  ❌ ERROR: Cannot create a temporary directory\n");
+        fail_submission(sub, "EXTRACTION_FAILED - Could not extract ZIP file");
+    } else {
+        grade_in_directory(sub, temp_dir);
+        SUB_LOG(sub, "  🧹 Cleaning up temporary files...\n");
+        remove_tree(temp_dir);
+    }
+    SUB_LOG(sub, "\n");
+
+    __atomic_store_n(&sub->done, 1, __ATOMIC_RELEASE);
+    flush_logs();
+}
+
+/* ========================================
+ * SETUP AND SUMMARY
+ * ======================================== */
+static int load_framework(void) {
+    static const char* const required[] = {
+        "driver.c", "space_mission.h", "Makefile", "TESTCASES.txt", "EXPECTED_OUTPUT.txt"
+    };
+    for (int i = 0; i < 5; i++) {
+        if (access(required[i], F_OK) != 0) {
+            printf("❌ ERROR: Required framework file '%s' not found!\n"
+                   "Please ensure all framework files are in the current directory.\n", required[i]);
+            return -1;
+        }
+    }
+
+    Buffer expected = { 0 };
+    if (read_file("EXPECTED_OUTPUT.txt", &expected) != 0) {
+        return -1;
+    }
+    g_grader.expected = expected.data != NULL ? expected.data : strdup("");
+    for (int f = 0; f < GRADED_FUNCTION_COUNT; f++) {
+        select_lines(g_grader.expected, g_functions[f].prefix, &g_grader.expected_lines[f]);
+    }
+
+    // Data files the test driver loads must be reachable from each build directory
+    FILE *fp = fopen("TESTCASES.txt", "r");
+    char line[512];
+    while (fp != NULL && fgets(line, sizeof(line), fp) && g_grader.load_file_count < 16) {
+        char name[256];
+        if (sscanf(line, "TEST_LOAD_FILE %255s", name) == 1 && strchr(name, '/') == NULL) {
+            g_grader.load_files[g_grader.load_file_count++] = strdup(name);
+        }
+    }
+    if (fp != NULL) {
+        fclose(fp);
+    }
+    return 0;
+}
+
+static void write_summary(const char* summary_path, const char* log_path) {
+    int total = g_grader.submission_count, graded = 0, failed = 0, perfect = 0, compile = 0;
+    char date[64];
+    format_date(date, sizeof(date));
+
+    FILE *summary = fopen(summary_path, "w");
+    FILE *log = fopen(log_path, "w");
+    if (summary == NULL || log == NULL) {
+        if (summary != NULL) {
+            fclose(summary);
+        }
+        if (log != NULL) {
+            fclose(log);
+        }
+        fprintf(stderr, "❌ ERROR: Cannot write to %s\n", g_grader.results_dir);
+        return;
+    }
+    fprintf(summary, "Space Mission Control System Assignment - Grading Summary\n"
+                     "Generated: %s\n"
+                     "=================================================================\n\n", date);
+    fprintf(log, "Batch Grading Log - %s\n=================================\n\n", date);
+    fprintf(log, "Found %d student submission(s) to process\n\n", total);
+
+    for (int i = 0; i < total; i++) {
+        const Submission *sub = &g_grader.submissions[i];
+        fprintf(summary, "%s\n", sub->summary);
+        if (sub->log.data != NULL) {
+            fputs(sub->log.data, log);
+        }
+        graded += sub->outcome == OUTCOME_GRADED;
+        failed += sub->outcome != OUTCOME_GRADED;
+        perfect += sub->perfect;
+        compile += sub->compile_failed;
+    }
+
+    fprintf(summary, "\n=================================================================\n"
+                     "                    GRADING STATISTICS\n"
+                     "=================================================================\n");
+    fprintf(summary, "Total Students Processed: %d\n", total);
+    fprintf(summary, "Successfully Graded: %d\n", graded);
+    fprintf(summary, "Failed to Grade: %d\n", failed);
+    fprintf(summary, "Perfect Autograder Scores: %d\n", perfect);
+    fprintf(summary, "Compilation Failures: %d\n\n", compile);
+    if (total > 0) {
+        fprintf(summary, "Success Rate: %d%%\n", graded * 100 / total);
+        fprintf(summary, "Perfect Score Rate: %d%%\n", perfect * 100 / total);
+        fprintf(summary, "Compilation Failure Rate: %d%%\n", compile * 100 / total);
+    }
+    fprintf(summary, "\nIndividual grade files are in: %s/\n", g_grader.results_dir);
+    fprintf(summary, "Individual Mission_Report directories are in: %s/\n", g_grader.results_dir);
+    fprintf(summary, "Detailed log file: %s\n\n", log_path);
+    fprintf(summary, "Note: Manual grading (10 points) for code quality, comments,\n"
+                     "and README still needs to be added to autograder scores.\n");
+    fclose(summary);
+    fclose(log);
+
+    printf("==========================================================================\n"
+           "                    BATCH GRADING COMPLETE\n"
+           "==========================================================================\n");
+    printf("🚀 Total Students Processed: %d\n", total);
+    printf("✅ Successfully Graded: %d\n", graded);
+    printf("❌ Failed to Grade: %d\n", failed);
+    printf("🌟 Perfect Autograder Scores: %d\n", perfect);
+    printf("🔨 Compilation Failures: %d\n", compile);
+    if (total > 0) {
+        printf("📈 Success Rate: %d%%\n", graded * 100 / total);
+        printf("⭐ Perfect Score Rate: %d%%\n", perfect * 100 / total);
+    }
+    printf("\n📁 Results Directory: %s/\n📋 Summary File: %s\n📝 Detailed Log: %s\n\n",
+           g_grader.results_dir, summary_path, log_path);
+}
+
+/* ========================================
+ * MAIN FUNCTION
+ * ======================================== */
+static void usage(const char* prog) {
+    fprintf(stderr, "Usage: %s [-j jobs] [-t seconds] [-o results_dir] [submission.zip ...]\n", prog);
+}
+
+int main(int argc, char* argv[]) {
+    g_grader.jobs = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    g_grader.time_limit = 20;
+    g_grader.results_dir = "GRADING_RESULTS";
+    pthread_mutex_init(&g_grader.print_lock, NULL);
+
+    int first_zip = argc;
+    for (int i = 1; i < argc; i++) {
+        if (argv[i][0] != '-') {
+            first_zip = i;
+            break;
+        }
+        if (argv[i][1] == '\0' || argv[i][2] != '\0' || i + 1 >= argc) {
+            usage(argv[0]);
+            return 1;
+        }
+        const char* value = argv[++i];
+        switch (argv[i - 1][1]) {
+            case 'j': g_grader.jobs = atoi(value); break;
+            case 't': g_grader.time_limit = atof(value); break;
+            case 'o': g_grader.results_dir = value; break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (g_grader.jobs < 1) {
+        g_grader.jobs = 1;
+    }
+    if (g_grader.jobs > GRADER_MAX_ARGS) {
+        g_grader.jobs = GRADER_MAX_ARGS;
+    }
+    if (g_grader.time_limit <= 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    printf("==========================================================================\n"
+           "        Space Mission Control System Assignment - Batch Grading\n"
+           "==========================================================================\n");
+    if (load_framework() != 0 || getcwd(g_grader.framework_dir, sizeof(g_grader.framework_dir)) == NULL) {
+        return 1;
+    }
+    if (join_path(g_grader.cache_dir, sizeof(g_grader.cache_dir), g_grader.framework_dir,
+                  GRADER_CACHE_DIR) != 0) {
+        return 1;
+    }
+    snprintf(g_grader.cflags, sizeof(g_grader.cflags), "%s", GRADER_CFLAGS);
+    snprintf(g_grader.ldlibs, sizeof(g_grader.ldlibs), "%s", GRADER_LDLIBS);
+    static char sources[4096];
+    snprintf(sources, sizeof(sources), "%s", GRADER_FRAMEWORK_SOURCES);
+    g_grader.framework_source_count = split_args(sources, g_grader.framework_sources,
+                                                 GRADER_MAX_ARGS);
+    for (int i = 0; i < g_grader.framework_source_count; i++) {
+        if ((g_grader.framework_objects[i] = object_path(g_grader.framework_sources[i])) == NULL) {
+            return 1;
+        }
+    }
+    g_grader.cc = GRADER_CC[0] == '/' ? strdup(GRADER_CC) : find_program(GRADER_CC);
+    g_grader.unzip = find_program("unzip");
+    g_grader.valgrind = find_program("valgrind");
+    if (g_grader.cc == NULL || g_grader.unzip == NULL) {
+        printf("❌ ERROR: %s not found on PATH\n", g_grader.cc == NULL ? GRADER_CC : "unzip");
+        return 1;
+    }
+    for (int p = 0; p < 5; p++) {
+        if (regcomp(&g_grader.name_patterns[p], g_name_patterns[p], REG_EXTENDED) != 0) {
+            return 1;
+        }
+    }
+
+    // Submissions: the arguments, or every *.zip here (sorted, as the shell glob)
+    glob_t found = { 0 };
+    char **zips = argv + first_zip;
+    int zip_count = argc - first_zip;
+    if (zip_count == 0) {
+        if (glob("*.zip", 0, NULL, &found) == 0) {
+            zips = found.gl_pathv;
+            zip_count = (int)found.gl_pathc;
+        }
+        if (zip_count == 0) {
+            printf("❌ No ZIP files found in current directory\n");
+            return 1;
+        }
+    }
+    if (mkdir(g_grader.results_dir, 0755) != 0 && errno != EEXIST) {
+        printf("❌ ERROR: Cannot create %s\n", g_grader.results_dir);
+        return 1;
+    }
+
+    double start = now_seconds();
+    if (build_framework_cache() != 0) {
+        return 1;
+    }
+    g_grader.submissions = calloc((size_t)zip_count, sizeof(Submission));
+    if (g_grader.submissions == NULL) {
+        return 1;
+    }
+    g_grader.submission_count = zip_count;
+    for (int i = 0; i < zip_count; i++) {
+        g_grader.submissions[i].zip_path = zips[i];
+    }
+    printf("Found %d student submission(s) to process (%d jobs)\n\n", zip_count, g_grader.jobs);
+    fflush(stdout);
+    run_tasks(grade_submission, zip_count);
+
+    char summary_path[PATH_MAX], log_path[PATH_MAX];
+    snprintf(summary_path, sizeof(summary_path), "%s/GRADING_SUMMARY.txt", g_grader.results_dir);
+    snprintf(log_path, sizeof(log_path), "%s/batch_grading.log", g_grader.results_dir);
+    write_summary(summary_path, log_path);
+    printf("⏱️  Graded %d submission(s) in %.1f s\n", zip_count, now_seconds() - start);
+
+    for (int i = 0; i < zip_count; i++) {
+        buffer_free(&g_grader.submissions[i].log);
+    }
+    free(g_grader.submissions);
+    globfree(&found);
+    return 0;
+}
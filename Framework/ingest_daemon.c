@@ -0,0 +1,431 @@
+/**
+ * @file ingest_daemon.c
+ * @brief Space Mission Control System - Socket Ingest Daemon
+ *
+ * A single-threaded epoll loop that accepts producers on a Unix domain
+ * socket or a localhost TCP port and applies their requests to one
+ * MissionControl. Because only this thread mutates the system, no locking
+ * is needed around the core calls.
+ *
+ * Requests are coalesced per connection: one read() pulls in everything
+ * the producer has pipelined (up to INGEST_BUFFER_BYTES), every complete
+ * line is applied back to back, and the one-line responses for the whole
+ * batch go out in a single write(). While a connection still has unsent
+ * responses it is not read from, which bounds its memory and pushes back
+ * on producers that do not read their replies.
+ *
+ * Protocol (one request per line, one response line per request):
+ *   M <mission_id> <name> <YYYY-MM-DD>                     create mission
+ *   C <mission_id> <priority> <YYYY-MM-DD HH:MM> <message> add communication
+ *   X                                                      stop the daemon
+ * Responses: "+" success, "-" rejected by the system, "?" malformed,
+ * "=" a log already stored (with enable_comm_dedup(); safe to treat as done).
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "space_mission.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#define INGEST_BUFFER_BYTES (64 * 1024)   // Per-connection input and output buffers
+#define INGEST_MAX_EVENTS 64
+#define INGEST_TIMESTAMP_LENGTH 16        // "YYYY-MM-DD HH:MM"
+
+typedef struct IngestConnection {
+    int fd;
+    char in[INGEST_BUFFER_BYTES];
+    size_t in_length;
+    char out[INGEST_BUFFER_BYTES];      // Responses never outgrow the requests they answer
+    size_t out_length;
+    size_t out_sent;
+    int eof;                            // Peer finished sending
+    int failed;                         // Socket error or oversized line; drop it
+    struct IngestConnection *prev;
+    struct IngestConnection *next;
+} IngestConnection;
+
+typedef struct {
+    MissionControl *system;
+    IngestStats *stats;
+    int epoll_fd;
+    int listen_fd;
+    int signal_fd;
+    int stopping;
+    IngestConnection *connections;
+} IngestDaemon;
+
+// epoll_event.data.ptr tags for the two non-connection descriptors
+static char g_listener_tag;
+static char g_signal_tag;
+
+/* ========================================
+ * REQUEST HANDLING
+ * ======================================== */
+// Parses a non-negative decimal field ending at a space; advances *cursor
+static int parse_field_int(char** cursor, int* value) {
+    char *p = *cursor;
+    long parsed = 0;
+    if (*p < '0' || *p > '9') {
+        return 0;
+    }
+    while (*p >= '0' && *p <= '9') {
+        parsed = parsed * 10 + (*p++ - '0');
+        if (parsed > 2147483647L) {
+            return 0;
+        }
+    }
+    if (*p != ' ') {
+        return 0;
+    }
+    *value = (int)parsed;
+    *cursor = p + 1;
+    return 1;
+}
+
+// Returns the next space-terminated field (NUL-terminated in place)
+static char* parse_field_word(char** cursor) {
+    char *start = *cursor;
+    char *end = strchr(start, ' ');
+    if (end == NULL || end == start) {
+        return NULL;
+    }
+    *end = '\0';
+    *cursor = end + 1;
+    return start;
+}
+
+// Applies one request line; returns the response character
+static char handle_request(IngestDaemon* daemon, char* line) {
+    char *cursor = line + 2;
+    int mission_id;
+    int priority;
+
+    if (line[0] == 'X' && line[1] == '\0') {
+        daemon->stopping = 1;
+        return '+';
+    }
+    if (line[1] != ' ') {
+        return '?';
+    }
+    if (line[0] == 'M') {
+        char *name;
+        if (!parse_field_int(&cursor, &mission_id) || (name = parse_field_word(&cursor)) == NULL ||
+            *cursor == '\0' || strchr(cursor, ' ') != NULL) {
+            return '?';
+        }
+        name[strnlen(name, MAX_NAME_LENGTH - 1)] = '\0';
+        return create_mission_with_crew(daemon->system, mission_id, name, cursor) == 0 ? '+' : '-';
+    }
+    if (line[0] == 'C') {
+        // The timestamp has a fixed width, so the message is the rest of the line
+        size_t timestamp_length = INGEST_TIMESTAMP_LENGTH;
+        if (!parse_field_int(&cursor, &mission_id) || !parse_field_int(&cursor, &priority) ||
+            strnlen(cursor, timestamp_length + 1) <= timestamp_length ||
+            cursor[timestamp_length] != ' ') {
+            return '?';
+        }
+        char *timestamp = cursor;
+        char *message = cursor + timestamp_length + 1;
+        timestamp[timestamp_length] = '\0';
+        message[strnlen(message, MAX_MESSAGE_LENGTH - 1)] = '\0';
+        CommAddStatus status = add_communication_ex(daemon->system, mission_id, timestamp,
+                                                    (MessagePriority)priority, message);
+        if (status == COMM_ADD_OK) {
+            return '+';
+        }
+        return status == COMM_ADD_DUPLICATE ? '=' : '-';
+    }
+    return '?';
+}
+
+// Applies every complete line in the input buffer and queues the responses
+static void process_requests(IngestDaemon* daemon, IngestConnection* conn) {
+    char *line = conn->in;
+    char *end = conn->in + conn->in_length;
+    char *newline;
+    while (!daemon->stopping && (newline = memchr(line, '\n', (size_t)(end - line))) != NULL) {
+        *newline = '\0';
+        if (newline > line && newline[-1] == '\r') {
+            newline[-1] = '\0';
+        }
+        if (line[0] != '\0') {
+            char response = handle_request(daemon, line);
+            daemon->stats->requests++;
+            if (response == '-') {
+                daemon->stats->rejected++;
+            } else if (response == '?') {
+                daemon->stats->malformed++;
+            } else if (response == '=') {
+                daemon->stats->duplicates++;
+            }
+            conn->out[conn->out_length++] = response;
+            conn->out[conn->out_length++] = '\n';
+        }
+        line = newline + 1;
+    }
+
+    conn->in_length = (size_t)(end - line);
+    memmove(conn->in, line, conn->in_length);
+    if (conn->in_length == sizeof(conn->in)) {
+        conn->failed = 1;       // A single line filled the whole buffer
+    }
+}
+
+/* ========================================
+ * CONNECTION I/O
+ * ======================================== */
+static void read_requests(IngestDaemon* daemon, IngestConnection* conn) {
+    ssize_t received = read(conn->fd, conn->in + conn->in_length,
+                            sizeof(conn->in) - conn->in_length);
+    if (received == 0) {
+        conn->eof = 1;
+        return;
+    }
+    if (received < 0) {
+        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+            conn->failed = 1;
+        }
+        return;
+    }
+    conn->in_length += (size_t)received;
+    process_requests(daemon, conn);
+}
+
+static void flush_responses(IngestConnection* conn) {
+    while (conn->out_sent < conn->out_length) {
+        // MSG_NOSIGNAL: a vanished peer is an EPIPE error, not a SIGPIPE
+        ssize_t written = send(conn->fd, conn->out + conn->out_sent,
+                               conn->out_length - conn->out_sent, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                conn->failed = 1;
+            }
+            return;
+        }
+        conn->out_sent += (size_t)written;
+    }
+    conn->out_length = 0;
+    conn->out_sent = 0;
+}
+
+static void close_connection(IngestDaemon* daemon, IngestConnection* conn) {
+    if (conn->prev != NULL) {
+        conn->prev->next = conn->next;
+    } else {
+        daemon->connections = conn->next;
+    }
+    if (conn->next != NULL) {
+        conn->next->prev = conn->prev;
+    }
+    close(conn->fd);
+    free(conn);
+}
+
+// Reads only while nothing is waiting to be sent (see file comment)
+static void update_interest(IngestDaemon* daemon, IngestConnection* conn) {
+    struct epoll_event event;
+    event.events = conn->out_length > 0 ? EPOLLOUT : EPOLLIN;
+    event.data.ptr = conn;
+    if (epoll_ctl(daemon->epoll_fd, EPOLL_CTL_MOD, conn->fd, &event) != 0) {
+        conn->failed = 1;
+    }
+}
+
+static void service_connection(IngestDaemon* daemon, IngestConnection* conn, uint32_t events) {
+    int had_output = conn->out_length > 0;
+    if (had_output && (events & (EPOLLOUT | EPOLLERR | EPOLLHUP))) {
+        flush_responses(conn);
+    }
+    if (conn->out_length == 0 && !conn->eof && (events & (EPOLLIN | EPOLLERR | EPOLLHUP))) {
+        read_requests(daemon, conn);
+        flush_responses(conn);
+    }
+
+    if (conn->failed || (conn->eof && conn->out_length == 0)) {
+        close_connection(daemon, conn);
+    } else if (had_output != (conn->out_length > 0)) {
+        update_interest(daemon, conn);
+    }
+}
+
+static int set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) != 0) ? -1 : 0;
+}
+
+static void accept_connections(IngestDaemon* daemon) {
+    for (;;) {
+        int fd = accept(daemon->listen_fd, NULL, NULL);
+        if (fd < 0) {
+            return;     // EAGAIN once the backlog is drained
+        }
+        IngestConnection *conn = malloc(sizeof(IngestConnection));
+        struct epoll_event event;
+        event.events = EPOLLIN;
+        event.data.ptr = conn;
+        if (conn == NULL || set_nonblocking(fd) != 0 ||
+            epoll_ctl(daemon->epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            free(conn);
+            close(fd);
+            continue;
+        }
+        conn->fd = fd;
+        conn->in_length = 0;
+        conn->out_length = 0;
+        conn->out_sent = 0;
+        conn->eof = 0;
+        conn->failed = 0;
+        conn->prev = NULL;
+        conn->next = daemon->connections;
+        if (conn->next != NULL) {
+            conn->next->prev = conn;
+        }
+        daemon->connections = conn;
+        daemon->stats->connections++;
+    }
+}
+
+/* ========================================
+ * LISTENING SOCKET
+ * ======================================== */
+static int open_listener(const IngestConfig* config) {
+    int fd;
+    if (config->unix_path != NULL) {
+        struct sockaddr_un addr;
+        if (strlen(config->unix_path) >= sizeof(addr.sun_path)) {
+            return -1;
+        }
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        strcpy(addr.sun_path, config->unix_path);
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        unlink(config->unix_path);
+        if (fd < 0 || bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+            goto fail;
+        }
+    } else {
+        struct sockaddr_in addr;
+        int reuse = 1;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons((uint16_t)config->tcp_port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0 || setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) != 0 ||
+            bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+            goto fail;
+        }
+    }
+    if (listen(fd, SOMAXCONN) != 0 || set_nonblocking(fd) != 0) {
+        goto fail;
+    }
+    return fd;
+
+fail:
+    if (fd >= 0) {
+        close(fd);
+    }
+    return -1;
+}
+
+static int watch(int epoll_fd, int fd, void* tag) {
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.ptr = tag;
+    return epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event);
+}
+
+/* ========================================
+ * PUBLIC API
+ * ======================================== */
+int run_ingest_daemon(MissionControl* system, const IngestConfig* config, IngestStats* stats) {
+    IngestStats local_stats;
+    if (stats == NULL) {
+        stats = &local_stats;
+    }
+    memset(stats, 0, sizeof(IngestStats));
+    if (system == NULL || config == NULL ||
+        (config->unix_path == NULL && (config->tcp_port <= 0 || config->tcp_port > 65535))) {
+        return -1;
+    }
+
+    // SIGINT/SIGTERM arrive through a signalfd so shutdown happens between batches
+    sigset_t stop_signals;
+    sigset_t old_mask;
+    sigemptyset(&stop_signals);
+    sigaddset(&stop_signals, SIGINT);
+    sigaddset(&stop_signals, SIGTERM);
+
+    IngestDaemon daemon = { system, stats, -1, -1, -1, 0, NULL };
+    int result = -1;
+    if (pthread_sigmask(SIG_BLOCK, &stop_signals, &old_mask) != 0) {
+        return -1;
+    }
+    daemon.epoll_fd = epoll_create1(0);
+    daemon.listen_fd = open_listener(config);
+    daemon.signal_fd = signalfd(-1, &stop_signals, 0);
+    if (daemon.epoll_fd < 0 || daemon.listen_fd < 0 || daemon.signal_fd < 0 ||
+        watch(daemon.epoll_fd, daemon.listen_fd, &g_listener_tag) != 0 ||
+        watch(daemon.epoll_fd, daemon.signal_fd, &g_signal_tag) != 0) {
+        goto cleanup;
+    }
+
+    struct epoll_event events[INGEST_MAX_EVENTS];
+    result = 0;
+    while (!daemon.stopping) {
+        int ready = epoll_wait(daemon.epoll_fd, events, INGEST_MAX_EVENTS, -1);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            result = -1;
+            break;
+        }
+        for (int i = 0; i < ready; i++) {
+            void *tag = events[i].data.ptr;
+            if (tag == &g_listener_tag) {
+                accept_connections(&daemon);
+            } else if (tag == &g_signal_tag) {
+                // Consume it so it is not delivered once the mask is restored
+                struct signalfd_siginfo info;
+                if (read(daemon.signal_fd, &info, sizeof(info)) > 0) {
+                    daemon.stopping = 1;
+                }
+            } else {
+                service_connection(&daemon, tag, events[i].events);
+            }
+        }
+    }
+
+cleanup:
+    while (daemon.connections != NULL) {
+        flush_responses(daemon.connections);    // Best effort for the final batch
+        close_connection(&daemon, daemon.connections);
+    }
+    if (daemon.signal_fd >= 0) {
+        close(daemon.signal_fd);
+    }
+    if (daemon.listen_fd >= 0) {
+        close(daemon.listen_fd);
+        if (config->unix_path != NULL) {
+            unlink(config->unix_path);
+        }
+    }
+    if (daemon.epoll_fd >= 0) {
+        close(daemon.epoll_fd);
+    }
+    pthread_sigmask(SIG_SETMASK, &old_mask, NULL);
+    return result;
+}
@@ -0,0 +1,326 @@
+/**
+ * @file ingest_loadgen.c
+ * @brief Space Mission Control System - Ingest Daemon Load Generator
+ *
+ * Drives a running `space_mission --daemon` over several connections.
+ * Connection 0 first creates the missions, then every connection streams
+ * add-communication requests with up to `window` requests in flight,
+ * counting the responses. Prints the sustained request rate.
+ *
+ * Usage: space_mission_loadgen [options]
+ *   -s path      Unix socket of the daemon (default /tmp/space_mission.sock)
+ *   -p port      Connect to 127.0.0.1:port instead of a Unix socket
+ *   -c count     Producer connections (default 4)
+ *   -n count     Add-communication requests in total (default 1000000)
+ *   -m count     Missions to create first (default 1000)
+ *   -w window    Requests in flight per connection (default 1024)
+ *   -x           Ask the daemon to shut down afterwards
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#define LOADGEN_BUFFER_BYTES (64 * 1024)
+#define LOADGEN_LINE_MAX 128
+#define LOADGEN_MAX_CONNECTIONS 256
+
+/* ========================================
+ * LOAD GENERATOR CONFIGURATION
+ * ======================================== */
+typedef struct {
+    const char* socket_path;
+    int port;
+    int connections;
+    long requests;
+    long missions;
+    long window;
+    int shutdown;
+} LoadConfig;
+
+typedef struct {
+    int fd;
+    long to_send;           // Requests this connection still has to generate
+    long sent;
+    long answered;
+    long next_index;        // Drives the generated request contents
+    long stride;
+    char out[LOADGEN_BUFFER_BYTES];
+    size_t out_length;
+    size_t out_sent;
+} LoadConnection;
+
+typedef struct {
+    long ok;
+    long rejected;
+    long malformed;
+} LoadResults;
+
+static const char* g_messages[] = {
+    "Telemetry nominal", "Orbit adjustment complete", "Battery at 62 percent",
+    "Thermal warning on panel B", "Loss of signal imminent", "Hull breach detected"
+};
+
+/* ========================================
+ * CONNECTIONS
+ * ======================================== */
+static int connect_daemon(const LoadConfig* cfg) {
+    int fd;
+    if (cfg->port > 0) {
+        struct sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons((uint16_t)cfg->port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd >= 0 && connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+            close(fd);
+            fd = -1;
+        }
+    } else {
+        struct sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, cfg->socket_path, sizeof(addr.sun_path) - 1);
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd >= 0 && connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+    return fd;
+}
+
+/* ========================================
+ * REQUEST GENERATION
+ * ======================================== */
+static int format_create(char* out, long index) {
+    long id = index + 1;
+    return snprintf(out, LOADGEN_LINE_MAX, "M %ld LOAD-%ld 2030-%02ld-%02ld\n",
+                    id, id, index % 12 + 1, index % 28 + 1);
+}
+
+static int format_comm(char* out, long index, long missions) {
+    long minute = index % (28L * 24 * 60);
+    int priority = index % 20 == 0 ? 3 : (index % 4 == 0 ? 2 : 1);
+    return snprintf(out, LOADGEN_LINE_MAX, "C %ld %d 2030-01-%02ld %02ld:%02ld %s\n",
+                    index % missions + 1, priority, minute / (24 * 60) + 1,
+                    minute / 60 % 24, minute % 60,
+                    g_messages[index % (long)(sizeof(g_messages) / sizeof(g_messages[0]))]);
+}
+
+// Queue as many requests as the window and buffer allow
+static void fill_requests(LoadConnection* conn, const LoadConfig* cfg, int creating) {
+    conn->out_length = 0;
+    conn->out_sent = 0;
+    while (conn->to_send > 0 && conn->sent - conn->answered < cfg->window &&
+           LOADGEN_BUFFER_BYTES - conn->out_length >= LOADGEN_LINE_MAX) {
+        char *line = conn->out + conn->out_length;
+        int length = creating ? format_create(line, conn->next_index)
+                              : format_comm(line, conn->next_index, cfg->missions);
+        conn->out_length += (size_t)length;
+        conn->next_index += conn->stride;
+        conn->to_send--;
+        conn->sent++;
+    }
+}
+
+/* ========================================
+ * EVENT LOOP
+ * ======================================== */
+static int count_responses(LoadConnection* conn, LoadResults* results) {
+    char buffer[LOADGEN_BUFFER_BYTES];
+    ssize_t received = read(conn->fd, buffer, sizeof(buffer));
+    if (received <= 0) {
+        return received < 0 && errno == EINTR ? 0 : -1;
+    }
+    for (ssize_t i = 0; i < received; i++) {
+        switch (buffer[i]) {
+            case '+': results->ok++; conn->answered++; break;
+            case '=': results->ok++; conn->answered++; break;   // Already stored
+            case '-': results->rejected++; conn->answered++; break;
+            case '?': results->malformed++; conn->answered++; break;
+            default: break;
+        }
+    }
+    return 0;
+}
+
+static int run_phase(LoadConnection* conns, int count, const LoadConfig* cfg, int creating,
+                     LoadResults* results) {
+    struct pollfd fds[LOADGEN_MAX_CONNECTIONS];
+    for (;;) {
+        int active = 0;
+        for (int i = 0; i < count; i++) {
+            LoadConnection *conn = &conns[i];
+            if (conn->out_sent == conn->out_length) {
+                fill_requests(conn, cfg, creating);
+            }
+            fds[i].fd = conn->fd;
+            fds[i].events = 0;
+            fds[i].revents = 0;
+            if (conn->out_sent < conn->out_length) {
+                fds[i].events |= POLLOUT;
+            }
+            if (conn->answered < conn->sent) {
+                fds[i].events |= POLLIN;
+            }
+            active += fds[i].events != 0;
+        }
+        if (active == 0) {
+            return 0;
+        }
+        if (poll(fds, (nfds_t)count, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+
+        for (int i = 0; i < count; i++) {
+            LoadConnection *conn = &conns[i];
+            if (fds[i].revents & POLLOUT) {
+                ssize_t written = write(conn->fd, conn->out + conn->out_sent,
+                                        conn->out_length - conn->out_sent);
+                if (written < 0 && errno != EINTR && errno != EAGAIN) {
+                    return -1;
+                }
+                if (written > 0) {
+                    conn->out_sent += (size_t)written;
+                }
+            }
+            if ((fds[i].revents & (POLLIN | POLLHUP | POLLERR)) &&
+                count_responses(conn, results) != 0) {
+                return -1;
+            }
+        }
+    }
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static int run_load(const LoadConfig* cfg) {
+    LoadConnection *conns = calloc((size_t)cfg->connections, sizeof(LoadConnection));
+    if (conns == NULL) {
+        return -1;
+    }
+    int result = -1;
+    int opened = 0;
+    for (; opened < cfg->connections; opened++) {
+        conns[opened].fd = connect_daemon(cfg);
+        if (conns[opened].fd < 0) {
+            fprintf(stderr, "LOADGEN: cannot connect to the daemon\n");
+            goto cleanup;
+        }
+    }
+
+    LoadResults created = { 0, 0, 0 };
+    conns[0].to_send = cfg->missions;
+    conns[0].stride = 1;
+    double start = now_seconds();
+    if (run_phase(conns, 1, cfg, 1, &created) != 0) {
+        goto cleanup;
+    }
+    double create_elapsed = now_seconds() - start;
+
+    LoadResults comms = { 0, 0, 0 };
+    for (int i = 0; i < cfg->connections; i++) {
+        conns[i].to_send = cfg->requests / cfg->connections + (i < cfg->requests % cfg->connections);
+        conns[i].next_index = i;
+        conns[i].stride = cfg->connections;
+        conns[i].sent = 0;
+        conns[i].answered = 0;
+    }
+    start = now_seconds();
+    if (run_phase(conns, cfg->connections, cfg, 0, &comms) != 0) {
+        goto cleanup;
+    }
+    double elapsed = now_seconds() - start;
+
+    printf("LOADGEN: created %ld missions in %.3f s (%ld rejected)\n",
+           created.ok, create_elapsed, created.rejected + created.malformed);
+    printf("LOADGEN: %ld add-comm requests over %d connections, window %ld\n",
+           cfg->requests, cfg->connections, cfg->window);
+    printf("  OK: %ld  Rejected: %ld  Malformed: %ld\n", comms.ok, comms.rejected, comms.malformed);
+    printf("  Elapsed: %.3f s  Throughput: %.0f msgs/sec\n",
+           elapsed, elapsed > 0 ? (double)cfg->requests / elapsed : 0.0);
+    result = 0;
+
+    if (cfg->shutdown) {
+        char reply[2];
+        if (write(conns[0].fd, "X\n", 2) != 2 || read(conns[0].fd, reply, sizeof(reply)) <= 0) {
+            result = -1;
+        }
+    }
+
+cleanup:
+    for (int i = 0; i < opened; i++) {
+        close(conns[i].fd);
+    }
+    free(conns);
+    return result;
+}
+
+/* ========================================
+ * MAIN FUNCTION
+ * ======================================== */
+static void usage(const char* prog) {
+    fprintf(stderr, "Usage: %s [-s path | -p port] [-c connections] [-n requests] "
+                    "[-m missions] [-w window] [-x]\n", prog);
+}
+
+int main(int argc, char* argv[]) {
+    LoadConfig cfg = {
+        .socket_path = "/tmp/space_mission.sock",
+        .port = 0,
+        .connections = 4,
+        .requests = 1000000,
+        .missions = 1000,
+        .window = 1024,
+        .shutdown = 0,
+    };
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-x") == 0) {
+            cfg.shutdown = 1;
+            continue;
+        }
+        if (argv[i][0] != '-' || argv[i][1] == '\0' || argv[i][2] != '\0' || i + 1 >= argc) {
+            usage(argv[0]);
+            return 1;
+        }
+        const char* value = argv[++i];
+        switch (argv[i - 1][1]) {
+            case 's': cfg.socket_path = value; break;
+            case 'p': cfg.port = atoi(value); break;
+            case 'c': cfg.connections = atoi(value); break;
+            case 'n': cfg.requests = atol(value); break;
+            case 'm': cfg.missions = atol(value); break;
+            case 'w': cfg.window = atol(value); break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (cfg.connections < 1 || cfg.connections > LOADGEN_MAX_CONNECTIONS || cfg.requests < 0 ||
+        cfg.missions < 1 || cfg.window < 1 || cfg.port < 0 || cfg.port > 65535) {
+        usage(argv[0]);
+        return 1;
+    }
+    return run_load(&cfg) == 0 ? 0 : 1;
+}
@@ -0,0 +1,384 @@
+/**
+ * @file launch_index.c
+ * @brief Space Mission Control System - Ordered Launch-Date Index
+ *
+ * Missions keyed by (launch_day, mission_id) in a large sorted array plus
+ * a small sorted insertion buffer. New keys go into the buffer with a
+ * binary search and a short memmove; when the buffer reaches about
+ * sqrt(N) entries it is merged into the main array in one linear pass.
+ * Queries binary-search both arrays and merge the two runs, so they cost
+ * O(log N + output) however large the catalog grows.
+ *
+ * Removed missions are deleted from the buffer outright but only marked
+ * in the main run; the marked keys are dropped in one linear pass once
+ * they make up a quarter of it.
+ */
+
+#include "mission_internal.h"
+
+#include <limits.h>
+
+#define LAUNCH_BUFFER_MIN 64
+
+typedef struct {
+    int launch_day;
+    int mission_id;
+    int removed;                // Tombstone, skipped by queries
+} LaunchKey;
+
+struct LaunchIndex {
+    LaunchKey *keys;            // Main sorted run
+    int count;
+    int removed_count;          // Tombstones in the main run
+    int capacity;
+    LaunchKey *buffer;          // Sorted insertion buffer
+    int buffer_count;
+    int buffer_capacity;        // Flush threshold, about sqrt(count)
+};
+
+/* ========================================
+ * KEY ORDERING
+ * ======================================== */
+static int key_less(LaunchKey a, LaunchKey b) {
+    return a.launch_day < b.launch_day ||
+           (a.launch_day == b.launch_day && a.mission_id < b.mission_id);
+}
+
+static int compare_keys(const void* a, const void* b) {
+    LaunchKey ka = *(const LaunchKey*)a;
+    LaunchKey kb = *(const LaunchKey*)b;
+    return key_less(ka, kb) ? -1 : (key_less(kb, ka) ? 1 : 0);
+}
+
+// First index in keys[0, count) not less than `key`
+static int lower_bound(const LaunchKey* keys, int count, LaunchKey key) {
+    int lo = 0;
+    int hi = count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (key_less(keys[mid], key)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// Launch dates were validated when the mission was created
+static LaunchKey mission_key(const MissionControl* system, int position) {
+    LaunchKey key = { 0, system->missions[position].mission_id, 0 };
+    parse_date_to_epoch_day(MISSION_COLD(system, position)->launch_date, &key.launch_day);
+    return key;
+}
+
+/* ========================================
+ * MERGING
+ * ======================================== */
+static int buffer_limit(int count) {
+    int limit = LAUNCH_BUFFER_MIN;
+    while ((long)limit * limit < count) {
+        limit *= 2;
+    }
+    return limit;
+}
+
+// Merge sorted[0, n) into the main run, back to front in place
+static int merge_into_main(LaunchIndex* index, const LaunchKey* sorted, int n) {
+    if (index->count + n > index->capacity) {
+        int new_capacity = index->capacity > 0 ? index->capacity : 64;
+        while (new_capacity < index->count + n) {
+            new_capacity *= 2;
+        }
+        LaunchKey *grown = realloc(index->keys, new_capacity * sizeof(LaunchKey));
+        if (grown == NULL) {
+            return -1;
+        }
+        index->keys = grown;
+        index->capacity = new_capacity;
+    }
+
+    int i = index->count - 1;
+    int j = n - 1;
+    for (int out = index->count + n - 1; j >= 0; out--) {
+        if (i >= 0 && key_less(sorted[j], index->keys[i])) {
+            index->keys[out] = index->keys[i--];
+        } else {
+            index->keys[out] = sorted[j--];
+        }
+    }
+    index->count += n;
+    return 0;
+}
+
+static int flush_buffer(LaunchIndex* index) {
+    if (merge_into_main(index, index->buffer, index->buffer_count) != 0) {
+        return -1;
+    }
+    index->buffer_count = 0;
+
+    int limit = buffer_limit(index->count);
+    if (limit > index->buffer_capacity) {
+        LaunchKey *grown = realloc(index->buffer, limit * sizeof(LaunchKey));
+        if (grown == NULL) {
+            return -1;
+        }
+        index->buffer = grown;
+        index->buffer_capacity = limit;
+    }
+    return 0;
+}
+
+static int insert_key(LaunchIndex* index, LaunchKey key) {
+    if (index->buffer_count >= index->buffer_capacity && flush_buffer(index) != 0) {
+        return -1;
+    }
+    int at = lower_bound(index->buffer, index->buffer_count, key);
+    memmove(&index->buffer[at + 1], &index->buffer[at],
+            (index->buffer_count - at) * sizeof(LaunchKey));
+    index->buffer[at] = key;
+    index->buffer_count++;
+    return 0;
+}
+
+// Drop the tombstones from the main run in one pass
+static void purge_removed_keys(LaunchIndex* index) {
+    int kept = 0;
+    for (int i = 0; i < index->count; i++) {
+        if (!index->keys[i].removed) {
+            index->keys[kept++] = index->keys[i];
+        }
+    }
+    index->count = kept;
+    index->removed_count = 0;
+}
+
+/* ========================================
+ * MAINTENANCE HOOKS
+ * ======================================== */
+int launch_index_add_missions(MissionControl* system, int first, int count) {
+    LaunchIndex *index = MISSION_SYSTEM(system)->launch_index;
+    int result = 0;
+
+    if (count <= index->buffer_capacity - index->buffer_count) {
+        for (int i = 0; i < count && result == 0; i++) {
+            result = insert_key(index, mission_key(system, first + i));
+        }
+    } else {
+        // Large batches: sort once and merge straight into the main run
+        LaunchKey *batch = malloc((size_t)count * sizeof(LaunchKey));
+        if (batch == NULL) {
+            result = -1;
+        } else {
+            for (int i = 0; i < count; i++) {
+                batch[i] = mission_key(system, first + i);
+            }
+            qsort(batch, (size_t)count, sizeof(LaunchKey), compare_keys);
+            result = merge_into_main(index, batch, count);
+            if (result == 0) {
+                result = flush_buffer(index);
+            }
+            free(batch);
+        }
+    }
+
+    if (result != 0) {
+        // Queries fall back to scanning, so losing the index is not fatal
+        launch_index_free(system);
+    }
+    return result;
+}
+
+void launch_index_remove(MissionControl* system, int position) {
+    LaunchIndex *index = MISSION_SYSTEM(system)->launch_index;
+    LaunchKey key = mission_key(system, position);
+
+    int at = lower_bound(index->buffer, index->buffer_count, key);
+    if (at < index->buffer_count && !key_less(key, index->buffer[at])) {
+        memmove(&index->buffer[at], &index->buffer[at + 1],
+                (index->buffer_count - at - 1) * sizeof(LaunchKey));
+        index->buffer_count--;
+        return;
+    }
+
+    // A tombstone of an earlier mission with the same ID may sort first
+    at = lower_bound(index->keys, index->count, key);
+    while (at < index->count && !key_less(key, index->keys[at]) && index->keys[at].removed) {
+        at++;
+    }
+    if (at < index->count && !key_less(key, index->keys[at])) {
+        index->keys[at].removed = 1;
+        index->removed_count++;
+        if (index->removed_count * 4 > index->count) {
+            purge_removed_keys(index);
+        }
+    }
+}
+
+void launch_index_memory(const MissionControl* system, MemoryFigure* figure) {
+    const LaunchIndex *index = MISSION_SYSTEM(system)->launch_index;
+    if (index == NULL) {
+        return;
+    }
+    figure->used += sizeof(LaunchIndex) +
+                    (size_t)(index->count - index->removed_count + index->buffer_count) *
+                    sizeof(LaunchKey);
+    figure->reserved += sizeof(LaunchIndex) +
+                        (size_t)(index->capacity + index->buffer_capacity) * sizeof(LaunchKey);
+}
+
+int launch_index_shrink(MissionControl* system) {
+    LaunchIndex *index = MISSION_SYSTEM(system)->launch_index;
+    if (index == NULL) {
+        return 0;
+    }
+    purge_removed_keys(index);
+    if (index->count == 0 || index->count >= index->capacity) {
+        return 0;
+    }
+    LaunchKey *shrunk = realloc(index->keys, index->count * sizeof(LaunchKey));
+    if (shrunk == NULL) {
+        return -1;
+    }
+    index->keys = shrunk;
+    index->capacity = index->count;
+    return 0;
+}
+
+void launch_index_free(MissionControl* system) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    LaunchIndex *index = sys->launch_index;
+    if (index == NULL) {
+        return;
+    }
+    free(index->keys);
+    free(index->buffer);
+    free(index);
+    sys->launch_index = NULL;
+}
+
+/* ========================================
+ * PUBLIC API
+ * ======================================== */
+int enable_launch_index(MissionControl* system) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    if (system == NULL) {
+        return -1;
+    }
+    if (sys->launch_index != NULL) {
+        return 0;
+    }
+    sys->launch_index = calloc(1, sizeof(LaunchIndex));
+    if (sys->launch_index == NULL) {
+        return -1;
+    }
+    if (flush_buffer(sys->launch_index) != 0 ||
+        (system->mission_count > 0 &&
+         launch_index_add_missions(system, 0, system->mission_count) != 0)) {
+        launch_index_free(system);
+        return -1;
+    }
+    return 0;
+}
+
+void disable_launch_index(MissionControl* system) {
+    if (system != NULL) {
+        launch_index_free(system);
+    }
+}
+
+// Walk both sorted runs from `from` while keys stay <= `to`
+static int collect_from_index(const LaunchIndex* index, LaunchKey from, LaunchKey to,
+                              int* mission_ids, int max_ids) {
+    int i = lower_bound(index->keys, index->count, from);
+    int j = lower_bound(index->buffer, index->buffer_count, from);
+    int written = 0;
+    while (written < max_ids) {
+        const LaunchKey *next;
+        if (i < index->count &&
+            (j >= index->buffer_count || key_less(index->keys[i], index->buffer[j]))) {
+            next = &index->keys[i++];
+        } else if (j < index->buffer_count) {
+            next = &index->buffer[j++];
+        } else {
+            break;
+        }
+        if (key_less(to, *next)) {
+            break;
+        }
+        if (!next->removed) {
+            mission_ids[written++] = next->mission_id;
+        }
+    }
+    return written;
+}
+
+// Fallback without an index: gather the matches and sort them
+static int collect_from_scan(const MissionControl* system, LaunchKey from, LaunchKey to,
+                             int* mission_ids, int max_ids) {
+    int matches = 0;
+    for (int pos = 0; pos < system->mission_count; pos++) {
+        LaunchKey key = mission_key(system, pos);
+        if (!key_less(key, from) && !key_less(to, key)) {
+            matches++;
+        }
+    }
+    if (matches == 0) {
+        return 0;
+    }
+
+    LaunchKey *found = malloc((size_t)matches * sizeof(LaunchKey));
+    if (found == NULL) {
+        return -1;
+    }
+    int n = 0;
+    for (int pos = 0; pos < system->mission_count; pos++) {
+        LaunchKey key = mission_key(system, pos);
+        if (!key_less(key, from) && !key_less(to, key)) {
+            found[n++] = key;
+        }
+    }
+    qsort(found, (size_t)n, sizeof(LaunchKey), compare_keys);
+
+    int written = n < max_ids ? n : max_ids;
+    for (int k = 0; k < written; k++) {
+        mission_ids[k] = found[k].mission_id;
+    }
+    free(found);
+    return written;
+}
+
+static int collect_launches(const MissionControl* system, LaunchKey from, LaunchKey to,
+                            int* mission_ids, int max_ids) {
+    const MissionSystem *sys = MISSION_SYSTEM(system);
+    if (max_ids == 0) {
+        return 0;
+    }
+    if (sys->launch_index != NULL) {
+        return collect_from_index(sys->launch_index, from, to, mission_ids, max_ids);
+    }
+    return collect_from_scan(system, from, to, mission_ids, max_ids);
+}
+
+int find_missions_by_launch_date(const MissionControl* system, const char* from_date,
+                                 const char* to_date, int* mission_ids, int max_ids) {
+    LaunchKey from = { 0, INT_MIN, 0 };
+    LaunchKey to = { 0, INT_MAX, 0 };
+    if (system == NULL || mission_ids == NULL || max_ids < 0 ||
+        !parse_date_to_epoch_day(from_date, &from.launch_day) ||
+        !parse_date_to_epoch_day(to_date, &to.launch_day)) {
+        return -1;
+    }
+    return collect_launches(system, from, to, mission_ids, max_ids);
+}
+
+int get_upcoming_launches(const MissionControl* system, const char* from_date, int count,
+                          int* mission_ids) {
+    LaunchKey from = { 0, INT_MIN, 0 };
+    LaunchKey to = { INT_MAX, INT_MAX, 0 };
+    if (system == NULL || mission_ids == NULL || count < 0 ||
+        !parse_date_to_epoch_day(from_date, &from.launch_day)) {
+        return -1;
+    }
+    return collect_launches(system, from, to, mission_ids, count);
+}
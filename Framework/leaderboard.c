@@ -0,0 +1,443 @@
+/**
+ * @file leaderboard.c
+ * @brief Space Mission Control System - Top-K Mission Leaderboards
+ *
+ * One indexed binary max-heap of mission positions per LeaderboardMetric,
+ * ordered by the mission's count (ties broken by lower mission ID). The
+ * board keeps those counts itself, by position, and the append, ack and
+ * purge hooks pass it the change. Every mission is in every heap and
+ * slot[] maps a position back to its heap slot, so a count change is a
+ * single O(log N) sift. A top-K query walks the heap best-first with a
+ * small candidate heap: O(K log K). Without a board, a query counts every
+ * mission's logs first.
+ */
+
+#include "mission_internal.h"
+
+struct MissionLeaderboard {
+    int *heap[LEADERBOARD_METRIC_COUNT];    // Mission positions, best at [0]
+    int *slot[LEADERBOARD_METRIC_COUNT];    // Mission position -> heap slot
+    int *count[LEADERBOARD_METRIC_COUNT];   // Mission position -> metric count
+    int size;                               // Missions in each heap
+    int capacity;                           // Allocated entries per array
+};
+
+/* ========================================
+ * ORDERING
+ * ======================================== */
+// Count the logs of the mission at `position` for every metric
+static void mission_counts(const MissionControl* system, int position,
+                           int counts[LEADERBOARD_METRIC_COUNT]) {
+    const Mission *mission = &system->missions[position];
+    MissionLogCounts logs;
+    count_mission_logs(mission->communications, mission->comm_count, &logs);
+    counts[LEADERBOARD_EMERGENCY] = logs.priority_counts[EMERGENCY];
+    counts[LEADERBOARD_TOTAL_COMMS] = mission->comm_count;
+    counts[LEADERBOARD_UNACKNOWLEDGED] = logs.unacked_count;
+}
+
+// Does the mission at position a rank above the one at position b?
+// `counts` maps positions to the metric's counts.
+static int ranks_before(const MissionControl* system, const int* counts, int a, int b) {
+    return counts[a] > counts[b] ||
+           (counts[a] == counts[b] &&
+            system->missions[a].mission_id < system->missions[b].mission_id);
+}
+
+/* ========================================
+ * INDEXED HEAP
+ * ======================================== */
+static void heap_place(MissionLeaderboard* board, LeaderboardMetric metric, int slot, int position) {
+    board->heap[metric][slot] = position;
+    board->slot[metric][position] = slot;
+}
+
+static void sift_up(const MissionControl* system, LeaderboardMetric metric, int slot) {
+    MissionLeaderboard *board = MISSION_SYSTEM(system)->leaderboard;
+    const int *counts = board->count[metric];
+    int position = board->heap[metric][slot];
+    while (slot > 0) {
+        int parent = (slot - 1) / 2;
+        if (!ranks_before(system, counts, position, board->heap[metric][parent])) {
+            break;
+        }
+        heap_place(board, metric, slot, board->heap[metric][parent]);
+        slot = parent;
+    }
+    heap_place(board, metric, slot, position);
+}
+
+static void sift_down(const MissionControl* system, LeaderboardMetric metric, int slot) {
+    MissionLeaderboard *board = MISSION_SYSTEM(system)->leaderboard;
+    const int *counts = board->count[metric];
+    int position = board->heap[metric][slot];
+    for (;;) {
+        int best = slot * 2 + 1;
+        if (best >= board->size) {
+            break;
+        }
+        if (best + 1 < board->size &&
+            ranks_before(system, counts, board->heap[metric][best + 1], board->heap[metric][best])) {
+            best++;
+        }
+        if (!ranks_before(system, counts, board->heap[metric][best], position)) {
+            break;
+        }
+        heap_place(board, metric, slot, board->heap[metric][best]);
+        slot = best;
+    }
+    heap_place(board, metric, slot, position);
+}
+
+static int resize_board(MissionLeaderboard* board, int new_capacity) {
+    for (int metric = 0; metric < LEADERBOARD_METRIC_COUNT; metric++) {
+        int *heap = realloc(board->heap[metric], new_capacity * sizeof(int));
+        if (heap == NULL) {
+            return -1;
+        }
+        board->heap[metric] = heap;
+        int *slot = realloc(board->slot[metric], new_capacity * sizeof(int));
+        if (slot == NULL) {
+            return -1;
+        }
+        board->slot[metric] = slot;
+        int *count = realloc(board->count[metric], new_capacity * sizeof(int));
+        if (count == NULL) {
+            return -1;
+        }
+        board->count[metric] = count;
+    }
+    board->capacity = new_capacity;
+    return 0;
+}
+
+static int reserve_board(MissionLeaderboard* board, int capacity) {
+    if (capacity <= board->capacity) {
+        return 0;
+    }
+    int new_capacity = board->capacity > 0 ? board->capacity : 16;
+    while (new_capacity < capacity) {
+        new_capacity *= 2;
+    }
+    return resize_board(board, new_capacity);
+}
+
+// Count the logs of the mission at `position` into the board
+static void set_counts(const MissionControl* system, MissionLeaderboard* board, int position) {
+    int counts[LEADERBOARD_METRIC_COUNT];
+    mission_counts(system, position, counts);
+    for (int metric = 0; metric < LEADERBOARD_METRIC_COUNT; metric++) {
+        board->count[metric][position] = counts[metric];
+    }
+}
+
+/* ========================================
+ * MAINTENANCE HOOKS
+ * ======================================== */
+int leaderboard_add_missions(MissionControl* system, int first, int count) {
+    MissionLeaderboard *board = MISSION_SYSTEM(system)->leaderboard;
+    if (reserve_board(board, board->size + count) != 0) {
+        // Queries fall back to scanning, so losing the heaps is not fatal
+        leaderboard_free(system);
+        return -1;
+    }
+    for (int i = 0; i < count; i++) {
+        int slot = board->size++;
+        set_counts(system, board, first + i);
+        for (int metric = 0; metric < LEADERBOARD_METRIC_COUNT; metric++) {
+            heap_place(board, (LeaderboardMetric)metric, slot, first + i);
+            sift_up(system, (LeaderboardMetric)metric, slot);
+        }
+    }
+    return 0;
+}
+
+void leaderboard_update(MissionControl* system, int position, const MissionLogCounts* delta) {
+    MissionLeaderboard *board = MISSION_SYSTEM(system)->leaderboard;
+    board->count[LEADERBOARD_EMERGENCY][position] += delta->priority_counts[EMERGENCY];
+    board->count[LEADERBOARD_TOTAL_COMMS][position] = system->missions[position].comm_count;
+    board->count[LEADERBOARD_UNACKNOWLEDGED][position] += delta->unacked_count;
+    for (int metric = 0; metric < LEADERBOARD_METRIC_COUNT; metric++) {
+        int slot = board->slot[metric][position];
+        sift_up(system, (LeaderboardMetric)metric, slot);
+        sift_down(system, (LeaderboardMetric)metric, board->slot[metric][position]);
+    }
+}
+
+void leaderboard_remove_mission(MissionControl* system, int position) {
+    MissionLeaderboard *board = MISSION_SYSTEM(system)->leaderboard;
+    int last = system->mission_count - 1;
+    board->size--;
+    for (int metric = 0; metric < LEADERBOARD_METRIC_COUNT; metric++) {
+        // Fill the hole with the heap's last entry and restore its order
+        int slot = board->slot[metric][position];
+        if (slot < board->size) {
+            int filler = board->heap[metric][board->size];
+            heap_place(board, (LeaderboardMetric)metric, slot, filler);
+            sift_up(system, (LeaderboardMetric)metric, slot);
+            sift_down(system, (LeaderboardMetric)metric, board->slot[metric][filler]);
+        }
+        // The last mission is about to move into the freed position
+        if (last != position) {
+            heap_place(board, (LeaderboardMetric)metric, board->slot[metric][last], position);
+            board->count[metric][position] = board->count[metric][last];
+        }
+    }
+}
+
+void leaderboard_memory(const MissionControl* system, MemoryFigure* figure) {
+    const MissionLeaderboard *board = MISSION_SYSTEM(system)->leaderboard;
+    if (board == NULL) {
+        return;
+    }
+    size_t per_entry = 3 * LEADERBOARD_METRIC_COUNT * sizeof(int);
+    figure->used += sizeof(MissionLeaderboard) + (size_t)board->size * per_entry;
+    figure->reserved += sizeof(MissionLeaderboard) + (size_t)board->capacity * per_entry;
+}
+
+int leaderboard_shrink(MissionControl* system) {
+    MissionLeaderboard *board = MISSION_SYSTEM(system)->leaderboard;
+    if (board == NULL || board->size >= board->capacity || board->size == 0) {
+        return 0;
+    }
+    if (resize_board(board, board->size) != 0) {
+        // Some heaps may already be smaller than board->capacity says
+        leaderboard_free(system);
+        return -1;
+    }
+    return 0;
+}
+
+void leaderboard_free(MissionControl* system) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    MissionLeaderboard *board = sys->leaderboard;
+    if (board == NULL) {
+        return;
+    }
+    for (int metric = 0; metric < LEADERBOARD_METRIC_COUNT; metric++) {
+        free(board->heap[metric]);
+        free(board->slot[metric]);
+        free(board->count[metric]);
+    }
+    free(board);
+    sys->leaderboard = NULL;
+}
+
+/* ========================================
+ * PUBLIC API
+ * ======================================== */
+int enable_mission_leaderboard(MissionControl* system) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    if (system == NULL) {
+        return -1;
+    }
+    if (sys->leaderboard != NULL) {
+        return 0;
+    }
+    sys->leaderboard = calloc(1, sizeof(MissionLeaderboard));
+    if (sys->leaderboard == NULL) {
+        return -1;
+    }
+    if (reserve_board(sys->leaderboard, system->mission_count) != 0) {
+        leaderboard_free(system);
+        return -1;
+    }
+
+    // Bottom-up heapify of the existing missions: O(N) after counting their logs
+    MissionLeaderboard *board = sys->leaderboard;
+    board->size = system->mission_count;
+    for (int pos = 0; pos < board->size; pos++) {
+        set_counts(system, board, pos);
+    }
+    for (int metric = 0; metric < LEADERBOARD_METRIC_COUNT; metric++) {
+        for (int pos = 0; pos < board->size; pos++) {
+            heap_place(board, (LeaderboardMetric)metric, pos, pos);
+        }
+        for (int slot = board->size / 2 - 1; slot >= 0; slot--) {
+            sift_down(system, (LeaderboardMetric)metric, slot);
+        }
+    }
+    return 0;
+}
+
+void disable_mission_leaderboard(MissionControl* system) {
+    if (system != NULL) {
+        leaderboard_free(system);
+    }
+}
+
+/*
+ * Best-first walk of the maintained heap. The frontier of heap slots whose
+ * parents were already emitted is itself kept as a small max-heap, so each
+ * of the K steps costs O(log K).
+ */
+static void frontier_sift(const MissionControl* system, LeaderboardMetric metric,
+                          int* frontier, int count, int slot) {
+    const int *heap = MISSION_SYSTEM(system)->leaderboard->heap[metric];
+    const int *counts = MISSION_SYSTEM(system)->leaderboard->count[metric];
+    int entry = frontier[slot];
+    for (;;) {
+        int best = slot * 2 + 1;
+        if (best >= count) {
+            break;
+        }
+        if (best + 1 < count &&
+            ranks_before(system, counts, heap[frontier[best + 1]], heap[frontier[best]])) {
+            best++;
+        }
+        if (!ranks_before(system, counts, heap[frontier[best]], heap[entry])) {
+            break;
+        }
+        frontier[slot] = frontier[best];
+        slot = best;
+    }
+    frontier[slot] = entry;
+}
+
+static void frontier_push(const MissionControl* system, LeaderboardMetric metric,
+                          int* frontier, int* count, int heap_slot) {
+    const int *heap = MISSION_SYSTEM(system)->leaderboard->heap[metric];
+    const int *counts = MISSION_SYSTEM(system)->leaderboard->count[metric];
+    int slot = (*count)++;
+    while (slot > 0 &&
+           ranks_before(system, counts, heap[heap_slot], heap[frontier[(slot - 1) / 2]])) {
+        frontier[slot] = frontier[(slot - 1) / 2];
+        slot = (slot - 1) / 2;
+    }
+    frontier[slot] = heap_slot;
+}
+
+static int top_from_heap(const MissionControl* system, LeaderboardMetric metric, int k,
+                         LeaderboardEntry* out) {
+    const MissionLeaderboard *board = MISSION_SYSTEM(system)->leaderboard;
+    // Each step removes one frontier entry and adds at most two
+    int *frontier = malloc((size_t)(k + 1) * sizeof(int));
+    if (frontier == NULL) {
+        return -1;
+    }
+
+    int frontier_count = 1;
+    frontier[0] = 0;
+    int written = 0;
+    while (written < k && frontier_count > 0) {
+        int slot = frontier[0];
+        int position = board->heap[metric][slot];
+        out[written].mission_id = system->missions[position].mission_id;
+        out[written].count = board->count[metric][position];
+        written++;
+
+        frontier[0] = frontier[--frontier_count];
+        if (frontier_count > 0) {
+            frontier_sift(system, metric, frontier, frontier_count, 0);
+        }
+        for (int child = slot * 2 + 1; child <= slot * 2 + 2 && child < board->size; child++) {
+            frontier_push(system, metric, frontier, &frontier_count, child);
+        }
+    }
+    free(frontier);
+    return written;
+}
+
+// Fallback without a leaderboard: count every mission, then keep the best
+// k in a worst-at-root heap
+static int top_from_scan(const MissionControl* system, LeaderboardMetric metric, int k,
+                         LeaderboardEntry* out) {
+    int *kept = malloc((size_t)k * sizeof(int));
+    int *counts = malloc((size_t)system->mission_count * sizeof(int));
+    if (kept == NULL || counts == NULL) {
+        free(kept);
+        free(counts);
+        return -1;
+    }
+    for (int pos = 0; pos < system->mission_count; pos++) {
+        if (metric == LEADERBOARD_TOTAL_COMMS) {
+            counts[pos] = system->missions[pos].comm_count;
+            continue;
+        }
+        int mission[LEADERBOARD_METRIC_COUNT];
+        mission_counts(system, pos, mission);
+        counts[pos] = mission[metric];
+    }
+
+    int kept_count = 0;
+    for (int pos = 0; pos < system->mission_count; pos++) {
+        int slot;
+        if (kept_count < k) {
+            slot = kept_count++;
+            for (; slot > 0 && ranks_before(system, counts, kept[(slot - 1) / 2], pos);
+                 slot = (slot - 1) / 2) {
+                kept[slot] = kept[(slot - 1) / 2];
+            }
+            kept[slot] = pos;
+            continue;
+        }
+        if (!ranks_before(system, counts, pos, kept[0])) {
+            continue;
+        }
+        // Replace the worst kept mission and sift it down
+        slot = 0;
+        for (;;) {
+            int worst = slot * 2 + 1;
+            if (worst >= kept_count) {
+                break;
+            }
+            if (worst + 1 < kept_count && ranks_before(system, counts, kept[worst], kept[worst + 1])) {
+                worst++;
+            }
+            if (!ranks_before(system, counts, pos, kept[worst])) {
+                break;
+            }
+            kept[slot] = kept[worst];
+            slot = worst;
+        }
+        kept[slot] = pos;
+    }
+
+    // Pop worst-first into the tail of `out`
+    int written = kept_count;
+    while (kept_count > 0) {
+        int worst = kept[0];
+        out[kept_count - 1].mission_id = system->missions[worst].mission_id;
+        out[kept_count - 1].count = counts[worst];
+        int last = kept[--kept_count];
+        int slot = 0;
+        for (;;) {
+            int child = slot * 2 + 1;
+            if (child >= kept_count) {
+                break;
+            }
+            if (child + 1 < kept_count && ranks_before(system, counts, kept[child], kept[child + 1])) {
+                child++;
+            }
+            if (!ranks_before(system, counts, last, kept[child])) {
+                break;
+            }
+            kept[slot] = kept[child];
+            slot = child;
+        }
+        if (kept_count > 0) {
+            kept[slot] = last;
+        }
+    }
+    free(kept);
+    free(counts);
+    return written;
+}
+
+int get_top_missions(const MissionControl* system, LeaderboardMetric metric, int k,
+                     LeaderboardEntry* out) {
+    if (system == NULL || out == NULL || k < 0 ||
+        metric < 0 || metric >= LEADERBOARD_METRIC_COUNT) {
+        return -1;
+    }
+    if (k > system->mission_count) {
+        k = system->mission_count;
+    }
+    if (k == 0) {
+        return 0;
+    }
+    if (MISSION_SYSTEM(system)->leaderboard != NULL) {
+        return top_from_heap(system, metric, k, out);
+    }
+    return top_from_scan(system, metric, k, out);
+}
@@ -0,0 +1,327 @@
+/**
+ * @file log_directory.c
+ * @brief Space Mission Control System - Log ID Directory
+ *
+ * Log IDs are drawn from one sequence per system, so they are unique
+ * across missions and increase in commit order. Because the sequence is
+ * dense, the directory needs no hashing: the entry for the log with
+ * sequence number (log_id - first_log_id) / log_id_stride sits at that
+ * number minus the window's base. It records the owning mission and the
+ * log's append ordinal within it. Purges only ever remove logs, so the
+ * newest logs after the last purged range are exactly as far from the end
+ * of the array as from the mission's append count, and a lookup lands on
+ * its log in O(1). A log in front of a middle purge falls back to the
+ * per-mission binary search.
+ *
+ * Purges and mission removals drop their logs' entries, leaving holes in
+ * the window. Once the holes outnumber the live entries, compaction (or
+ * the next growth) rebuilds the directory: the window is cut to its
+ * longest suffix that is at least half live, and the live entries before
+ * it move to a sorted sparse array that lookups binary-search. The
+ * directory therefore stays proportional to the logs still stored, not to
+ * every log ever committed.
+ *
+ * Sharded front-ends interleave their shards' sequences with a stride (see
+ * set_log_id_sequence()), so IDs stay unique across shards without a
+ * counter every shard would have to write.
+ */
+
+#include "mission_internal.h"
+
+#include <limits.h>
+
+#define LOG_DIRECTORY_MIN_CAPACITY 64
+
+struct LogDirectoryEntry {
+    int mission_id;         // Owning mission when the log was committed, 0 once dropped
+    int ordinal;            // Logs the mission had committed before it
+};
+
+typedef struct {
+    int sequence;           // Position of the log in the ID sequence
+    LogDirectoryEntry entry;
+} SparseEntry;
+
+struct LogDirectory {
+    LogDirectoryEntry *window;  // Sequence numbers base .. logs_committed - 1
+    int base;
+    int capacity;
+    int window_live;            // Window entries not dropped
+    SparseEntry *sparse;        // Live entries before base at the last rebuild, in order
+    int sparse_count;
+    int sparse_capacity;
+    int sparse_live;            // Sparse entries not dropped since
+};
+
+static int sequence_of(const MissionSystem* sys, int log_id) {
+    long offset = (long)log_id - sys->first_log_id;
+    if (offset < 0 || offset % sys->log_id_stride != 0 ||
+        offset / sys->log_id_stride >= sys->logs_committed) {
+        return -1;
+    }
+    return (int)(offset / sys->log_id_stride);
+}
+
+// The entry for `sequence` (which must have been committed), or NULL if it was dropped
+static LogDirectoryEntry* entry_of(const LogDirectory* directory, int sequence) {
+    LogDirectoryEntry *entry = NULL;
+    if (sequence >= directory->base) {
+        entry = &directory->window[sequence - directory->base];
+    } else {
+        int low = 0;
+        int high = directory->sparse_count;
+        while (low < high) {
+            int mid = low + (high - low) / 2;
+            if (directory->sparse[mid].sequence < sequence) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        if (low < directory->sparse_count && directory->sparse[low].sequence == sequence) {
+            entry = &directory->sparse[low].entry;
+        }
+    }
+    return entry != NULL && entry->mission_id != 0 ? entry : NULL;
+}
+
+static int dropped_entries(const LogDirectory* directory, int window_used) {
+    return window_used - directory->window_live +
+           directory->sparse_count - directory->sparse_live;
+}
+
+/* ========================================
+ * REBUILD
+ * ======================================== */
+static int resize_window(LogDirectory* directory, int capacity) {
+    LogDirectoryEntry *resized = realloc(directory->window,
+                                         (size_t)capacity * sizeof(LogDirectoryEntry));
+    if (resized == NULL) {
+        return -1;
+    }
+    directory->window = resized;
+    directory->capacity = capacity;
+    return 0;
+}
+
+static int resize_sparse(LogDirectory* directory, int capacity) {
+    if (capacity == 0) {
+        free(directory->sparse);
+        directory->sparse = NULL;
+        directory->sparse_capacity = 0;
+        return 0;
+    }
+    SparseEntry *resized = realloc(directory->sparse, (size_t)capacity * sizeof(SparseEntry));
+    if (resized == NULL) {
+        return -1;
+    }
+    directory->sparse = resized;
+    directory->sparse_capacity = capacity;
+    return 0;
+}
+
+/*
+ * Drop the holes: keep the longest window suffix that is at least half
+ * live, and move the live entries before it to the sparse array. With
+ * `exact`, both arrays are then reallocated to their used size; otherwise
+ * only one that ended up more than twice too large.
+ * @return 0 on success, -1 on allocation failure (directory unchanged)
+ */
+static int rebuild(LogDirectory* directory, int window_used, int exact) {
+    int cut = window_used;
+    int live = 0;
+    for (int i = window_used - 1; i >= 0; i--) {
+        if (directory->window[i].mission_id != 0) {
+            live++;
+        }
+        if (2 * live >= window_used - i) {
+            cut = i;
+        }
+    }
+    int moved = 0;
+    for (int i = 0; i < cut; i++) {
+        moved += directory->window[i].mission_id != 0;
+    }
+    int sparse_needed = directory->sparse_live + moved;
+    if (sparse_needed > directory->sparse_capacity &&
+        resize_sparse(directory, sparse_needed) != 0) {
+        return -1;
+    }
+
+    int kept = 0;
+    for (int i = 0; i < directory->sparse_count; i++) {
+        if (directory->sparse[i].entry.mission_id != 0) {
+            directory->sparse[kept++] = directory->sparse[i];
+        }
+    }
+    for (int i = 0; i < cut; i++) {
+        if (directory->window[i].mission_id != 0) {
+            directory->sparse[kept].sequence = directory->base + i;
+            directory->sparse[kept++].entry = directory->window[i];
+        }
+    }
+    directory->sparse_count = kept;
+    directory->sparse_live = kept;
+    if (cut > 0) {
+        memmove(directory->window, directory->window + cut,
+                (size_t)(window_used - cut) * sizeof(LogDirectoryEntry));
+    }
+    directory->base += cut;
+    directory->window_live -= moved;
+
+    // Shrinking is best effort: a failed realloc leaves the larger block
+    int used = window_used - cut;
+    int fit = used > LOG_DIRECTORY_MIN_CAPACITY ? used : LOG_DIRECTORY_MIN_CAPACITY;
+    if (exact ? directory->capacity > used && used > 0 : directory->capacity > 2 * fit) {
+        resize_window(directory, exact ? used : fit);
+    }
+    if (exact ? directory->sparse_capacity > kept : directory->sparse_capacity > 2 * kept) {
+        resize_sparse(directory, kept);
+    }
+    return 0;
+}
+
+/* ========================================
+ * ID ASSIGNMENT
+ * ======================================== */
+void set_log_id_sequence(MissionControl* system, int first_log_id, int stride) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    sys->first_log_id = first_log_id;
+    sys->log_id_stride = stride;
+}
+
+int log_directory_add(MissionControl* system, int mission_id, int ordinal) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    int count = sys->logs_committed;
+    if (count > (INT_MAX - sys->first_log_id) / sys->log_id_stride) {
+        return -1;  // The next ID would overflow
+    }
+    if (sys->log_directory == NULL) {
+        sys->log_directory = calloc(1, sizeof(LogDirectory));
+        if (sys->log_directory == NULL) {
+            return -1;
+        }
+    }
+    LogDirectory *directory = sys->log_directory;
+    int used = count - directory->base;
+    if (used >= directory->capacity) {
+        // Reclaim the holes before paying for a larger window
+        if (dropped_entries(directory, used) > directory->window_live + directory->sparse_live &&
+            rebuild(directory, used, 0) == 0) {
+            used = count - directory->base;
+        }
+        if (used >= directory->capacity &&
+            resize_window(directory, directory->capacity > 0 ? directory->capacity * 2
+                                                             : LOG_DIRECTORY_MIN_CAPACITY) != 0) {
+            return -1;
+        }
+    }
+    directory->window[used].mission_id = mission_id;
+    directory->window[used].ordinal = ordinal;
+    directory->window_live++;
+    sys->logs_committed = count + 1;
+    return sys->first_log_id + count * sys->log_id_stride;
+}
+
+void log_directory_drop(MissionControl* system, const CommLog* logs, int count) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    LogDirectory *directory = sys->log_directory;
+    if (directory == NULL) {
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        int sequence = sequence_of(sys, logs[i].log_id);
+        LogDirectoryEntry *entry = sequence >= 0 ? entry_of(directory, sequence) : NULL;
+        if (entry == NULL) {
+            continue;
+        }
+        entry->mission_id = 0;
+        if (sequence >= directory->base) {
+            directory->window_live--;
+        } else {
+            directory->sparse_live--;
+        }
+    }
+}
+
+/* ========================================
+ * LOOKUP
+ * ======================================== */
+CommLog* log_directory_find(const MissionControl* system, int log_id, int* position) {
+    const MissionSystem *sys = MISSION_SYSTEM(system);
+    int sequence = sequence_of(sys, log_id);
+    if (sequence < 0) {
+        return NULL;
+    }
+    const LogDirectoryEntry *entry = entry_of(sys->log_directory, sequence);
+    if (entry == NULL) {
+        return NULL;
+    }
+    int found = mission_index_find(system, entry->mission_id);
+    if (found < 0) {
+        return NULL;
+    }
+    const Mission *mission = &system->missions[found];
+    int index = mission->comm_count -
+                (MISSION_META(system, found)->comm_appended - entry->ordinal);
+    CommLog *log;
+    if (index >= 0 && index < mission->comm_count &&
+        mission->communications[index].log_id == log_id) {
+        log = &mission->communications[index];
+    } else {
+        log = find_mission_log(mission, log_id);
+    }
+    if (log != NULL && position != NULL) {
+        *position = found;
+    }
+    return log;
+}
+
+/* ========================================
+ * STORAGE
+ * ======================================== */
+void log_directory_memory(const MissionControl* system, MemoryFigure* figure) {
+    const MissionSystem *sys = MISSION_SYSTEM(system);
+    const LogDirectory *directory = sys->log_directory;
+    if (directory == NULL) {
+        return;
+    }
+    figure->used += sizeof(LogDirectory) +
+                    (size_t)(sys->logs_committed - directory->base) * sizeof(LogDirectoryEntry) +
+                    (size_t)directory->sparse_count * sizeof(SparseEntry);
+    figure->reserved += sizeof(LogDirectory) +
+                        (size_t)directory->capacity * sizeof(LogDirectoryEntry) +
+                        (size_t)directory->sparse_capacity * sizeof(SparseEntry);
+}
+
+int log_directory_compact(MissionControl* system) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    LogDirectory *directory = sys->log_directory;
+    if (directory == NULL) {
+        return 0;
+    }
+    int used = sys->logs_committed - directory->base;
+    if (dropped_entries(directory, used) <= directory->window_live + directory->sparse_live) {
+        return 0;
+    }
+    return rebuild(directory, used, 0);
+}
+
+int log_directory_shrink(MissionControl* system) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    LogDirectory *directory = sys->log_directory;
+    if (directory == NULL) {
+        return 0;
+    }
+    return rebuild(directory, sys->logs_committed - directory->base, 1);
+}
+
+void log_directory_free(MissionControl* system) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    if (sys->log_directory != NULL) {
+        free(sys->log_directory->window);
+        free(sys->log_directory->sparse);
+        free(sys->log_directory);
+        sys->log_directory = NULL;
+    }
+}
@@ -7,6 +7,7 @@
 
 
 #include "space_mission.h"
+#include "mission_internal.h"
 
 /**
  * FUNCTION 6: free_mission_control()
@@ -31,50 +32,6 @@
  * Must free from innermost to outermost allocations
  */
 void free_mission_control(MissionControl* system) {
-    
-    // TODO: Implement free_mission_control with proper memory deallocation
-    //
-    // 1. NULL CHECK:
-    //    - Check if system is NULL
-    //    - Return gracefully if NULL (not an error)
-    //
-    // 2. FREE NESTED ARRAYS:
-    //    - Check if missions array is not NULL
-    //    - Loop through each mission in the system
-    //    - For each mission:
-    //      * Free communications array if not NULL
-    //      * Set pointer to NULL (good practice)
-    //
-    // 3. FREE MISSIONS ARRAY:
-    //    - Free the missions array itself
-    //    - Set missions pointer to NULL
-    //
-    // 4. FREE MAIN STRUCTURE:
-    //    - Free the main system structure
-    //
-    // MEMORY HIERARCHY (free in this order):
-    //   1. mission->communications (innermost)
-    //   2. system->missions (middle)
-    //   3. system (outermost)
-    
-    // Your implementation here:
-    if (system == NULL) {
-        return;
-    }
-
-    if (system->missions != NULL) {
-        for (int i = 0; i < system->mission_count; i++) {
-            
-            if (system->missions[i].communications != NULL) {
-                free(system->missions[i].communications);
-                
-                system->missions[i].communications = NULL;
-            }
-        }
-        
-        free(system->missions);
-        
-        system->missions = NULL;
-    }
-    free(system);
-}
\ No newline at end of file
+    // The missions and every side table are torn down in mission_store.c
+    mission_system_free(system);
+}
@@ -0,0 +1,257 @@
+/**
+ * @file metrics.c
+ * @brief Space Mission Control System - Hot-Path Instrumentation
+ *
+ * Call counters, log-linear latency histograms, array growth counters
+ * and lookup probe lengths. Everything except the public query functions
+ * is compiled only with -DMISSION_METRICS; without it the query functions
+ * report that metrics are unavailable.
+ *
+ * Latencies are recorded in raw ticks (TSC on x86, CLOCK_MONOTONIC ns
+ * elsewhere) to keep the per-call cost to a few ns. The tick rate is
+ * calibrated against CLOCK_MONOTONIC between attach and query time.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "metrics.h"
+#include "mission_internal.h"
+
+#include <time.h>
+
+#ifdef MISSION_METRICS
+
+/* ========================================
+ * CLOCKS
+ * ======================================== */
+static long monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long)ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+#if !(defined(__x86_64__) || defined(__i386__))
+long metrics_ticks(void) {
+    return monotonic_ns();
+}
+#endif
+
+// Calibration anchor shared by every system in the process
+static long g_anchor_ticks = 0;
+static long g_anchor_ns = 0;
+
+static double ns_per_tick(void) {
+    long elapsed_ticks = metrics_ticks() - g_anchor_ticks;
+    long elapsed_ns = monotonic_ns() - g_anchor_ns;
+    if (elapsed_ticks <= 0 || elapsed_ns <= 0) {
+        return 1.0;
+    }
+    return (double)elapsed_ns / (double)elapsed_ticks;
+}
+
+/* ========================================
+ * HISTOGRAM
+ * ======================================== */
+#define SUB_BUCKETS (1 << METRIC_HISTOGRAM_SUB_BITS)
+
+static int histogram_bucket(long value) {
+    if (value < SUB_BUCKETS) {
+        return value < 0 ? 0 : (int)value;
+    }
+    int msb = 63 - __builtin_clzl((unsigned long)value);
+    int shift = msb - METRIC_HISTOGRAM_SUB_BITS;
+    int index = (msb - METRIC_HISTOGRAM_SUB_BITS + 1) * SUB_BUCKETS
+              + (int)((value >> shift) & (SUB_BUCKETS - 1));
+    return index < METRIC_HISTOGRAM_BUCKETS ? index : METRIC_HISTOGRAM_BUCKETS - 1;
+}
+
+static void histogram_record(LatencyHistogram* h, long value) {
+    h->count++;
+    h->total_ticks += value;
+    if (value > h->max_ticks) {
+        h->max_ticks = value;
+    }
+    h->buckets[histogram_bucket(value)]++;
+}
+
+/* ========================================
+ * LIFECYCLE
+ * ======================================== */
+void metrics_attach(MissionControl* system) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    if (g_anchor_ns == 0) {
+        g_anchor_ticks = metrics_ticks();
+        g_anchor_ns = monotonic_ns();
+    }
+    sys->stats = calloc(1, sizeof(MissionControlStats));
+    sys->report_stats = 0;
+}
+
+void metrics_detach(MissionControl* system) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    free(sys->stats);
+    sys->stats = NULL;
+}
+
+/* ========================================
+ * RECORDING HOOKS
+ * ======================================== */
+void metrics_record_call(const MissionControl* system, MetricApi api, int result, long start_ticks) {
+    const MissionSystem *sys = MISSION_SYSTEM(system);
+    long elapsed = metrics_ticks() - start_ticks;
+    if (system == NULL || sys->stats == NULL) {
+        return;
+    }
+    ApiCallStats* calls = &sys->stats->api[api];
+    calls->calls++;
+    if (result == 0) {
+        calls->successes++;
+    } else {
+        calls->failures++;
+    }
+    histogram_record(&sys->stats->latency[api], elapsed);
+}
+
+void metrics_record_growth(const MissionControl* system, MetricGrowth array,
+                           const void* old_ptr, const void* new_ptr, size_t old_bytes) {
+    const MissionSystem *sys = MISSION_SYSTEM(system);
+    if (system == NULL || sys->stats == NULL) {
+        return;
+    }
+    GrowthStats* growth = &sys->stats->growth[array];
+    growth->reallocs++;
+    if (old_ptr != new_ptr) {
+        growth->bytes_copied += (long)old_bytes;
+    }
+}
+
+void metrics_record_lookup(const MissionControl* system, int probes) {
+    const MissionSystem *sys = MISSION_SYSTEM(system);
+    if (system == NULL || sys->stats == NULL) {
+        return;
+    }
+    sys->stats->lookups++;
+    sys->stats->lookup_probes += probes;
+    if (probes > sys->stats->max_lookup_probes) {
+        sys->stats->max_lookup_probes = probes;
+    }
+}
+
+/* ========================================
+ * REPORT SECTION
+ * ======================================== */
+static const char* api_name(MetricApi api) {
+    switch (api) {
+        case METRIC_API_CREATE_MISSION: return "create_mission_with_crew";
+        case METRIC_API_ADD_COMM: return "add_communication";
+        case METRIC_API_LOAD_FILE: return "load_missions_from_file";
+        case METRIC_API_SAVE_REPORT: return "save_mission_report";
+        default: return "unknown";
+    }
+}
+
+void metrics_append_to_report(const MissionControl* system, FILE* fp) {
+    MissionControlStats stats;
+    if (!MISSION_SYSTEM(system)->report_stats || get_mission_control_stats(system, &stats) != 0) {
+        return;
+    }
+
+    fprintf(fp, "PERFORMANCE METRICS:\n");
+    for (int api = 0; api < METRIC_API_COUNT; api++) {
+        const ApiCallStats* calls = &stats.api[api];
+        if (calls->calls == 0) {
+            continue;
+        }
+        fprintf(fp, "  %s: calls=%ld ok=%ld failed=%ld p50=%.0fns p99=%.0fns max=%.0fns\n",
+                api_name((MetricApi)api), calls->calls, calls->successes, calls->failures,
+                latency_histogram_percentile(&stats, (MetricApi)api, 50.0),
+                latency_histogram_percentile(&stats, (MetricApi)api, 99.0),
+                (double)stats.latency[api].max_ticks * stats.ns_per_tick);
+    }
+    fprintf(fp, "  Mission array growth: reallocs=%ld bytes_copied=%ld\n",
+            stats.growth[METRIC_GROWTH_MISSIONS].reallocs,
+            stats.growth[METRIC_GROWTH_MISSIONS].bytes_copied);
+    fprintf(fp, "  Comm array growth: reallocs=%ld bytes_copied=%ld\n",
+            stats.growth[METRIC_GROWTH_COMMS].reallocs,
+            stats.growth[METRIC_GROWTH_COMMS].bytes_copied);
+    fprintf(fp, "  Lookups: count=%ld avg_probes=%.2f max_probes=%d\n",
+            stats.lookups,
+            stats.lookups > 0 ? (double)stats.lookup_probes / (double)stats.lookups : 0.0,
+            stats.max_lookup_probes);
+    fprintf(fp, "===============================================\n");
+}
+
+#endif /* MISSION_METRICS */
+
+/* ========================================
+ * PUBLIC QUERY API
+ * ======================================== */
+int get_mission_control_stats(const MissionControl* system, MissionControlStats* out) {
+#ifdef MISSION_METRICS
+    const MissionSystem *sys = MISSION_SYSTEM(system);
+    if (system == NULL || out == NULL || sys->stats == NULL) {
+        return -1;
+    }
+    *out = *sys->stats;
+    out->ns_per_tick = ns_per_tick();
+    return 0;
+#else
+    (void)system;
+    if (out != NULL) {
+        memset(out, 0, sizeof(*out));
+    }
+    return -1;
+#endif
+}
+
+int set_mission_control_report_stats(MissionControl* system, int enabled) {
+#ifdef MISSION_METRICS
+    if (system == NULL) {
+        return -1;
+    }
+    MISSION_SYSTEM(system)->report_stats = (enabled != 0);
+    return 0;
+#else
+    (void)system;
+    (void)enabled;
+    return -1;
+#endif
+}
+
+double latency_histogram_percentile(const MissionControlStats* stats, MetricApi api,
+                                    double percentile) {
+    if (stats == NULL || api < 0 || api >= METRIC_API_COUNT) {
+        return 0.0;
+    }
+    const LatencyHistogram* h = &stats->latency[api];
+    if (h->count == 0) {
+        return 0.0;
+    }
+
+    long rank = (long)((percentile / 100.0) * (double)h->count + 0.5);
+    if (rank < 1) {
+        rank = 1;
+    }
+
+    long seen = 0;
+    for (int i = 0; i < METRIC_HISTOGRAM_BUCKETS; i++) {
+        seen += h->buckets[i];
+        if (seen >= rank) {
+            // Report the bucket's upper bound, capped by the observed max
+            long upper;
+            if (i < (1 << METRIC_HISTOGRAM_SUB_BITS)) {
+                upper = i;
+            } else {
+                int group = i >> METRIC_HISTOGRAM_SUB_BITS;
+                int sub = i & ((1 << METRIC_HISTOGRAM_SUB_BITS) - 1);
+                int shift = group - 1;
+                upper = ((long)((1 << METRIC_HISTOGRAM_SUB_BITS) + sub + 1) << shift) - 1;
+            }
+            if (upper > h->max_ticks) {
+                upper = h->max_ticks;
+            }
+            return (double)upper * stats->ns_per_tick;
+        }
+    }
+    return (double)h->max_ticks * stats->ns_per_tick;
+}
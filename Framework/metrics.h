@@ -0,0 +1,58 @@
+/**
+ * @file metrics.h
+ * @brief Space Mission Control System - Internal Instrumentation Hooks
+ *
+ * Hot-path hooks used by the library sources. With MISSION_METRICS
+ * undefined every hook expands to nothing (or to a plain return), so
+ * the default build carries no instrumentation at all. Build with
+ * `make METRICS=1` to compile them in.
+ */
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include "space_mission.h"
+
+#ifdef MISSION_METRICS
+
+#if defined(__x86_64__) || defined(__i386__)
+#define metrics_ticks() ((long)__builtin_ia32_rdtsc())
+#else
+long metrics_ticks(void);
+#endif
+
+void metrics_attach(MissionControl* system);
+void metrics_detach(MissionControl* system);
+void metrics_record_call(const MissionControl* system, MetricApi api, int result, long start_ticks);
+void metrics_record_growth(const MissionControl* system, MetricGrowth array,
+                           const void* old_ptr, const void* new_ptr, size_t old_bytes);
+void metrics_record_lookup(const MissionControl* system, int probes);
+void metrics_append_to_report(const MissionControl* system, FILE* fp);
+
+// Times `expr` and records the call outcome, then returns its result
+#define METRICS_RETURN(system, api, expr) do {                          \
+        long metrics_start_ = metrics_ticks();                          \
+        int metrics_result_ = (expr);                                   \
+        metrics_record_call((system), (api), metrics_result_, metrics_start_); \
+        return metrics_result_;                                         \
+    } while (0)
+
+#define METRICS_ATTACH(system) metrics_attach(system)
+#define METRICS_DETACH(system) metrics_detach(system)
+#define METRICS_GROWTH(system, array, old_ptr, new_ptr, old_bytes) \
+    metrics_record_growth((system), (array), (old_ptr), (new_ptr), (old_bytes))
+#define METRICS_LOOKUP(system, probes) metrics_record_lookup((system), (probes))
+#define METRICS_REPORT(system, fp) metrics_append_to_report((system), (fp))
+
+#else /* !MISSION_METRICS */
+
+#define METRICS_RETURN(system, api, expr) return (expr)
+#define METRICS_ATTACH(system) ((void)0)
+#define METRICS_DETACH(system) ((void)0)
+#define METRICS_GROWTH(system, array, old_ptr, new_ptr, old_bytes) ((void)0)
+#define METRICS_LOOKUP(system, probes) ((void)0)
+#define METRICS_REPORT(system, fp) ((void)0)
+
+#endif /* MISSION_METRICS */
+
+#endif /* METRICS_H */
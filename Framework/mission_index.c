@@ -0,0 +1,162 @@
+/**
+ * @file mission_index.c
+ * @brief Space Mission Control System - Mission ID Hash Index
+ *
+ * Open-addressing (linear probing) table of positions into
+ * system->missions, keyed by mission_id. Keys are not stored twice: a
+ * slot holds the mission's position and the ID is read back from the
+ * mission itself. The table is kept at most half full, so duplicate
+ * checks and lookups by ID are O(1) instead of a scan of every mission.
+ */
+
+#include "mission_internal.h"
+#include "metrics.h"
+
+#define INDEX_EMPTY (-1)
+#define INDEX_MIN_CAPACITY 16
+
+static unsigned int index_slot(int mission_id, int capacity) {
+    // Fibonacci hashing spreads sequential IDs across the table
+    return ((unsigned int)mission_id * 2654435769u) & (unsigned int)(capacity - 1);
+}
+
+static int required_capacity(int mission_count) {
+    int capacity = INDEX_MIN_CAPACITY;
+    while (capacity < mission_count * 2) {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+static int rebuild_index(MissionControl* system, int capacity) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    int* slots = malloc((size_t)capacity * sizeof(int));
+    if (slots == NULL) {
+        return -1;
+    }
+    for (int i = 0; i < capacity; i++) {
+        slots[i] = INDEX_EMPTY;
+    }
+    for (int pos = 0; pos < system->mission_count; pos++) {
+        unsigned int slot = index_slot(system->missions[pos].mission_id, capacity);
+        while (slots[slot] != INDEX_EMPTY) {
+            slot = (slot + 1) & (unsigned int)(capacity - 1);
+        }
+        slots[slot] = pos;
+    }
+    free(sys->id_index);
+    sys->id_index = slots;
+    sys->id_index_capacity = capacity;
+    return 0;
+}
+
+int mission_index_reserve(MissionControl* system, int mission_count) {
+    int capacity = required_capacity(mission_count);
+    if (capacity <= MISSION_SYSTEM(system)->id_index_capacity) {
+        return 0;
+    }
+    return rebuild_index(system, capacity);
+}
+
+int mission_index_find(const MissionControl* system, int mission_id) {
+    const MissionSystem *sys = MISSION_SYSTEM(system);
+    if (sys->id_index == NULL) {
+        return -1;
+    }
+    unsigned int mask = (unsigned int)(sys->id_index_capacity - 1);
+    unsigned int slot = index_slot(mission_id, sys->id_index_capacity);
+    int probes = 1;
+    int pos;
+    while ((pos = sys->id_index[slot]) != INDEX_EMPTY) {
+        if (system->missions[pos].mission_id == mission_id) {
+            METRICS_LOOKUP(system, probes);
+            return pos;
+        }
+        slot = (slot + 1) & mask;
+        probes++;
+    }
+    METRICS_LOOKUP(system, probes);
+    return -1;
+}
+
+int mission_index_insert(MissionControl* system, int mission_id, int position) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    if (mission_index_reserve(system, system->mission_count + 1) != 0) {
+        return -1;
+    }
+    unsigned int mask = (unsigned int)(sys->id_index_capacity - 1);
+    unsigned int slot = index_slot(mission_id, sys->id_index_capacity);
+    while (sys->id_index[slot] != INDEX_EMPTY) {
+        slot = (slot + 1) & mask;
+    }
+    sys->id_index[slot] = position;
+    return 0;
+}
+
+int mission_index_remove(MissionControl* system, int mission_id) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    if (sys->id_index == NULL) {
+        return -1;
+    }
+    unsigned int mask = (unsigned int)(sys->id_index_capacity - 1);
+    unsigned int slot = index_slot(mission_id, sys->id_index_capacity);
+    while (sys->id_index[slot] != INDEX_EMPTY &&
+           system->missions[sys->id_index[slot]].mission_id != mission_id) {
+        slot = (slot + 1) & mask;
+    }
+    if (sys->id_index[slot] == INDEX_EMPTY) {
+        return -1;
+    }
+
+    // Backward-shift deletion keeps every probe chain unbroken without tombstones
+    unsigned int hole = slot;
+    unsigned int next = (hole + 1) & mask;
+    while (sys->id_index[next] != INDEX_EMPTY) {
+        int pos = sys->id_index[next];
+        unsigned int home = index_slot(system->missions[pos].mission_id, sys->id_index_capacity);
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            sys->id_index[hole] = pos;
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    sys->id_index[hole] = INDEX_EMPTY;
+    return 0;
+}
+
+void mission_index_relocate(MissionControl* system, int mission_id, int old_position,
+                            int new_position) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    if (sys->id_index == NULL) {
+        return;
+    }
+    unsigned int mask = (unsigned int)(sys->id_index_capacity - 1);
+    unsigned int slot = index_slot(mission_id, sys->id_index_capacity);
+    while (sys->id_index[slot] != INDEX_EMPTY) {
+        if (sys->id_index[slot] == old_position) {
+            sys->id_index[slot] = new_position;
+            return;
+        }
+        slot = (slot + 1) & mask;
+    }
+}
+
+void mission_index_memory(const MissionControl* system, MemoryFigure* figure) {
+    figure->used += (size_t)system->mission_count * sizeof(int);
+    figure->reserved += (size_t)MISSION_SYSTEM(system)->id_index_capacity * sizeof(int);
+}
+
+int mission_index_shrink(MissionControl* system) {
+    int capacity = required_capacity(system->mission_count);
+    if (capacity >= MISSION_SYSTEM(system)->id_index_capacity) {
+        return 0;
+    }
+    return rebuild_index(system, capacity);
+}
+
+void mission_index_free(MissionControl* system) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    free(sys->id_index);
+    sys->id_index = NULL;
+    sys->id_index_capacity = 0;
+}
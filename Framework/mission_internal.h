@@ -0,0 +1,895 @@
+/**
+ * @file mission_internal.h
+ * @brief Space Mission Control System - Library-Internal Helpers
+ *
+ * Declarations shared between the library translation units but not part
+ * of the public API in space_mission.h.
+ */
+
+#ifndef MISSION_INTERNAL_H
+#define MISSION_INTERNAL_H
+
+#include "space_mission.h"
+
+#include <stdint.h>
+
+/* =============================================================================
+ * SYSTEM STATE
+ * MissionControl in space_mission.h keeps its original three fields, the
+ * only ones the six required functions use. A system made by
+ * mission_system_create() is a MissionSystem that starts with that
+ * MissionControl; everything the rest of the library keeps per system
+ * follows it. The extension APIs therefore need a system created by this
+ * library's create_mission_control().
+ * ============================================================================= */
+
+/**
+ * @brief Incrementally maintained top-K structures (see enable_mission_leaderboard())
+ */
+typedef struct MissionLeaderboard MissionLeaderboard;
+
+/**
+ * @brief Ordered launch-date index (see enable_launch_index())
+ */
+typedef struct LaunchIndex LaunchIndex;
+
+/**
+ * @brief Reader registration and deferred frees (see enable_mission_snapshots())
+ */
+typedef struct MissionSnapshots MissionSnapshots;
+
+/**
+ * @brief Background report formatter/writer threads (see save_mission_report_async())
+ */
+typedef struct ReportService ReportService;
+
+/**
+ * @brief Communication subscribers and optional dispatcher thread (see subscribe_communications())
+ */
+typedef struct SubscriptionRegistry SubscriptionRegistry;
+
+/**
+ * @brief Shared-memory mirror for other processes (see enable_shared_view())
+ */
+typedef struct SharedView SharedView;
+
+/**
+ * @brief Rollup ring sizes (see enable_comm_rollups())
+ */
+typedef struct CommRollups CommRollups;
+
+/**
+ * @brief Duplicate suppression settings and counter (see enable_comm_dedup())
+ */
+typedef struct CommDedup CommDedup;
+
+/**
+ * @brief Reorder window settings and counters (see enable_comm_reorder())
+ */
+typedef struct CommReorder CommReorder;
+
+/**
+ * @brief Missions indexed but not yet created (see load_missions_from_file_lazy())
+ */
+typedef struct MissionCatalog MissionCatalog;
+
+/**
+ * @brief Where each stored log_id was committed (see log_directory.c)
+ */
+typedef struct LogDirectory LogDirectory;
+typedef struct LogDirectoryEntry LogDirectoryEntry;
+
+/**
+ * @brief Per-mission rollup rings (see enable_comm_rollups())
+ */
+typedef struct MissionRollup MissionRollup;
+
+/**
+ * @brief One mission's recent log fingerprints (see enable_comm_dedup())
+ */
+typedef struct CommDedupSet CommDedupSet;
+
+/**
+ * @brief One mission's logs waiting to be committed in order (see enable_comm_reorder())
+ */
+typedef struct CommReorderBuffer CommReorderBuffer;
+
+/**
+ * @brief Log-array bookkeeping of one mission, parallel to system->missions
+ *
+ * Only the writer reads it, so unlike the missions array it is resized in
+ * place even while snapshots are enabled.
+ */
+typedef struct {
+    int comm_pooled;        // 1 if communications lives in a shared pool block
+    int comm_offset;        // Logs purged from the front of the allocation
+    int comm_appended;      // Logs ever committed (ordinal of the next)
+    int compact_queued;     // 1 while waiting in the compaction queue
+    int logs_unsorted;      // 1 once a log was committed older than its predecessor
+} MissionMeta;
+
+typedef struct {
+    MissionControl base;    // Must stay first: the public view of the system
+#ifdef MISSION_HOT_COLD
+    MissionCold *mission_cold; // Cold halves, parallel to missions (same capacity)
+#endif
+    MissionMeta *mission_meta; // Log bookkeeping, parallel to missions (same capacity)
+    int *id_index;          // Hash index: mission_id -> position in missions
+    int id_index_capacity;  // Slots in id_index (power of two)
+    LogDirectory *log_directory; // log_id -> (mission, ordinal), NULL before the first log
+    int logs_committed;     // Log IDs assigned so far
+    int first_log_id;       // log_id of the first committed log
+    int log_id_stride;      // Step between consecutive log IDs (see sharded.c)
+    CommLog **comm_pools;   // Shared initial comm blocks from create_missions_bulk()
+    int comm_pool_count;    // Blocks in comm_pools
+    int comm_pool_capacity; // Capacity of comm_pools
+    size_t comm_pool_bytes; // Total size of the comm_pools blocks
+    GrowthPolicy growth_policy; // Growth of missions and log arrays (doubling by default)
+    MissionLeaderboard *leaderboard; // Top-K heaps, NULL unless enabled
+    LaunchIndex *launch_index;       // Missions ordered by launch date, NULL unless enabled
+    MissionSnapshots *snapshots;     // Concurrent snapshot support, NULL unless enabled
+    ReportService *report_service;   // Async report threads, NULL until first use
+    SubscriptionRegistry *subscriptions; // Log callbacks, NULL until the first subscription
+    SharedView *shared_view;         // Shared-memory mirror, NULL unless enabled
+    CommRollups *rollups;            // Time-bucketed log counters, NULL unless enabled
+    CommDedup *dedup;                // Duplicate suppression, NULL unless enabled
+    CommReorder *reorder;            // Out-of-order arrival buffer, NULL unless enabled
+    unsigned long layout_generation; // Odd while a removal rearranges arrays (see snapshot.c)
+    int *compact_queue;              // IDs of missions with purged space to reclaim
+    int compact_count;               // Entries in compact_queue
+    int compact_capacity;            // Capacity of compact_queue
+    MissionCatalog *catalog;         // Lazily loaded missions, NULL until a lazy load
+#ifdef MISSION_METRICS
+    MissionControlStats *stats; // Instrumentation counters (NULL if allocation failed)
+    int report_stats;           // Append stats to save_mission_report() output
+#endif
+} MissionSystem;
+
+/**
+ * @brief The MissionSystem behind `system`, keeping its constness
+ */
+#define MISSION_SYSTEM(system) _Generic((system), \
+    const MissionControl*: (const MissionSystem*)(system), \
+    default: (MissionSystem*)(system))
+
+/**
+ * @brief Cold fields (name, launch date, log capacity) of the mission at `position`
+ *
+ * Code that reads those fields through it builds unchanged with either
+ * Mission layout.
+ */
+#ifdef MISSION_HOT_COLD
+#define MISSION_COLD(system, position) (&MISSION_SYSTEM(system)->mission_cold[position])
+#else
+#define MISSION_COLD(system, position) (&(system)->missions[position])
+#endif
+
+/**
+ * @brief Log-array bookkeeping of the mission at `position`
+ */
+#define MISSION_META(system, position) (&MISSION_SYSTEM(system)->mission_meta[position])
+
+/**
+ * @brief Pointers a feature keeps per mission position, NULL until set
+ *
+ * Grows on demand; side_table_take() mirrors the swap in remove_mission().
+ */
+typedef struct {
+    void **entries;
+    int capacity;
+} MissionSideTable;
+
+/**
+ * @brief The entry at `position`, or NULL
+ */
+void* side_table_get(const MissionSideTable* table, int position);
+
+/**
+ * @brief Store `entry` at `position`, growing the table to the missions capacity
+ * @return 0 on success, -1 on allocation failure
+ */
+int side_table_set(MissionSideTable* table, const MissionControl* system, int position,
+                   void* entry);
+
+/**
+ * @brief Detach the entry at `position` and move the one at `last` into it
+ * @return The detached entry (the caller frees it)
+ */
+void* side_table_take(MissionSideTable* table, int position, int last);
+
+/**
+ * @brief Free the table itself; its entries must already be freed
+ */
+void side_table_free(MissionSideTable* table);
+
+/**
+ * @brief Add the table's own bytes to `figure`
+ */
+void side_table_memory(const MissionSideTable* table, MemoryFigure* figure);
+
+/* =============================================================================
+ * LIBRARY CORE (mission_store.c, comm_store.c, mission_records.c)
+ * The reference implementations of the six required functions delegate
+ * here. Framework modules call these, never helpers that live in the
+ * student files, so a submission only has to provide the six functions.
+ * ============================================================================= */
+
+/**
+ * @brief Allocate and initialise a system with room for `initial_capacity` (> 0) missions
+ * @return The system, or NULL on allocation failure
+ */
+MissionControl* mission_system_create(int initial_capacity);
+
+/**
+ * @brief Free a system and everything it owns (NULL is ignored)
+ */
+void mission_system_free(MissionControl* system);
+
+/**
+ * @brief Validate and append one mission with an INITIAL_COMM_CAPACITY log array
+ * @return 0 on success, -1 on invalid input, a duplicate ID or allocation failure
+ */
+int insert_mission(MissionControl* system, int mission_id, const char* name,
+                   const char* launch_date);
+
+/**
+ * @brief Validate a log and append it, through dedup and reordering when enabled
+ * @return As add_communication()
+ */
+int append_communication(MissionControl* system, int mission_id, const char* timestamp,
+                         MessagePriority priority, const char* message);
+
+/**
+ * @brief Load a mission file with one bulk insert of its valid prefix
+ * @return 0 on success, -1 if the file could not be read or a record was refused
+ */
+int load_mission_file(MissionControl* system, const char* filename);
+
+/**
+ * @brief load_mission_file() on an open file positioned after the mission count
+ * @return 0 on success, -1 if a record was malformed or refused
+ */
+int load_mission_records(MissionControl* system, FILE* fp, int declared);
+
+/**
+ * @brief Write the mission report to `filename`
+ * @return 0 on success, -1 on failure
+ */
+int write_mission_report(const MissionControl* system, const char* filename);
+
+/* =============================================================================
+ * MISSION ID INDEX (mission_index.c)
+ * Open-addressing hash table from mission_id to position in system->missions.
+ * ============================================================================= */
+
+/**
+ * @brief Make room for at least `mission_count` indexed missions
+ * @return 0 on success, -1 on allocation failure
+ */
+int mission_index_reserve(MissionControl* system, int mission_count);
+
+/**
+ * @brief Position of `mission_id` in system->missions, or -1 if absent
+ */
+int mission_index_find(const MissionControl* system, int mission_id);
+
+/**
+ * @brief Record that system->missions[position] holds `mission_id`
+ * @return 0 on success, -1 on allocation failure
+ */
+int mission_index_insert(MissionControl* system, int mission_id, int position);
+
+/**
+ * @brief Drop `mission_id` from the index (its mission must still hold that ID)
+ * @return 0 on success, -1 if it was not indexed
+ */
+int mission_index_remove(MissionControl* system, int mission_id);
+
+/**
+ * @brief Point the entry of `mission_id` at `new_position` (it was `old_position`)
+ *
+ * Matches on the stored position, so it is safe while the missions array
+ * is being rearranged.
+ */
+void mission_index_relocate(MissionControl* system, int mission_id, int old_position,
+                            int new_position);
+
+/**
+ * @brief Release the index storage
+ */
+void mission_index_free(MissionControl* system);
+
+/* =============================================================================
+ * LOG DIRECTORY (log_directory.c)
+ * Map from log_id to the owning mission and append ordinal: a dense window
+ * over the newest IDs plus a sorted array of older IDs still stored.
+ * ============================================================================= */
+
+/**
+ * @brief Number logs first_log_id, first_log_id + stride, ...; call before
+ *        the first log is committed
+ */
+void set_log_id_sequence(MissionControl* system, int first_log_id, int stride);
+
+/**
+ * @brief Assign the next log_id to a log about to be committed
+ * @param ordinal The mission's MissionMeta.comm_appended before this log
+ * @return The log_id, or -1 on allocation failure or ID exhaustion
+ */
+int log_directory_add(MissionControl* system, int mission_id, int ordinal);
+
+/**
+ * @brief Drop the entries of logs about to be purged or removed with their mission
+ */
+void log_directory_drop(MissionControl* system, const CommLog* logs, int count);
+
+/**
+ * @brief The stored log with `log_id`, or NULL
+ * @param position If non-NULL, set to the owning mission's position when found
+ */
+CommLog* log_directory_find(const MissionControl* system, int log_id, int* position);
+
+/**
+ * @brief Add the directory's bytes to `figure`
+ */
+void log_directory_memory(const MissionControl* system, MemoryFigure* figure);
+
+/**
+ * @brief Rebuild the directory without its dropped entries once they
+ *        outnumber the live ones
+ * @return 0 on success, -1 on allocation failure (directory unchanged)
+ */
+int log_directory_compact(MissionControl* system);
+
+/**
+ * @brief Rebuild the directory without its dropped entries, at its used size
+ * @return 0 on success, -1 on allocation failure (directory unchanged)
+ */
+int log_directory_shrink(MissionControl* system);
+
+/**
+ * @brief Release the directory storage
+ */
+void log_directory_free(MissionControl* system);
+
+/* =============================================================================
+ * COMM BUFFER POOLS (mission_store.c, comm_store.c)
+ * ============================================================================= */
+
+/**
+ * @brief Resize a mission's communications array to `capacity` (>= comm_count) entries
+ *
+ * Pooled buffers (MissionMeta.comm_pooled) and buffers with a purged front
+ * (MissionMeta.comm_offset) are moved into their own allocation; others are
+ * realloc()ed. Compaction uses it to shrink.
+ * @return 0 on success, -1 on allocation failure
+ */
+int grow_mission_comms(MissionControl* system, Mission* mission, int capacity);
+
+/**
+ * @brief The mission's log with `log_id`, or NULL if it was purged or never existed
+ */
+CommLog* find_mission_log(const Mission* mission, int log_id);
+
+/**
+ * @brief Release every pooled comm block owned by the system
+ */
+void free_comm_pools(MissionControl* system);
+
+/**
+ * @brief Free a replaced log allocation, or retire it while snapshots may read it
+ *
+ * `base` is the start of the allocation (communications - comm_offset);
+ * pooled buffers are owned by their pool and left alone.
+ */
+void release_comm_buffer(MissionControl* system, CommLog* base, int pooled);
+
+/**
+ * @brief Per-priority and unacknowledged log counts, or a change to them
+ */
+typedef struct {
+    int priority_counts[EMERGENCY + 1]; // Indexed by MessagePriority
+    int unacked_count;
+} MissionLogCounts;
+
+/**
+ * @brief Count `count` logs starting at `logs` into `out`
+ */
+void count_mission_logs(const CommLog* logs, int count, MissionLogCounts* out);
+
+/* =============================================================================
+ * LEADERBOARD MAINTENANCE (leaderboard.c)
+ * Callers check system->leaderboard != NULL first.
+ * ============================================================================= */
+
+/**
+ * @brief Add the newly created missions at positions [first, first + count)
+ * @return 0 on success, -1 on allocation failure (the leaderboard is disabled)
+ */
+int leaderboard_add_missions(MissionControl* system, int first, int count);
+
+/**
+ * @brief Re-rank the mission at `position` after its logs changed by `delta`
+ */
+void leaderboard_update(MissionControl* system, int position, const MissionLogCounts* delta);
+
+/**
+ * @brief Drop the mission at `position` ahead of a swap-remove
+ *
+ * Called while the missions array is unchanged; afterwards the heaps
+ * refer to the last mission by `position`, where remove_mission() moves it.
+ */
+void leaderboard_remove_mission(MissionControl* system, int position);
+
+/**
+ * @brief Release the leaderboard storage
+ */
+void leaderboard_free(MissionControl* system);
+
+/* =============================================================================
+ * LAUNCH DATE INDEX MAINTENANCE (launch_index.c)
+ * Callers check system->launch_index != NULL first.
+ * ============================================================================= */
+
+/**
+ * @brief Add the newly created missions at positions [first, first + count)
+ * @return 0 on success, -1 on allocation failure (the index is disabled)
+ */
+int launch_index_add_missions(MissionControl* system, int first, int count);
+
+/**
+ * @brief Tombstone the key of the mission at `position` ahead of a swap-remove
+ */
+void launch_index_remove(MissionControl* system, int position);
+
+/**
+ * @brief Release the launch-date index storage
+ */
+void launch_index_free(MissionControl* system);
+
+/* =============================================================================
+ * MEMORY FOOTPRINT (footprint.c, mission_store.c and the index modules)
+ * ============================================================================= */
+
+/**
+ * @brief Capacity for an array of `capacity` entries that must hold `needed`
+ *        (applies system->growth_policy)
+ */
+int grown_capacity(const MissionControl* system, int capacity, int needed);
+
+/**
+ * @brief Resize the missions array to exactly `new_capacity` (>= mission_count) slots
+ */
+int resize_missions(MissionControl* system, int new_capacity);
+
+/**
+ * @brief Free the missions array and its side tables
+ */
+void free_mission_arrays(MissionControl* system);
+
+/**
+ * @brief Position of a Mission* that points into system->missions
+ */
+#define MISSION_POSITION(system, mission) ((int)((mission) - (system)->missions))
+
+/**
+ * @brief MISSION_COLD() for a Mission* that points into system->missions
+ */
+#define MISSION_COLD_OF(system, mission) MISSION_COLD(system, MISSION_POSITION(system, mission))
+
+/**
+ * @brief Add the ID index's bytes to `figure`
+ */
+void mission_index_memory(const MissionControl* system, MemoryFigure* figure);
+
+/**
+ * @brief Shrink the ID index to the smallest table that keeps it half empty
+ */
+int mission_index_shrink(MissionControl* system);
+
+/**
+ * @brief Add the leaderboard's bytes to `figure`
+ */
+void leaderboard_memory(const MissionControl* system, MemoryFigure* figure);
+
+/**
+ * @brief Shrink the heaps to the missions they hold
+ */
+int leaderboard_shrink(MissionControl* system);
+
+/**
+ * @brief Add the launch index's bytes to `figure`
+ */
+void launch_index_memory(const MissionControl* system, MemoryFigure* figure);
+
+/**
+ * @brief Drop tombstones and shrink the key arrays
+ */
+int launch_index_shrink(MissionControl* system);
+
+/**
+ * @brief Add the rollup rings' bytes to `figure`
+ */
+void rollups_memory(const MissionControl* system, MemoryFigure* figure);
+
+/**
+ * @brief Add the dedup sets' bytes to `figure`
+ */
+void dedup_memory(const MissionControl* system, MemoryFigure* figure);
+
+/**
+ * @brief Add the reorder buffers' bytes to `figure`
+ */
+void reorder_memory(const MissionControl* system, MemoryFigure* figure);
+
+/* =============================================================================
+ * SNAPSHOT SUPPORT (snapshot.c)
+ * ============================================================================= */
+
+/**
+ * @brief Free an unpublished array now, or once no snapshot can still read it
+ *
+ * Only valid while system->snapshots is non-NULL, after the replacement
+ * pointer has been published with a sequentially consistent store.
+ */
+void retire_shared_array(MissionControl* system, void* old_array);
+
+/**
+ * @brief Bracket a removal or purge that rearranges published arrays
+ *
+ * Makes system->layout_generation odd until layout_change_end(), so a
+ * concurrent snapshot_capture() retries instead of pairing a count with
+ * an array it no longer describes.
+ */
+void layout_change_begin(MissionControl* system);
+
+/**
+ * @brief End the change started by layout_change_begin()
+ */
+void layout_change_end(MissionControl* system);
+
+/**
+ * @brief Resize the snapshot marks with the missions array (see resize_missions())
+ * @return 0 on success, -1 on allocation failure (marks unchanged)
+ */
+int snapshot_resize_marks(MissionControl* system, int new_capacity);
+
+/**
+ * @brief Mark the missions at [first, first + count) as created now; call
+ *        before mission_count covers them
+ */
+void snapshot_mark_missions(MissionControl* system, int first, int count);
+
+/**
+ * @brief Move the mark of the mission at `last` to `position`; call inside
+ *        the layout change of a swap-remove
+ */
+void snapshot_move_mark(MissionControl* system, int last, int position);
+
+/**
+ * @brief Let new snapshots see the missions or the log just published
+ */
+void snapshot_publish_missions(MissionControl* system);
+void snapshot_publish_log(MissionControl* system);
+
+/* =============================================================================
+ * REPORT FORMATTING (mission_records.c, snapshot.c)
+ * Shared by save_mission_report() and the snapshot/async reporters so every
+ * path produces byte-identical output.
+ * ============================================================================= */
+
+#define REPORT_BLOCK_MAX 512    // Upper bound on any single formatted block
+
+/**
+ * @brief snprintf()-style formatters for the report header, one mission block
+ *        (`index` is its 0-based position) and the totals footer
+ * @return Number of characters written (excluding the terminator)
+ */
+int report_format_header(char* out, size_t size, int mission_count);
+int report_format_mission(char* out, size_t size, int index, const MissionView* mission);
+int report_format_totals(char* out, size_t size, int total_comms);
+
+/**
+ * @brief Receives consecutive pieces of a report
+ * @return 0 to continue, -1 to abort
+ */
+typedef int (*ReportSink)(void* context, const char* data, size_t length);
+
+/**
+ * @brief Format a full report of `snapshot` into `sink`
+ * @return 0 on success, -1 if the sink failed
+ */
+int emit_snapshot_report(const MissionSnapshot* snapshot, ReportSink sink, void* context);
+
+/* =============================================================================
+ * SNAPSHOT STAGES (snapshot.c)
+ * begin_mission_snapshot() is snapshot_open() followed by snapshot_capture().
+ * ============================================================================= */
+
+/**
+ * @brief Register a snapshot and fix its cut-off; O(1), call on the writer's side
+ */
+MissionSnapshot* snapshot_open(const MissionControl* system);
+
+/**
+ * @brief Record the per-mission counts as of the cut-off; O(N), any thread
+ * @return 0 on success, -1 on allocation failure (the snapshot stays open)
+ */
+int snapshot_capture(MissionSnapshot* snapshot, const MissionControl* system);
+
+/* =============================================================================
+ * ASYNC REPORT SERVICE (report_async.c)
+ * ============================================================================= */
+
+/**
+ * @brief Capture the snapshot of every queued report; call on the writer's
+ *        side before a removal or purge
+ */
+void report_service_capture_queued(MissionControl* system);
+
+/**
+ * @brief Finish queued async reports and stop the service threads
+ */
+void report_service_stop(MissionControl* system);
+
+/* =============================================================================
+ * SUBSCRIPTIONS (subscriptions.c)
+ * ============================================================================= */
+
+/**
+ * @brief Run or queue the callbacks matching a just-published log
+ *
+ * Call only when system->subscriptions is non-NULL.
+ */
+void notify_subscribers(MissionControl* system, int mission_id, const CommLog* log);
+
+/**
+ * @brief Stop the dispatcher and free every subscription
+ */
+void subscriptions_free(MissionControl* system);
+
+/* =============================================================================
+ * SHARED-MEMORY VIEW MAINTENANCE (shm_view.c)
+ * Called only when system->shared_view is non-NULL.
+ * ============================================================================= */
+
+/**
+ * @brief Mirror the just-published missions at positions [first, first + count)
+ */
+void shared_view_add_missions(MissionControl* system, int first, int count);
+
+/**
+ * @brief Republish the counters of the mission at `position` after its
+ *        logs changed by `delta`
+ */
+void shared_view_update(MissionControl* system, int position, const MissionLogCounts* delta);
+
+/**
+ * @brief Mirror a swap-remove of the mission at `position`
+ *
+ * Called before the missions array changes: the last mission is about to
+ * move into `position`.
+ */
+void shared_view_remove_mission(MissionControl* system, int position);
+
+/**
+ * @brief Unmap and unlink the segment
+ */
+void shared_view_free(MissionControl* system);
+
+/* =============================================================================
+ * ROLLUP MAINTENANCE (rollups.c)
+ * ============================================================================= */
+
+/**
+ * @brief Count a just-published log; call only when system->rollups is non-NULL
+ * @return 0, or -1 if allocation failed and the rollups were dropped
+ */
+int rollups_record(MissionControl* system, int position, const CommLog* log);
+
+/**
+ * @brief Free the rings of the mission at `position` ahead of a swap-remove
+ */
+void rollups_remove_mission(MissionControl* system, int position);
+
+/**
+ * @brief Free every mission's rings and the rollup state
+ */
+void rollups_free(MissionControl* system);
+
+/**
+ * @brief "YYYY-MM-DD HH:MM" -> minutes since 1970-01-01 00:00
+ * @return 1 on success, 0 if the timestamp is not a real date and time
+ */
+int timestamp_to_epoch_minute(const char* timestamp, long* epoch_minute);
+
+/* =============================================================================
+ * DUPLICATE SUPPRESSION (dedup.c)
+ * ============================================================================= */
+
+/**
+ * @brief 64-bit hash of a log's (timestamp, priority, message)
+ */
+uint64_t comm_fingerprint(const char* timestamp, MessagePriority priority, const char* message);
+
+/**
+ * @brief Is this log a duplicate for the mission at `position`? Call only
+ *        when system->dedup is non-NULL
+ * @param fingerprint Set either way, for dedup_record() after the append
+ * @return 1 if it is (and counts it), 0 otherwise
+ */
+int dedup_check(MissionControl* system, int position, const char* timestamp,
+                MessagePriority priority, const char* message, uint64_t* fingerprint);
+
+/**
+ * @brief Remember a just-appended log; on allocation failure the mission
+ *        stays unprotected
+ */
+void dedup_record(MissionControl* system, int position, uint64_t fingerprint, int log_id);
+
+/**
+ * @brief Free the set of the mission at `position` ahead of a swap-remove
+ */
+void dedup_remove_mission(MissionControl* system, int position);
+
+/**
+ * @brief Free every mission's set and the dedup state
+ */
+void dedup_free(MissionControl* system);
+
+/**
+ * @brief Count a duplicate found outside the stored logs (a buffered log)
+ */
+void dedup_note_duplicate(MissionControl* system);
+
+/* =============================================================================
+ * TIME-ORDERED LOGS (comm_store.c, reorder.c)
+ * ============================================================================= */
+
+/**
+ * @brief Store a validated, non-duplicate log at the end of the mission at
+ *        `position` and run the append hooks
+ * @param fingerprint From dedup_check(), ignored while dedup is disabled
+ * @return 0 on success, -1 on allocation failure
+ */
+int commit_communication(MissionControl* system, int position, const char* timestamp,
+                         MessagePriority priority, const char* message, uint64_t fingerprint);
+
+/**
+ * @brief [*begin, *end) = the mission's logs with `from` <= timestamp <= `to`;
+ *        the logs must be in timestamp order, NULL bounds are open
+ */
+void logs_in_time_range(const Mission* mission, const char* from, const char* to, int* begin,
+                        int* end);
+
+/**
+ * @brief Buffer a log; call only when system->reorder is non-NULL
+ * @return COMM_ADD_OK when buffered, COMM_ADD_TOO_LATE or COMM_ADD_DUPLICATE
+ *         (both counted), or COMM_ADD_REJECTED for an unplaceable timestamp
+ *         or allocation failure
+ */
+CommAddStatus reorder_add(MissionControl* system, int position, const char* timestamp,
+                          MessagePriority priority, const char* message, uint64_t fingerprint);
+
+/**
+ * @brief Free the buffer of the mission at `position`, discarding its logs,
+ *        ahead of a swap-remove
+ */
+void reorder_remove_mission(MissionControl* system, int position);
+
+/**
+ * @brief Free every mission's buffer and the reorder state
+ */
+void reorder_free(MissionControl* system);
+
+/* =============================================================================
+ * PARSED MISSION RECORDS (mission_records.c, parallel_load.c, parallel_replay.c, sharded.c)
+ * ============================================================================= */
+
+typedef struct {
+    int mission_id;
+    char mission_name[MAX_NAME_LENGTH];
+    char launch_date[MAX_DATE_LENGTH];
+    int length;         // Characters consumed, including leading whitespace
+} MissionRecord;
+
+/**
+ * @brief Read one "mission_id mission_name launch_date" record with fscanf()
+ * @return 1 on success, 0 on a malformed or missing record
+ */
+int read_mission_record(FILE* fp, MissionRecord* record);
+
+/**
+ * @brief Field validation applied to every loaded record
+ */
+int is_valid_mission_record(const MissionRecord* record);
+
+#define MIN_RECORD_BYTES 14         // Shortest record, "1 A 2024-01-01"
+#define STREAM_RECORD_BATCH 256     // First buffer for a file of unknown size
+
+/**
+ * @brief Read up to `declared` records, stopping at the first malformed or invalid one
+ * @return The count read into *records (caller frees), or -1 if memory runs out
+ */
+int read_mission_records(FILE* fp, int declared, MissionRecord** records);
+
+/**
+ * @brief Index of the first record whose mission ID repeats an earlier record's
+ * @return That index, `count` if every ID is distinct, or -1 if memory runs out
+ */
+int first_repeated_record(const MissionRecord* records, int count);
+
+/* =============================================================================
+ * LAZY CATALOG (catalog.c, mission_store.c)
+ * The catalog hooks are called only when system->catalog is non-NULL.
+ * ============================================================================= */
+
+/**
+ * @brief Append a validated mission whose log array is allocated by its first append
+ * @return Its position in system->missions, or -1 on allocation failure
+ */
+int append_lazy_mission(MissionControl* system, int mission_id, const char* name,
+                        const char* launch_date);
+
+/**
+ * @brief mission_index_find(), creating the mission first if it is still pending
+ * @return Its position, or -1 if unknown or it could not be created
+ */
+int mission_index_find_or_load(MissionControl* system, int mission_id);
+
+/**
+ * @brief Is `mission_id` catalogued but not created yet?
+ */
+int catalog_is_pending(const MissionControl* system, int mission_id);
+
+/**
+ * @brief Is `mission_id` a created catalog mission (listed with the catalog)?
+ */
+int catalog_lists_mission(const MissionControl* system, int mission_id);
+
+/**
+ * @brief Mark the catalog entry of `mission_id` removed
+ * @return 0 if it was still pending, -1 otherwise
+ */
+int catalog_remove(MissionControl* system, int mission_id);
+
+/**
+ * @brief Write the report blocks of every catalog mission in file order
+ *
+ * `index` and `total_comms` are advanced past the missions written.
+ * @return 0 on success, -1 if a pending record could not be read back
+ */
+int catalog_write_report(const MissionControl* system, FILE* fp, int* index, int* total_comms);
+
+/**
+ * @brief Add the catalog's bytes to `figure`
+ */
+void catalog_memory(const MissionControl* system, MemoryFigure* figure);
+
+/**
+ * @brief Close the catalog files and free the catalog
+ */
+void catalog_free(MissionControl* system);
+
+/* =============================================================================
+ * THREAD POOL (thread_pool.c)
+ * ============================================================================= */
+
+typedef void (*ParallelTask)(void* context, int task_index);
+
+/**
+ * @brief Run task(context, i) for i in [0, task_count) on up to thread_count threads
+ *
+ * Workers claim task indices dynamically, so uneven tasks balance out.
+ * The caller is one of the workers; with thread_count <= 1, or if no
+ * thread can be started, every task runs inline on the calling thread.
+ * @return 0 once all tasks have run
+ */
+int run_parallel_tasks(int task_count, int thread_count, ParallelTask task, void* context);
+
+/**
+ * @brief Number of online CPUs (at least 1)
+ */
+int online_cpu_count(void);
+
+#endif /* MISSION_INTERNAL_H */
@@ -0,0 +1,285 @@
+/**
+ * @file mission_records.c
+ * @brief Space Mission Control System - Mission Files and Reports
+ *
+ * The library side of FUNCTIONS 4 and 5: the reference
+ * load_missions_from_file() and save_mission_report() delegate here. The
+ * record reader and the report formatters are shared with the parallel,
+ * lazy, sharded and snapshot paths so they all accept the same files and
+ * produce byte-identical reports.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mission_internal.h"
+#include "metrics.h"
+
+#include <ctype.h>
+
+/* ===== RECORDS ===== */
+
+/*
+ * Shared record reader: fscanf() with bounded fields. A token that fills
+ * its buffer must be followed by whitespace, otherwise it was truncated.
+ */
+int read_mission_record(FILE* fp, MissionRecord* record) {
+    if (fscanf(fp, "%d %49s %11s%n", &record->mission_id, record->mission_name,
+               record->launch_date, &record->length) != 3) {
+        return 0;
+    }
+    int next = fgetc(fp);
+    if (next != EOF) {
+        ungetc(next, fp);
+        if (!isspace(next)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int is_valid_mission_record(const MissionRecord* record) {
+    return record->mission_id > 0 && is_valid_date_format(record->launch_date);
+}
+
+/*
+ * A record takes at least MIN_RECORD_BYTES, so a regular file's size bounds
+ * how many can really follow whatever the declared count. Pipes and FIFOs
+ * report no size; their buffer starts small and doubles as records arrive.
+ */
+int read_mission_records(FILE* fp, int declared, MissionRecord** records) {
+    struct stat st;
+    int capacity = declared;
+    if (fstat(fileno(fp), &st) == 0 && S_ISREG(st.st_mode)) {
+        if (st.st_size / MIN_RECORD_BYTES + 1 < capacity) {
+            capacity = (int)(st.st_size / MIN_RECORD_BYTES + 1);
+        }
+    } else if (capacity > STREAM_RECORD_BATCH) {
+        capacity = STREAM_RECORD_BATCH;
+    }
+
+    MissionRecord *buffer = malloc((size_t)(capacity > 0 ? capacity : 1) * sizeof(MissionRecord));
+    if (buffer == NULL) {
+        return -1;
+    }
+    int count = 0;
+    while (count < declared) {
+        if (count == capacity) {
+            int grown = capacity <= declared / 2 ? capacity * 2 : declared;
+            MissionRecord *larger = realloc(buffer, (size_t)grown * sizeof(MissionRecord));
+            if (larger == NULL) {
+                free(buffer);
+                return -1;
+            }
+            buffer = larger;
+            capacity = grown;
+        }
+        if (!read_mission_record(fp, &buffer[count]) || !is_valid_mission_record(&buffer[count])) {
+            break;
+        }
+        count++;
+    }
+    *records = buffer;
+    return count;
+}
+
+typedef struct {
+    int mission_id;
+    int ordinal;            // Position in the file
+} RecordRef;
+
+static int compare_record_refs(const void* a, const void* b) {
+    const RecordRef *ra = a;
+    const RecordRef *rb = b;
+    if (ra->mission_id != rb->mission_id) {
+        return (ra->mission_id > rb->mission_id) - (ra->mission_id < rb->mission_id);
+    }
+    return (ra->ordinal > rb->ordinal) - (ra->ordinal < rb->ordinal);
+}
+
+/*
+ * Loaders that split a file over several systems cannot rely on one bulk
+ * insert to stop at a repeated ID, so they cut the batch here first.
+ * Sorting (ID, ordinal) pairs puts each repeat right after its first use.
+ */
+int first_repeated_record(const MissionRecord* records, int count) {
+    if (count <= 1) {
+        return count;
+    }
+    RecordRef *refs = malloc((size_t)count * sizeof(RecordRef));
+    if (refs == NULL) {
+        return -1;
+    }
+    for (int i = 0; i < count; i++) {
+        refs[i].mission_id = records[i].mission_id;
+        refs[i].ordinal = i;
+    }
+    qsort(refs, (size_t)count, sizeof(RecordRef), compare_record_refs);
+    int first = count;
+    for (int i = 1; i < count; i++) {
+        if (refs[i].mission_id == refs[i - 1].mission_id && refs[i].ordinal < first) {
+            first = refs[i].ordinal;
+        }
+    }
+    free(refs);
+    return first;
+}
+
+/* ===== LOADING ===== */
+
+/*
+ * Parse the valid prefix of the records left in `fp`, then insert it with
+ * one bulk call. Fails if a record is malformed or invalid, or refused
+ * (e.g. a duplicate ID); the missions before it stay.
+ */
+int load_mission_records(MissionControl* system, FILE* fp, int declared) {
+    MissionRecord *records;
+    int parsed = read_mission_records(fp, declared, &records);
+    if (parsed < 0) {
+        return -1;
+    }
+    MissionSpec *specs = malloc((size_t)(parsed > 0 ? parsed : 1) * sizeof(MissionSpec));
+    if (specs == NULL) {
+        free(records);
+        return -1;
+    }
+    for (int i = 0; i < parsed; i++) {
+        specs[i].mission_id = records[i].mission_id;
+        specs[i].name = records[i].mission_name;
+        specs[i].launch_date = records[i].launch_date;
+    }
+
+    int created = create_missions_bulk(system, specs, parsed);
+    free(specs);
+    free(records);
+    if (created != parsed || parsed < declared) {
+        return -1;
+    }
+    return 0;
+}
+
+int load_mission_file(MissionControl* system, const char* filename) {
+    if (system == NULL || filename == NULL || filename[0] == '\0') {
+        return -1;
+    }
+
+    FILE *fp = fopen(filename, "r");
+
+    if (fp == NULL) {
+        return -1;
+    }
+
+    int num_missions = 0;
+    int scanned_items = fscanf(fp, "%d", &num_missions);
+
+    if (scanned_items != 1) {
+        fclose(fp);
+        return -1;
+    }
+
+    if (num_missions < 0) {
+        fclose(fp);
+        return -1;
+    }
+
+    int result = num_missions > 0 ? load_mission_records(system, fp, num_missions) : 0;
+    fclose(fp);
+    return result;
+}
+
+/* ===== REPORT ===== */
+
+int write_mission_report(const MissionControl* system, const char* filename) {
+    const MissionSystem *sys = MISSION_SYSTEM(system);
+    int total_system_comms = 0;
+    if (system == NULL || filename == NULL || filename[0] == '\0') {
+        return -1;
+    }
+
+    FILE *fp = fopen(filename, "w");
+
+    if (fp == NULL) {
+        return -1;
+    }
+
+    char block[REPORT_BLOCK_MAX];
+    int listed = system->mission_count + pending_mission_count(system);
+    fwrite(block, 1, report_format_header(block, sizeof(block), listed), fp);
+
+    // Lazily loaded missions first, in file order, as an eager load lists them
+    int index = 0;
+    if (sys->catalog != NULL &&
+        catalog_write_report(system, fp, &index, &total_system_comms) != 0) {
+        fclose(fp);
+        return -1;
+    }
+
+    for (int i = 0; i < system->mission_count; i++) {
+        const Mission *m = &system->missions[i];
+        if (sys->catalog != NULL && catalog_lists_mission(system, m->mission_id)) {
+            continue;
+        }
+        const MissionCold *cold = MISSION_COLD(system, i);
+        MissionView view = { m->mission_id, cold->mission_name, cold->launch_date, m->status,
+                             m->communications, m->comm_count };
+
+        total_system_comms += m->comm_count;
+        fwrite(block, 1, report_format_mission(block, sizeof(block), index++, &view), fp);
+    }
+
+    fwrite(block, 1, report_format_totals(block, sizeof(block), total_system_comms), fp);
+    METRICS_REPORT(system, fp);
+
+    fclose(fp);
+    return 0;
+}
+
+/* ===== REPORT FORMATTING ===== */
+
+static const char* report_status_label(MissionStatus status) {
+    switch(status) {
+        case PLANNED: 
+            return "Planned";
+        case ACTIVE:  
+            return "Active";
+        case COMPLETED: 
+            return "Completed";
+        default:      
+            return "Unknown";
+    }
+}
+
+int report_format_header(char* out, size_t size, int mission_count) {
+    return snprintf(out, size,
+                    "===============================================\n"
+                    "SPACE MISSION CONTROL REPORT\n"
+                    "===============================================\n"
+                    "Total Missions in System: %d\n", mission_count);
+}
+
+int report_format_mission(char* out, size_t size, int index, const MissionView* m) {
+    MissionLogCounts counts;
+    count_mission_logs(m->communications, m->comm_count, &counts);
+    return snprintf(out, size,
+                    "%s"
+                    "Mission ID: %d\n"
+                    "Mission Name: %s\n"
+                    "Launch Date: %s\n"
+                    "Status: %s\n"
+                    "Communications: %d\n"
+                    "-------------------\n"
+                    "Communication Summary:\n"
+                    "  Routine: %d, Urgent: %d, Emergency: %d\n",
+                    index > 0 ? "\n" : "",
+                    m->mission_id, m->mission_name, m->launch_date,
+                    report_status_label(m->status), m->comm_count,
+                    counts.priority_counts[ROUTINE], counts.priority_counts[URGENT],
+                    counts.priority_counts[EMERGENCY]);
+}
+
+int report_format_totals(char* out, size_t size, int total_comms) {
+    return snprintf(out, size,
+                    "\n===============================================\n"
+                    "SYSTEM TOTALS:\n"
+                    "Total Communications: %d\n"
+                    "===============================================\n", total_comms);
+}
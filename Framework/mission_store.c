@@ -0,0 +1,648 @@
+/**
+ * @file mission_store.c
+ * @brief Space Mission Control System - Mission Table
+ *
+ * The library side of FUNCTIONS 1, 2 and 6: the reference
+ * create_mission_control(), create_mission_with_crew() and
+ * free_mission_control() delegate here, and every other way of creating
+ * or removing missions (bulk and lazy loads, remove_mission()) shares the
+ * same array, index and hook maintenance.
+ *
+ * Framework objects call the six required functions and the functions in
+ * the library modules only, so any submission's four student files link
+ * against them.
+ */
+
+#include "mission_internal.h"
+#include "metrics.h"
+
+#include <limits.h>
+
+/* ===== SYSTEM LIFECYCLE ===== */
+
+MissionControl* mission_system_create(int initial_capacity) {
+    MissionSystem *state = calloc(1, sizeof(MissionSystem));
+    if (state == NULL) {
+        return NULL;
+    }
+    MissionControl *ctrl = &state->base;
+
+    ctrl->missions = malloc(initial_capacity * sizeof(Mission));
+    if (ctrl->missions == NULL) {
+        free(state);
+        return NULL;
+    }
+#ifdef MISSION_HOT_COLD
+    state->mission_cold = malloc(initial_capacity * sizeof(MissionCold));
+    if (state->mission_cold == NULL) {
+        free(ctrl->missions);
+        free(state);
+        return NULL;
+    }
+#endif
+    state->mission_meta = malloc(initial_capacity * sizeof(MissionMeta));
+    if (state->mission_meta == NULL) {
+        free_mission_arrays(ctrl);
+        free(state);
+        return NULL;
+    }
+
+    // Every other field starts zeroed or NULL: no index, pools, features
+    ctrl->mission_count = 0;
+    ctrl->capacity = initial_capacity;
+    set_log_id_sequence(ctrl, 1, 1);
+    set_growth_policy(ctrl, NULL);
+    if (mission_index_reserve(ctrl, initial_capacity) != 0) {
+        free_mission_arrays(ctrl);
+        free(state);
+        return NULL;
+    }
+    METRICS_ATTACH(ctrl);
+
+    return ctrl;
+}
+
+void mission_system_free(MissionControl* system) {
+    if (system == NULL) {
+        return;
+    }
+
+    // Queued async reports still read the missions
+    report_service_stop(system);
+    subscriptions_free(system);
+    shared_view_free(system);
+    rollups_free(system);
+    dedup_free(system);
+    reorder_free(system);
+
+    if (system->missions != NULL) {
+        for (int i = 0; i < system->mission_count; i++) {
+            const MissionMeta *meta = MISSION_META(system, i);
+            // Pooled buffers are released with their block below
+            if (system->missions[i].communications != NULL && !meta->comm_pooled) {
+                free(system->missions[i].communications - meta->comm_offset);
+            }
+        }
+        free_mission_arrays(system);
+    }
+    free_comm_pools(system);
+    free(MISSION_SYSTEM(system)->compact_queue);
+    catalog_free(system);
+    leaderboard_free(system);
+    launch_index_free(system);
+    disable_mission_snapshots(system);
+    mission_index_free(system);
+    log_directory_free(system);
+    METRICS_DETACH(system);
+    free(MISSION_SYSTEM(system));
+}
+
+/* ===== GROWTH POLICY ===== */
+
+int set_growth_policy(MissionControl* system, const GrowthPolicy* policy) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    if (system == NULL) {
+        return -1;
+    }
+    if (policy == NULL) {
+        sys->growth_policy.growth_percent = 100;
+        sys->growth_policy.chunk_threshold = 0;
+        sys->growth_policy.chunk_entries = 0;
+        return 0;
+    }
+    if (policy->growth_percent <= 0 || policy->chunk_threshold < 0 ||
+        (policy->chunk_threshold > 0 && policy->chunk_entries <= 0)) {
+        return -1;
+    }
+    sys->growth_policy = *policy;
+    return 0;
+}
+
+int grown_capacity(const MissionControl* system, int capacity, int needed) {
+    const GrowthPolicy *policy = &MISSION_SYSTEM(system)->growth_policy;
+    long grown;
+    if (policy->chunk_threshold > 0 && capacity >= policy->chunk_threshold) {
+        grown = (long)capacity + policy->chunk_entries;
+    } else {
+        long step = (long)capacity * policy->growth_percent / 100;
+        grown = (long)capacity + (step > 0 ? step : 1);
+    }
+    if (grown < needed) {
+        grown = needed;
+    }
+    return grown < INT_MAX ? (int)grown : INT_MAX;
+}
+
+/* ===== SHARED MISSION SETUP ===== */
+
+static int is_valid_mission_fields(int mission_id, const char* name, const char* launch_date) {
+    return mission_id > 0 && name != NULL && name[0] != '\0' &&
+           launch_date != NULL && parse_date_to_epoch_day(launch_date, NULL);
+}
+
+/* ===== MISSION ARRAYS ===== */
+
+/*
+ * The missions array and, in the hot/cold layout, the cold side table
+ * parallel to it. Both always have system->capacity slots and are
+ * replaced together. So does system->mission_meta, but snapshots never
+ * read it, so it is always resized in place.
+ */
+typedef struct {
+    Mission *missions;
+#ifdef MISSION_HOT_COLD
+    MissionCold *cold;
+#endif
+} MissionArrays;
+
+static MissionArrays current_arrays(const MissionControl* system) {
+    MissionArrays arrays;
+    arrays.missions = system->missions;
+#ifdef MISSION_HOT_COLD
+    arrays.cold = MISSION_SYSTEM(system)->mission_cold;
+#endif
+    return arrays;
+}
+
+// Fresh copies of the first `count` entries, with room for `capacity`
+static int copy_arrays(const MissionControl* system, int capacity, int count,
+                       MissionArrays* out) {
+    out->missions = malloc(capacity * sizeof(Mission));
+#ifdef MISSION_HOT_COLD
+    out->cold = malloc(capacity * sizeof(MissionCold));
+    if (out->cold == NULL) {
+        free(out->missions);
+        return -1;
+    }
+    memcpy(out->cold, MISSION_SYSTEM(system)->mission_cold, count * sizeof(MissionCold));
+#endif
+    if (out->missions == NULL) {
+#ifdef MISSION_HOT_COLD
+        free(out->cold);
+#endif
+        return -1;
+    }
+    memcpy(out->missions, system->missions, count * sizeof(Mission));
+    return 0;
+}
+
+// Snapshot readers load the count first, so either array may be stored first
+static void publish_arrays(MissionControl* system, const MissionArrays* arrays) {
+#ifdef MISSION_HOT_COLD
+    __atomic_store_n(&MISSION_SYSTEM(system)->mission_cold, arrays->cold, __ATOMIC_SEQ_CST);
+#endif
+    __atomic_store_n(&system->missions, arrays->missions, __ATOMIC_SEQ_CST);
+}
+
+static void retire_arrays(MissionControl* system, const MissionArrays* arrays) {
+    retire_shared_array(system, arrays->missions);
+#ifdef MISSION_HOT_COLD
+    retire_shared_array(system, arrays->cold);
+#endif
+}
+
+void free_mission_arrays(MissionControl* system) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    free(system->missions);
+    system->missions = NULL;
+#ifdef MISSION_HOT_COLD
+    free(sys->mission_cold);
+    sys->mission_cold = NULL;
+#endif
+    free(sys->mission_meta);
+    sys->mission_meta = NULL;
+}
+
+/*
+ * Resize the missions array to exactly new_capacity slots. While snapshots
+ * are enabled the old array may still be read by a reporter, so it is
+ * copied instead of realloc()ed and retired once the new one is published.
+ */
+int resize_missions(MissionControl* system, int new_capacity) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    // On a later failure the resized side tables stay; capacity covers them
+    MissionMeta *meta = realloc(sys->mission_meta, new_capacity * sizeof(MissionMeta));
+    if (meta == NULL) {
+        return -1;
+    }
+    sys->mission_meta = meta;
+    if (sys->snapshots != NULL && snapshot_resize_marks(system, new_capacity) != 0) {
+        return -1;
+    }
+
+    MissionArrays old_arrays = current_arrays(system);
+    MissionArrays new_arrays;
+    if (sys->snapshots == NULL) {
+        new_arrays.missions = realloc(old_arrays.missions, new_capacity * sizeof(Mission));
+        if (new_arrays.missions == NULL) {
+            return -1;
+        }
+        system->missions = new_arrays.missions;
+#ifdef MISSION_HOT_COLD
+        // On failure the larger missions array stays; capacity covers both
+        new_arrays.cold = realloc(old_arrays.cold, new_capacity * sizeof(MissionCold));
+        if (new_arrays.cold == NULL) {
+            return -1;
+        }
+        sys->mission_cold = new_arrays.cold;
+#endif
+    } else if (copy_arrays(system, new_capacity, system->mission_count, &new_arrays) != 0) {
+        return -1;
+    }
+    METRICS_GROWTH(system, METRIC_GROWTH_MISSIONS, old_arrays.missions, new_arrays.missions,
+                   system->mission_count * sizeof(Mission));
+
+    system->capacity = new_capacity;
+    if (sys->snapshots != NULL) {
+        publish_arrays(system, &new_arrays);
+        retire_arrays(system, &old_arrays);
+    }
+    return 0;
+}
+
+// Fill the PLANNED mission at `position` around an already-allocated
+// communications buffer (NULL for a lazily created mission: its first
+// append allocates one)
+static void init_mission(MissionControl* system, int position, int mission_id, const char* name,
+                         const char* launch_date, CommLog* communications, int pooled) {
+    Mission *mission = &system->missions[position];
+    MissionCold *cold = MISSION_COLD(system, position);
+    MissionMeta *meta = MISSION_META(system, position);
+    mission->mission_id = mission_id;
+
+    strncpy(cold->mission_name, name, sizeof(cold->mission_name) - 1);
+    cold->mission_name[sizeof(cold->mission_name) - 1] = '\0';
+
+    strncpy(cold->launch_date, launch_date, sizeof(cold->launch_date) - 1);
+    cold->launch_date[sizeof(cold->launch_date) - 1] = '\0';
+
+    mission->status = PLANNED;
+    mission->communications = communications;
+    mission->comm_count = 0;
+    cold->comm_capacity = communications != NULL ? INITIAL_COMM_CAPACITY : 0;
+    meta->comm_pooled = pooled;
+    meta->comm_offset = 0;
+    meta->comm_appended = 0;
+    meta->compact_queued = 0;
+    meta->logs_unsorted = 0;
+}
+
+/*
+ * Append a validated, unique mission and publish it to the indexes.
+ * Returns its position, or -1 with `communications` still owned by the
+ * caller.
+ */
+static int append_mission(MissionControl* system, int mission_id, const char* name,
+                          const char* launch_date, CommLog* communications) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    if (system->mission_count >= system->capacity &&
+        resize_missions(system, grown_capacity(system, system->capacity,
+                                               system->mission_count + 1)) != 0) {
+        return -1;
+    }
+
+    int new_index = system->mission_count;
+    Mission *new_mission = &system->missions[new_index];
+    init_mission(system, new_index, mission_id, name, launch_date, communications, 0);
+
+    if (mission_index_insert(system, mission_id, new_index) != 0) {
+        new_mission->communications = NULL;
+        return -1;
+    }
+
+    // Mark and publish the mission before snapshots may see it (see snapshot.c)
+    if (sys->snapshots != NULL) {
+        snapshot_mark_missions(system, new_index, 1);
+    }
+    __atomic_store_n(&system->mission_count, new_index + 1, __ATOMIC_RELEASE);
+    if (sys->snapshots != NULL) {
+        snapshot_publish_missions(system);
+    }
+    if (sys->leaderboard != NULL) {
+        leaderboard_add_missions(system, new_index, 1);
+    }
+    if (sys->launch_index != NULL) {
+        launch_index_add_missions(system, new_index, 1);
+    }
+    if (sys->shared_view != NULL) {
+        shared_view_add_missions(system, new_index, 1);
+    }
+    return new_index;
+}
+
+int append_lazy_mission(MissionControl* system, int mission_id, const char* name,
+                        const char* launch_date) {
+    return append_mission(system, mission_id, name, launch_date, NULL);
+}
+
+/*
+ * Validate, check for a duplicate ID (pending lazily loaded missions
+ * included) and append with a fresh INITIAL_COMM_CAPACITY log array.
+ */
+int insert_mission(MissionControl* system, int mission_id, const char* name,
+                   const char* launch_date) {
+    if (system == NULL || !is_valid_mission_fields(mission_id, name, launch_date)) {
+        return -1;
+    }
+
+    if (mission_index_find(system, mission_id) >= 0 ||
+        (MISSION_SYSTEM(system)->catalog != NULL && catalog_is_pending(system, mission_id))) {
+        return -1;
+    }
+
+    CommLog *communications = calloc(INITIAL_COMM_CAPACITY, sizeof(CommLog));
+    if (communications == NULL) {
+        return -1;
+    }
+    if (append_mission(system, mission_id, name, launch_date, communications) < 0) {
+        free(communications);
+        return -1;
+    }
+    return 0;
+}
+
+/* ===== CAPACITY RESERVATION ===== */
+
+int reserve_missions(MissionControl* system, int capacity) {
+    if (system == NULL || capacity <= 0) {
+        return -1;
+    }
+    if (capacity > system->capacity && resize_missions(system, capacity) != 0) {
+        return -1;
+    }
+    return mission_index_reserve(system, capacity);
+}
+
+/* ===== BULK CREATION ===== */
+
+// Take ownership of a shared comm block; freed only by free_mission_control()
+static int register_comm_pool(MissionControl* system, CommLog* pool) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    if (sys->comm_pool_count >= sys->comm_pool_capacity) {
+        int new_capacity = sys->comm_pool_capacity > 0 ? sys->comm_pool_capacity * 2 : 4;
+        CommLog **new_pools = realloc(sys->comm_pools, new_capacity * sizeof(CommLog*));
+        if (new_pools == NULL) {
+            return -1;
+        }
+        sys->comm_pools = new_pools;
+        sys->comm_pool_capacity = new_capacity;
+    }
+    sys->comm_pools[sys->comm_pool_count++] = pool;
+    return 0;
+}
+
+void free_comm_pools(MissionControl* system) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    for (int i = 0; i < sys->comm_pool_count; i++) {
+        free(sys->comm_pools[i]);
+    }
+    free(sys->comm_pools);
+    sys->comm_pools = NULL;
+    sys->comm_pool_count = 0;
+    sys->comm_pool_capacity = 0;
+    sys->comm_pool_bytes = 0;
+}
+
+int create_missions_bulk(MissionControl* system, const MissionSpec* specs, int count) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    if (system == NULL || count < 0 || (specs == NULL && count > 0)) {
+        return -1;
+    }
+    if (count == 0) {
+        return 0;
+    }
+    if (count > INT_MAX / 2 - system->mission_count) {
+        return -1;
+    }
+    // Grow per the policy so repeated small batches stay amortised O(1)
+    int needed = system->mission_count + count;
+    if (needed > system->capacity &&
+        resize_missions(system, grown_capacity(system, system->capacity, needed)) != 0) {
+        return -1;
+    }
+    if (mission_index_reserve(system, needed) != 0) {
+        return -1;
+    }
+
+    // Pass 1: validate and index the accepted prefix. Indexing as we go
+    // also rejects IDs repeated within the batch.
+    int base = system->mission_count;
+    int accepted = 0;
+    while (accepted < count) {
+        const MissionSpec *spec = &specs[accepted];
+        Mission *slot = &system->missions[base + accepted];
+        if (!is_valid_mission_fields(spec->mission_id, spec->name, spec->launch_date) ||
+            mission_index_find(system, spec->mission_id) >= 0 ||
+            (sys->catalog != NULL && catalog_is_pending(system, spec->mission_id))) {
+            break;
+        }
+        slot->mission_id = spec->mission_id;
+        if (mission_index_insert(system, spec->mission_id, base + accepted) != 0) {
+            break;
+        }
+        accepted++;
+    }
+    if (accepted == 0) {
+        return 0;
+    }
+
+    // One zeroed block backs the initial comm buffer of every new mission
+    size_t pool_bytes = (size_t)accepted * INITIAL_COMM_CAPACITY * sizeof(CommLog);
+    CommLog *pool = calloc((size_t)accepted * INITIAL_COMM_CAPACITY, sizeof(CommLog));
+    if (pool == NULL || register_comm_pool(system, pool) != 0) {
+        free(pool);
+        for (int i = 0; i < accepted; i++) {
+            mission_index_remove(system, specs[i].mission_id);
+        }
+        return -1;
+    }
+    sys->comm_pool_bytes += pool_bytes;
+
+    // Pass 2: fill in the missions, then publish them as one step
+    for (int i = 0; i < accepted; i++) {
+        init_mission(system, base + i, specs[i].mission_id, specs[i].name, specs[i].launch_date,
+                     pool + (size_t)i * INITIAL_COMM_CAPACITY, 1);
+    }
+    if (sys->snapshots != NULL) {
+        snapshot_mark_missions(system, base, accepted);
+    }
+    __atomic_store_n(&system->mission_count, base + accepted, __ATOMIC_RELEASE);
+    if (sys->snapshots != NULL) {
+        snapshot_publish_missions(system);
+    }
+    if (sys->leaderboard != NULL) {
+        leaderboard_add_missions(system, base, accepted);
+    }
+    if (sys->launch_index != NULL) {
+        launch_index_add_missions(system, base, accepted);
+    }
+    if (sys->shared_view != NULL) {
+        shared_view_add_missions(system, base, accepted);
+    }
+    return accepted;
+}
+
+/* ===== REMOVAL ===== */
+
+/*
+ * Swap-remove: the last mission moves into the freed position, so each
+ * structure keyed by position is patched for two entries instead of being
+ * rebuilt. The hooks run first, while both missions are still in place.
+ * While snapshots are enabled a reader may hold the array, so the move is
+ * made in a copy that replaces it, as in resize_missions().
+ */
+int remove_mission(MissionControl* system, int mission_id) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    if (system == NULL) {
+        return -1;
+    }
+    int position = mission_index_find(system, mission_id);
+    if (position < 0) {
+        // A pending catalog mission has nothing else to undo
+        return sys->catalog != NULL ? catalog_remove(system, mission_id) : -1;
+    }
+    if (sys->report_service != NULL) {
+        report_service_capture_queued(system);
+    }
+    int last = system->mission_count - 1;
+    MissionArrays old_arrays = current_arrays(system);
+    MissionArrays new_arrays = old_arrays;
+    // Copied even when removing the last mission: a snapshot may hold
+    // that slot, and the next creation would reuse it
+    if (sys->snapshots != NULL && copy_arrays(system, system->capacity, last, &new_arrays) != 0) {
+        return -1;
+    }
+
+    Mission *removed = &old_arrays.missions[position];
+    MissionMeta *meta = sys->mission_meta;
+    if (sys->leaderboard != NULL) {
+        leaderboard_remove_mission(system, position);
+    }
+    if (sys->launch_index != NULL) {
+        launch_index_remove(system, position);
+    }
+    if (sys->shared_view != NULL) {
+        shared_view_remove_mission(system, position);
+    }
+    if (sys->rollups != NULL) {
+        rollups_remove_mission(system, position);
+    }
+    if (sys->dedup != NULL) {
+        dedup_remove_mission(system, position);
+    }
+    if (sys->reorder != NULL) {
+        reorder_remove_mission(system, position);
+    }
+    if (sys->catalog != NULL) {
+        catalog_remove(system, mission_id);
+    }
+    log_directory_drop(system, removed->communications, removed->comm_count);
+    mission_index_remove(system, mission_id);
+    if (last != position) {
+        mission_index_relocate(system, old_arrays.missions[last].mission_id, last, position);
+    }
+
+    CommLog *comm_base = removed->communications - meta[position].comm_offset;
+    int comm_pooled = meta[position].comm_pooled;
+    meta[position] = meta[last];
+
+    layout_change_begin(system);
+    if (last != position) {
+        new_arrays.missions[position] = old_arrays.missions[last];
+#ifdef MISSION_HOT_COLD
+        new_arrays.cold[position] = old_arrays.cold[last];
+#endif
+        if (sys->snapshots != NULL) {
+            snapshot_move_mark(system, last, position);
+        }
+    }
+    if (new_arrays.missions != old_arrays.missions) {
+        publish_arrays(system, &new_arrays);
+    }
+    __atomic_store_n(&system->mission_count, last, __ATOMIC_SEQ_CST);
+    layout_change_end(system);
+
+    if (new_arrays.missions != old_arrays.missions) {
+        retire_arrays(system, &old_arrays);
+    }
+    release_comm_buffer(system, comm_base, comm_pooled);
+    return 0;
+}
+
+/* ===== FEATURE SIDE TABLES ===== */
+
+void* side_table_get(const MissionSideTable* table, int position) {
+    return position < table->capacity ? table->entries[position] : NULL;
+}
+
+int side_table_set(MissionSideTable* table, const MissionControl* system, int position,
+                   void* entry) {
+    if (position >= table->capacity) {
+        int capacity = system->capacity > position ? system->capacity : position + 1;
+        void **grown = realloc(table->entries, (size_t)capacity * sizeof(void*));
+        if (grown == NULL) {
+            return -1;
+        }
+        for (int i = table->capacity; i < capacity; i++) {
+            grown[i] = NULL;
+        }
+        table->entries = grown;
+        table->capacity = capacity;
+    }
+    table->entries[position] = entry;
+    return 0;
+}
+
+void* side_table_take(MissionSideTable* table, int position, int last) {
+    void *taken = side_table_get(table, position);
+    if (position < table->capacity) {
+        table->entries[position] = side_table_get(table, last);
+    }
+    // The last slot is reused by the next mission created
+    if (last < table->capacity) {
+        table->entries[last] = NULL;
+    }
+    return taken;
+}
+
+void side_table_free(MissionSideTable* table) {
+    free(table->entries);
+    table->entries = NULL;
+    table->capacity = 0;
+}
+
+void side_table_memory(const MissionSideTable* table, MemoryFigure* figure) {
+    size_t bytes = (size_t)table->capacity * sizeof(void*);
+    figure->used += bytes;
+    figure->reserved += bytes;
+}
+
+/* ===== LAYOUT ===== */
+
+const MissionCold* mission_cold_at(const MissionControl* system, int position) {
+    if (system == NULL || position < 0 || position >= system->mission_count) {
+        return NULL;
+    }
+    return MISSION_COLD(system, position);
+}
+
+/* ===== TOTALS ===== */
+
+int get_mission_totals(const MissionControl* system, MissionTotals* out) {
+    if (system == NULL || out == NULL) {
+        return -1;
+    }
+    memset(out, 0, sizeof(MissionTotals));
+    for (int i = 0; i < system->mission_count; i++) {
+        const Mission *mission = &system->missions[i];
+        if (mission->status >= PLANNED && mission->status <= ABORTED) {
+            out->by_status[mission->status]++;
+        }
+        out->communications += mission->comm_count;
+    }
+    // Pending catalog missions are PLANNED and have no logs yet
+    int pending = pending_mission_count(system);
+    out->by_status[PLANNED] += pending;
+    out->missions = system->mission_count + pending;
+    return 0;
+}
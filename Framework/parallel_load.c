@@ -0,0 +1,513 @@
+/**
+ * @file parallel_load.c
+ * @brief Space Mission Control System - Concurrent Mission Loading
+ *
+ * load_missions_from_files() parses every file on the thread pool into a
+ * private record buffer, then merges the buffers on the calling thread in
+ * list order. Parsing is the expensive part and scales with cores; the
+ * merge is O(1) per record thanks to the mission ID index.
+ *
+ * load_missions_from_file_parallel() splits one large file into chunks
+ * at newline boundaries and parses the chunks concurrently, inserting in
+ * file order so results match load_missions_from_file() exactly.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mission_internal.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+
+/* ========================================
+ * PER-FILE PARSE STATE
+ * ======================================== */
+typedef struct {
+    const char* filename;
+    MissionRecord* records;     // Parsed records in file order
+    int record_count;
+    int record_capacity;
+    int alloc_failed;
+    LoadFileSummary summary;
+} FileParse;
+
+typedef struct {
+    FileParse* files;
+} LoadJob;
+
+static int append_record(FileParse* file, const MissionRecord* record) {
+    if (file->record_count >= file->record_capacity) {
+        int new_capacity = file->record_capacity > 0 ? file->record_capacity * 2 : 64;
+        MissionRecord* grown = realloc(file->records, (size_t)new_capacity * sizeof(MissionRecord));
+        if (grown == NULL) {
+            return -1;
+        }
+        file->records = grown;
+        file->record_capacity = new_capacity;
+    }
+    file->records[file->record_count++] = *record;
+    return 0;
+}
+
+// Thread pool task: parse file `index` without touching the shared system
+static void parse_file_task(void* context, int index) {
+    FileParse* file = &((LoadJob*)context)->files[index];
+    LoadFileSummary* summary = &file->summary;
+
+    FILE* fp = fopen(file->filename, "r");
+    if (fp == NULL) {
+        summary->status = LOAD_FILE_OPEN_FAILED;
+        return;
+    }
+
+    if (fscanf(fp, "%d", &summary->declared) != 1 || summary->declared < 0) {
+        summary->status = LOAD_FILE_BAD_HEADER;
+        fclose(fp);
+        return;
+    }
+
+    MissionRecord record;
+    for (int i = 0; i < summary->declared; i++) {
+        if (!read_mission_record(fp, &record)) {
+            summary->status = LOAD_FILE_TRUNCATED;
+            summary->error_record = i + 1;
+            break;
+        }
+        summary->parsed++;
+        if (!is_valid_mission_record(&record)) {
+            summary->invalid++;
+            continue;
+        }
+        if (append_record(file, &record) != 0) {
+            file->alloc_failed = 1;
+            break;
+        }
+    }
+    fclose(fp);
+}
+
+/* ========================================
+ * MERGE
+ * ======================================== */
+static int merge_files(MissionControl* system, FileParse* files, int file_count) {
+    long total = system->mission_count;
+    for (int f = 0; f < file_count; f++) {
+        total += files[f].record_count;
+    }
+    if (total > 0x3fffffff) {
+        return -1;
+    }
+    // Size the missions array and ID index once so the merge never grows them
+    if (total > 0 && reserve_missions(system, (int)total) != 0) {
+        return -1;
+    }
+
+    int max_records = 0;
+    for (int f = 0; f < file_count; f++) {
+        if (files[f].record_count > max_records) {
+            max_records = files[f].record_count;
+        }
+    }
+    MissionSpec* specs = malloc((size_t)(max_records > 0 ? max_records : 1) * sizeof(MissionSpec));
+    if (specs == NULL) {
+        return -1;
+    }
+
+    int result = 0;
+    for (int f = 0; f < file_count && result == 0; f++) {
+        FileParse* file = &files[f];
+        for (int r = 0; r < file->record_count; r++) {
+            specs[r].mission_id = file->records[r].mission_id;
+            specs[r].name = file->records[r].mission_name;
+            specs[r].launch_date = file->records[r].launch_date;
+        }
+        // Records are pre-validated, so a bulk insert only stops at an ID
+        // that earlier files or pre-existing missions already claimed
+        int next = 0;
+        while (next < file->record_count) {
+            int created = create_missions_bulk(system, specs + next, file->record_count - next);
+            if (created < 0) {
+                result = -1;
+                break;
+            }
+            file->summary.loaded += created;
+            next += created;
+            if (next < file->record_count) {
+                file->summary.duplicates++;
+                next++;
+            }
+        }
+    }
+    free(specs);
+    return result;
+}
+
+/* ========================================
+ * PUBLIC API
+ * ======================================== */
+int load_missions_from_files(MissionControl* system, const char* const* filenames,
+                             int file_count, int thread_count, LoadFileSummary* summaries) {
+    if (system == NULL || filenames == NULL || file_count < 0) {
+        return -1;
+    }
+    for (int f = 0; f < file_count; f++) {
+        if (filenames[f] == NULL || filenames[f][0] == '\0') {
+            return -1;
+        }
+    }
+    if (file_count == 0) {
+        return 0;
+    }
+
+    FileParse* files = calloc((size_t)file_count, sizeof(FileParse));
+    if (files == NULL) {
+        return -1;
+    }
+    for (int f = 0; f < file_count; f++) {
+        files[f].filename = filenames[f];
+        files[f].summary.status = LOAD_FILE_OK;
+    }
+
+    if (thread_count <= 0) {
+        thread_count = online_cpu_count();
+    }
+    LoadJob job = { files };
+    run_parallel_tasks(file_count, thread_count, parse_file_task, &job);
+
+    int result = 0;
+    for (int f = 0; f < file_count; f++) {
+        if (files[f].alloc_failed) {
+            result = -1;
+        }
+    }
+    if (result == 0 && merge_files(system, files, file_count) != 0) {
+        result = -1;
+    }
+
+    for (int f = 0; f < file_count; f++) {
+        if (files[f].summary.status != LOAD_FILE_OK || files[f].summary.invalid > 0) {
+            result = -1;
+        }
+        if (summaries != NULL) {
+            summaries[f] = files[f].summary;
+        }
+        free(files[f].records);
+    }
+    free(files);
+    return result;
+}
+
+/* ========================================
+ * INTRA-FILE PARALLEL PARSING
+ * ========================================
+ * The serial loader reads a token stream with fscanf(), so records may in
+ * principle span or share lines. The chunked parser only handles the
+ * regular layout of one "id name date" record per line (blank lines
+ * allowed). At the first line that does not fit, the chunk stops and the
+ * remaining records are read by fscanf() from that line's byte offset,
+ * which yields exactly the serial loader's results and error return.
+ */
+#define CHUNK_BYTES (4 << 20)   // Bytes parsed per task in each window
+
+typedef struct {
+    MissionRecord record;
+    int valid;                  // is_valid_mission_record() result
+} ParsedRecord;
+
+typedef struct {
+    const char* begin;          // First byte of the chunk (start of a line)
+    const char* end;            // One past the last byte (after a newline or EOF)
+    ParsedRecord* records;      // Records in chunk order
+    int count;
+    int capacity;
+    const char* irregular;      // Start of the first line that needs fscanf(), or NULL
+    int alloc_failed;
+} Chunk;
+
+typedef struct {
+    Chunk* chunks;
+} ChunkJob;
+
+static int is_blank(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+// Strict %d equivalent: optional sign, 1-10 digits, must fit in an int
+static int parse_int_token(const char* token, size_t length, int* out) {
+    size_t i = 0;
+    int negative = 0;
+    if (length > 0 && (token[0] == '-' || token[0] == '+')) {
+        negative = (token[0] == '-');
+        i = 1;
+    }
+    if (i == length || length - i > 10) {
+        return 0;
+    }
+    long value = 0;
+    for (; i < length; i++) {
+        if (token[i] < '0' || token[i] > '9') {
+            return 0;
+        }
+        value = value * 10 + (token[i] - '0');
+    }
+    value = negative ? -value : value;
+    if (value > 2147483647L || value < -2147483647L - 1) {
+        return 0;
+    }
+    *out = (int)value;
+    return 1;
+}
+
+// Parses one line into `record`. Returns 1 for a record, 0 for a blank
+// line, -1 if the line is irregular.
+static int parse_line(const char* p, const char* line_end, MissionRecord* record) {
+    const char* tokens[4];
+    size_t lengths[4];
+    int token_count = 0;
+
+    while (p < line_end) {
+        while (p < line_end && is_blank(*p)) {
+            p++;
+        }
+        if (p == line_end) {
+            break;
+        }
+        if (token_count == 3) {
+            return -1;
+        }
+        tokens[token_count] = p;
+        while (p < line_end && !is_blank(*p)) {
+            p++;
+        }
+        lengths[token_count] = (size_t)(p - tokens[token_count]);
+        token_count++;
+    }
+
+    if (token_count == 0) {
+        return 0;
+    }
+    if (token_count != 3 || lengths[1] >= MAX_NAME_LENGTH || lengths[2] >= MAX_DATE_LENGTH ||
+        !parse_int_token(tokens[0], lengths[0], &record->mission_id)) {
+        return -1;
+    }
+    memcpy(record->mission_name, tokens[1], lengths[1]);
+    record->mission_name[lengths[1]] = '\0';
+    memcpy(record->launch_date, tokens[2], lengths[2]);
+    record->launch_date[lengths[2]] = '\0';
+    return 1;
+}
+
+static void parse_chunk_task(void* context, int index) {
+    Chunk* chunk = &((ChunkJob*)context)->chunks[index];
+    const char* p = chunk->begin;
+
+    while (p < chunk->end) {
+        const char* line_end = memchr(p, '\n', (size_t)(chunk->end - p));
+        if (line_end == NULL) {
+            line_end = chunk->end;
+        }
+
+        MissionRecord record;
+        int kind = parse_line(p, line_end, &record);
+        if (kind < 0) {
+            chunk->irregular = p;
+            return;
+        }
+        if (kind > 0) {
+            if (chunk->count >= chunk->capacity) {
+                int new_capacity = chunk->capacity > 0 ? chunk->capacity * 2 : 1024;
+                ParsedRecord* grown = realloc(chunk->records,
+                                              (size_t)new_capacity * sizeof(ParsedRecord));
+                if (grown == NULL) {
+                    chunk->alloc_failed = 1;
+                    return;
+                }
+                chunk->records = grown;
+                chunk->capacity = new_capacity;
+            }
+            ParsedRecord* parsed = &chunk->records[chunk->count++];
+            parsed->record = record;
+            parsed->valid = is_valid_mission_record(&record);
+        }
+        p = line_end + 1;
+    }
+}
+
+static const char* next_line_start(const char* p, const char* end) {
+    const char* newline = memchr(p, '\n', (size_t)(end - p));
+    return newline != NULL ? newline + 1 : end;
+}
+
+// Serial tail: the remaining records starting at byte `offset`
+static int load_serial_from(MissionControl* system, const char* filename, long offset,
+                            int remaining) {
+    FILE* fp = fopen(filename, "r");
+    if (fp == NULL || fseek(fp, offset, SEEK_SET) != 0) {
+        if (fp != NULL) {
+            fclose(fp);
+        }
+        return -1;
+    }
+    MissionRecord record;
+    for (int i = 0; i < remaining; i++) {
+        if (!read_mission_record(fp, &record) || !is_valid_mission_record(&record) ||
+            create_mission_with_crew(system, record.mission_id, record.mission_name,
+                                     record.launch_date) != 0) {
+            fclose(fp);
+            return -1;
+        }
+    }
+    fclose(fp);
+    return 0;
+}
+
+// Parses and inserts records from [data, end) in windows of thread_count
+// chunks so the record buffers stay bounded however large the file is.
+static int load_chunked(MissionControl* system, const char* filename, const char* base,
+                        const char* data, const char* end, int remaining, int thread_count) {
+    Chunk* chunks = calloc((size_t)thread_count, sizeof(Chunk));
+    if (chunks == NULL) {
+        return -1;
+    }
+    MissionSpec* specs = NULL;
+    int spec_capacity = 0;
+
+    int result = 0;
+    while (remaining > 0) {
+        if (data >= end) {
+            result = -1;    // Fewer records than the header declared
+            break;
+        }
+
+        // Carve the next window into per-thread chunks at line boundaries
+        int chunk_count = 0;
+        const char* p = data;
+        while (chunk_count < thread_count && p < end) {
+            const char* chunk_end = (end - p > CHUNK_BYTES) ? next_line_start(p + CHUNK_BYTES, end) : end;
+            chunks[chunk_count].begin = p;
+            chunks[chunk_count].end = chunk_end;
+            chunks[chunk_count].count = 0;
+            chunks[chunk_count].irregular = NULL;
+            chunk_count++;
+            p = chunk_end;
+        }
+
+        ChunkJob job = { chunks };
+        run_parallel_tasks(chunk_count, thread_count, parse_chunk_task, &job);
+
+        // Insert in file order, exactly as the serial loader would
+        const char* resume_at = NULL;
+        for (int c = 0; c < chunk_count && remaining > 0 && result == 0; c++) {
+            Chunk* chunk = &chunks[c];
+            if (chunk->alloc_failed) {
+                result = -1;
+                break;
+            }
+            if (chunk->count > spec_capacity) {
+                MissionSpec* grown = realloc(specs, (size_t)chunk->count * sizeof(MissionSpec));
+                if (grown == NULL) {
+                    result = -1;
+                    break;
+                }
+                specs = grown;
+                spec_capacity = chunk->count;
+            }
+            // Valid prefix of the chunk (up to the declared count) in one bulk insert
+            int take = chunk->count < remaining ? chunk->count : remaining;
+            int valid = 0;
+            while (valid < take && chunk->records[valid].valid) {
+                specs[valid].mission_id = chunk->records[valid].record.mission_id;
+                specs[valid].name = chunk->records[valid].record.mission_name;
+                specs[valid].launch_date = chunk->records[valid].record.launch_date;
+                valid++;
+            }
+            int created = create_missions_bulk(system, specs, valid);
+            if (created != take) {
+                result = -1;
+                break;
+            }
+            remaining -= created;
+            if (result == 0 && remaining > 0 && chunk->irregular != NULL) {
+                resume_at = chunk->irregular;
+                break;
+            }
+        }
+
+        if (result != 0 || remaining == 0) {
+            break;
+        }
+        if (resume_at != NULL) {
+            result = load_serial_from(system, filename, (long)(resume_at - base), remaining);
+            break;
+        }
+        data = p;
+    }
+
+    for (int c = 0; c < thread_count; c++) {
+        free(chunks[c].records);
+    }
+    free(chunks);
+    free(specs);
+    return result;
+}
+
+int load_missions_from_file_parallel(MissionControl* system, const char* filename,
+                                     int thread_count) {
+    if (system == NULL || filename == NULL || filename[0] == '\0') {
+        return -1;
+    }
+
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return load_missions_from_file(system, filename);
+    }
+    size_t size = (size_t)st.st_size;
+    char* base = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        return load_missions_from_file(system, filename);
+    }
+    posix_madvise(base, size, POSIX_MADV_SEQUENTIAL);
+
+    const char* end = base + size;
+    const char* p = base;
+
+    // Header: same acceptance as fscanf("%d")
+    while (p < end && (is_blank(*p) || *p == '\n')) {
+        p++;
+    }
+    const char* number = p;
+    if (p < end && (*p == '-' || *p == '+')) {
+        p++;
+    }
+    while (p < end && *p >= '0' && *p <= '9') {
+        p++;
+    }
+    int declared = 0;
+    int result;
+    if (!parse_int_token(number, (size_t)(p - number), &declared) || declared < 0) {
+        result = -1;
+    } else if (declared == 0) {
+        result = 0;
+    } else {
+        if (thread_count <= 0) {
+            thread_count = online_cpu_count();
+        }
+        // Bound the reservation by what the file could possibly hold: a
+        // record takes at least 14 bytes
+        long max_records = (long)(size / 14) + 1;
+        int expected = declared < max_records ? declared : (int)max_records;
+        if (system->mission_count + (long)expected <= 0x3fffffff) {
+            reserve_missions(system, system->mission_count + expected);
+        }
+        result = load_chunked(system, filename, base, p, end, declared, thread_count);
+    }
+
+    munmap(base, size);
+    return result;
+}
@@ -0,0 +1,629 @@
+/**
+ * @file parallel_replay.c
+ * @brief Space Mission Control System - Parallel Command-Stream Replay
+ *
+ * Runs a driver command file (the TEST_* format) with independent missions
+ * in parallel. TEST_CREATE_MISSION and TEST_ADD_COMM only depend on earlier
+ * commands for the same mission, so between two system-level commands
+ * (create/load/save/free system), which act as barriers, each mission's
+ * commands form a chain that only has to stay in file order.
+ *
+ * The core is single-writer, so the system is split into lanes: independent
+ * MissionControls, each owning the missions whose ID hashes to it. A lane's
+ * commands for one segment are one task; workers claim tasks from the
+ * thread pool, and having several lanes per thread lets idle workers pick
+ * up the remaining lanes when the chains are uneven. Barriers run on the
+ * calling thread once every lane is done.
+ *
+ * Each lane remembers where in the command stream every mission was
+ * created, so reports list missions in the order a sequential replay would
+ * have inserted them and match save_mission_report() byte for byte. A load
+ * is validated in file order before its records are split over the lanes,
+ * so one that hits a duplicate ID inserts exactly the records before it.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mission_internal.h"
+
+#include <stdint.h>
+
+#define REPLAY_LANES_PER_THREAD 8
+#define REPLAY_NOT_RUN (-1)
+
+typedef enum {
+    OP_CREATE_SYSTEM,
+    OP_CREATE_MISSION,
+    OP_ADD_COMM,
+    OP_LOAD_FILE,
+    OP_SAVE_REPORT,
+    OP_FREE_SYSTEM
+} ReplayOpType;
+
+typedef struct {
+    ReplayOpType type;
+    int number;             // Capacity, or mission ID
+    int priority;
+    const char *text[2];    // name/date, timestamp/message, or file name
+    const char *keyword;
+    long line_number;
+    signed char expect_success;
+    signed char result;     // 1, 0, or REPLAY_NOT_RUN
+} ReplayOp;
+
+typedef struct {
+    MissionControl *system;
+    uint64_t *order_keys;   // order_keys[i]: stream position that created missions[i]
+    int key_capacity;
+    int first;              // This segment's commands: routed[first .. first + count)
+    int count;
+} ReplayLane;
+
+typedef struct {
+    ReplayOp *ops;
+    long op_count;
+    ReplayLane *lanes;
+    int lane_count;
+    int has_system;
+    int *routed;            // Segment commands grouped by lane, file order within a lane
+    int *busy;              // Lanes with work in the current segment
+    int thread_count;
+    const ParallelReplayConfig *config;
+} Replay;
+
+/* ========================================
+ * PARSING
+ * ======================================== */
+// Returns the next whitespace-delimited token (NUL-terminated in place)
+char* replay_next_token(ReplayArgs* args) {
+    char *p = args->cursor;
+    while (*p == ' ' || *p == '\t') {
+        p++;
+    }
+    if (*p == '\0' || *p == '#') {
+        args->cursor = p;
+        return NULL;
+    }
+    char *start = p;
+    while (*p != '\0' && *p != ' ' && *p != '\t') {
+        p++;
+    }
+    if (*p != '\0') {
+        *p++ = '\0';
+    }
+    args->cursor = p;
+    return start;
+}
+
+int replay_next_int(ReplayArgs* args, int* out) {
+    char *token = replay_next_token(args);
+    if (token == NULL) {
+        return 0;
+    }
+    char *end;
+    long value = strtol(token, &end, 10);
+    if (end == token) {
+        return 0;
+    }
+    *out = (int)value;
+    return 1;
+}
+
+// Expected results are SUCCESS or FAILURE; the first letter decides
+int replay_next_expected(ReplayArgs* args, int* expect_success) {
+    char *token = replay_next_token(args);
+    if (token == NULL) {
+        return 0;
+    }
+    *expect_success = (token[0] == 'S');
+    return 1;
+}
+
+static const struct {
+    const char *keyword;
+    ReplayOpType type;
+} g_keywords[] = {
+    { "TEST_ADD_COMM", OP_ADD_COMM },
+    { "TEST_CREATE_MISSION", OP_CREATE_MISSION },
+    { "TEST_CREATE_SYSTEM", OP_CREATE_SYSTEM },
+    { "TEST_LOAD_FILE", OP_LOAD_FILE },
+    { "TEST_SAVE_REPORT", OP_SAVE_REPORT },
+    { "TEST_FREE_SYSTEM", OP_FREE_SYSTEM },
+};
+
+static int expected(ReplayArgs* args, ReplayOp* op) {
+    int expect_success;
+    if (!replay_next_expected(args, &expect_success)) {
+        return 0;
+    }
+    op->expect_success = (signed char)expect_success;
+    return 1;
+}
+
+// Same argument rules and conversions as the driver's replay mode; 0 if malformed
+static int parse_op(char* line, ReplayOp* op) {
+    ReplayArgs args = { line };
+    char *keyword = replay_next_token(&args);
+    int found = 0;
+    for (size_t i = 0; keyword != NULL && i < sizeof(g_keywords) / sizeof(g_keywords[0]); i++) {
+        if (strcmp(keyword, g_keywords[i].keyword) == 0) {
+            op->type = g_keywords[i].type;
+            op->keyword = g_keywords[i].keyword;
+            found = 1;
+            break;
+        }
+    }
+    if (!found) {
+        return 0;
+    }
+
+    char *a, *b;
+    switch (op->type) {
+        case OP_CREATE_SYSTEM:
+            return replay_next_int(&args, &op->number) && expected(&args, op);
+        case OP_CREATE_MISSION:
+            if (!replay_next_int(&args, &op->number) || (a = replay_next_token(&args)) == NULL ||
+                (b = replay_next_token(&args)) == NULL || !expected(&args, op)) {
+                return 0;
+            }
+            a[strnlen(a, MAX_NAME_LENGTH - 1)] = '\0';
+            op->text[0] = a;
+            op->text[1] = b;
+            return 1;
+        case OP_ADD_COMM:
+            if (!replay_next_int(&args, &op->number) || (a = replay_next_token(&args)) == NULL ||
+                !replay_next_int(&args, &op->priority) || (b = replay_next_token(&args)) == NULL ||
+                !expected(&args, op)) {
+                return 0;
+            }
+            // "YYYY-MM-DD_HH:MM" -> "YYYY-MM-DD HH:MM"
+            char *underscore = strchr(a, '_');
+            if (underscore != NULL) {
+                *underscore = ' ';
+            }
+            a[strnlen(a, MAX_TIMESTAMP_LENGTH - 1)] = '\0';
+            b[strnlen(b, MAX_MESSAGE_LENGTH - 1)] = '\0';
+            op->text[0] = a;
+            op->text[1] = b;
+            return 1;
+        case OP_LOAD_FILE:
+        case OP_SAVE_REPORT:
+            op->text[0] = replay_next_token(&args);
+            return op->text[0] != NULL && expected(&args, op);
+        case OP_FREE_SYSTEM:
+            return expected(&args, op);
+    }
+    return 0;
+}
+
+// Reads the whole file and parses every command line into ops (pointing into *buffer)
+static int parse_file(const char* filename, char** buffer, Replay* replay, long* malformed) {
+    FILE *fp = fopen(filename, "r");
+    if (fp == NULL) {
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fileno(fp), &st) != 0 || st.st_size < 0) {
+        fclose(fp);
+        return -1;
+    }
+    size_t size = (size_t)st.st_size;
+    char *text = malloc(size + 1);
+    if (text == NULL) {
+        fclose(fp);
+        return -1;
+    }
+    size = fread(text, 1, size, fp);
+    fclose(fp);
+    text[size] = '\0';
+
+    size_t lines = 1;
+    for (size_t i = 0; i < size; i++) {
+        lines += (text[i] == '\n');
+    }
+    replay->ops = malloc(lines * sizeof(ReplayOp));
+    if (replay->ops == NULL) {
+        free(text);
+        return -1;
+    }
+
+    long line_number = 0;
+    for (char *line = text; line < text + size; ) {
+        char *end = strchr(line, '\n');
+        char *next = end != NULL ? end + 1 : text + size;
+        if (end != NULL) {
+            *end = '\0';
+        }
+        line_number++;
+        if (line[0] != '#' && line[0] != '\0') {
+            ReplayOp *op = &replay->ops[replay->op_count];
+            op->line_number = line_number;
+            op->result = REPLAY_NOT_RUN;
+            if (parse_op(line, op)) {
+                replay->op_count++;
+            } else {
+                (*malformed)++;
+            }
+        }
+        line = next;
+    }
+    *buffer = text;
+    return 0;
+}
+
+/* ========================================
+ * LANES
+ * ======================================== */
+static int lane_of(const Replay* replay, int mission_id) {
+    // Fibonacci hash, then scale to [0, lane_count) without a division
+    uint32_t hash = (uint32_t)mission_id * 2654435769u;
+    return (int)(((uint64_t)hash * (uint32_t)replay->lane_count) >> 32);
+}
+
+static uint64_t order_key(long op_index, int ordinal) {
+    return ((uint64_t)op_index << 32) | (uint32_t)ordinal;
+}
+
+static int reserve_keys(ReplayLane* lane, int needed) {
+    if (needed <= lane->key_capacity) {
+        return 0;
+    }
+    int capacity = lane->key_capacity > 0 ? lane->key_capacity : 16;
+    while (capacity < needed) {
+        capacity *= 2;
+    }
+    uint64_t *keys = realloc(lane->order_keys, (size_t)capacity * sizeof(uint64_t));
+    if (keys == NULL) {
+        return -1;
+    }
+    lane->order_keys = keys;
+    lane->key_capacity = capacity;
+    return 0;
+}
+
+static void free_lanes(Replay* replay) {
+    for (int i = 0; i < replay->lane_count; i++) {
+        free_mission_control(replay->lanes[i].system);
+        free(replay->lanes[i].order_keys);
+        replay->lanes[i].system = NULL;
+        replay->lanes[i].order_keys = NULL;
+        replay->lanes[i].key_capacity = 0;
+    }
+    replay->has_system = 0;
+}
+
+// create_mission_control(capacity) split across the lanes
+static int create_lanes(Replay* replay, int capacity) {
+    int per_lane = capacity > replay->lane_count ? capacity / replay->lane_count : 1;
+    for (int i = 0; i < replay->lane_count; i++) {
+        replay->lanes[i].system = create_mission_control(capacity > 0 ? per_lane : capacity);
+        if (replay->lanes[i].system == NULL) {
+            free_lanes(replay);
+            return -1;
+        }
+    }
+    replay->has_system = 1;
+    return 0;
+}
+
+/* ========================================
+ * MISSION COMMANDS (run inside a lane)
+ * ======================================== */
+static int cancelled(const Replay* replay) {
+    return replay->config->cancel != NULL &&
+           __atomic_load_n(replay->config->cancel, __ATOMIC_RELAXED) != 0;
+}
+
+static int apply_mission_op(ReplayLane* lane, ReplayOp* op, long op_index) {
+    MissionControl *system = lane->system;
+    if (op->type == OP_ADD_COMM) {
+        return add_communication(system, op->number, op->text[0], (MessagePriority)op->priority,
+                                 op->text[1]) == 0;
+    }
+    if (reserve_keys(lane, system->mission_count + 1) != 0 ||
+        create_mission_with_crew(system, op->number, op->text[0], op->text[1]) != 0) {
+        return 0;
+    }
+    lane->order_keys[system->mission_count - 1] = order_key(op_index, 0);
+    return 1;
+}
+
+static void run_lane(void* context, int task_index) {
+    Replay *replay = context;
+    ReplayLane *lane = &replay->lanes[replay->busy[task_index]];
+    for (int k = 0; k < lane->count && !cancelled(replay); k++) {
+        int index = replay->routed[lane->first + k];
+        replay->ops[index].result = (signed char)apply_mission_op(lane, &replay->ops[index], index);
+    }
+}
+
+// Runs ops [begin, end), all mission commands, one task per lane
+static void run_segment(Replay* replay, long begin, long end) {
+    if (!replay->has_system) {
+        // Same as the sequential replay: nothing to add to
+        for (long i = begin; i < end; i++) {
+            replay->ops[i].result = 0;
+        }
+        return;
+    }
+
+    // Counting sort by lane keeps file order, and so each chain's order, within a lane
+    for (int l = 0; l < replay->lane_count; l++) {
+        replay->lanes[l].count = 0;
+    }
+    for (long i = begin; i < end; i++) {
+        replay->lanes[lane_of(replay, replay->ops[i].number)].count++;
+    }
+    int offset = 0;
+    int busy = 0;
+    for (int l = 0; l < replay->lane_count; l++) {
+        replay->lanes[l].first = offset;
+        offset += replay->lanes[l].count;
+        if (replay->lanes[l].count > 0) {
+            replay->busy[busy++] = l;
+        }
+        replay->lanes[l].count = 0;
+    }
+    for (long i = begin; i < end; i++) {
+        ReplayLane *lane = &replay->lanes[lane_of(replay, replay->ops[i].number)];
+        replay->routed[lane->first + lane->count++] = (int)i;
+    }
+
+    run_parallel_tasks(busy, replay->thread_count, run_lane, replay);
+}
+
+/* ========================================
+ * BARRIERS (run on the calling thread)
+ * ======================================== */
+/*
+ * Length of the prefix of `records` a sequential load would insert: it
+ * stops at the first record whose ID is already in its lane or repeats an
+ * earlier record.
+ * @return The prefix length, or -1 if memory runs out
+ */
+static int accepted_prefix(const Replay* replay, const MissionRecord* records, int count) {
+    int accepted = first_repeated_record(records, count);
+    for (int i = 0; i < accepted; i++) {
+        int id = records[i].mission_id;
+        if (mission_index_find(replay->lanes[lane_of(replay, id)].system, id) >= 0) {
+            return i;
+        }
+    }
+    return accepted;
+}
+
+// load_missions_from_file() with each record inserted into its lane
+static int load_into_lanes(Replay* replay, const char* filename, long op_index) {
+    FILE *fp = fopen(filename, "r");
+    if (fp == NULL) {
+        return -1;
+    }
+    int declared;
+    if (fscanf(fp, "%d", &declared) != 1 || declared < 0) {
+        fclose(fp);
+        return -1;
+    }
+    MissionRecord *records;
+    int parsed = read_mission_records(fp, declared, &records);
+    fclose(fp);
+    if (parsed < 0) {
+        return -1;
+    }
+    int result = parsed == declared ? 0 : -1;
+
+    size_t slots = parsed > 0 ? (size_t)parsed : 1;
+    MissionSpec *specs = malloc(slots * sizeof(MissionSpec));
+    int *ordinals = malloc(slots * sizeof(int));
+    if (specs == NULL || ordinals == NULL) {
+        free(records);
+        free(specs);
+        free(ordinals);
+        return -1;
+    }
+
+    // Cut the batch where a sequential load would stop, before it is split
+    int accepted = accepted_prefix(replay, records, parsed);
+    if (accepted != parsed) {
+        parsed = accepted > 0 ? accepted : 0;
+        result = -1;
+    }
+
+    // Lane by lane, the lane's records in file order
+    for (int l = 0; l < replay->lane_count && parsed > 0; l++) {
+        ReplayLane *lane = &replay->lanes[l];
+        int count = 0;
+        for (int i = 0; i < parsed; i++) {
+            if (lane_of(replay, records[i].mission_id) == l) {
+                specs[count].mission_id = records[i].mission_id;
+                specs[count].name = records[i].mission_name;
+                specs[count].launch_date = records[i].launch_date;
+                ordinals[count++] = i;
+            }
+        }
+        if (count == 0) {
+            continue;
+        }
+        int base = lane->system->mission_count;
+        int created = reserve_keys(lane, base + count) == 0 ?
+                      create_missions_bulk(lane->system, specs, count) : -1;
+        // The bulk insert keeps an accepted prefix of the specs
+        for (int i = 0; i < created; i++) {
+            lane->order_keys[base + i] = order_key(op_index, ordinals[i]);
+        }
+        if (created != count) {
+            result = -1;
+        }
+    }
+
+    free(records);
+    free(specs);
+    free(ordinals);
+    return result;
+}
+
+typedef struct {
+    uint64_t key;
+    const Mission *mission;
+    const MissionCold *cold;
+} ReportEntry;
+
+static int compare_report_entries(const void* a, const void* b) {
+    uint64_t ka = ((const ReportEntry*)a)->key;
+    uint64_t kb = ((const ReportEntry*)b)->key;
+    return (ka > kb) - (ka < kb);
+}
+
+// save_mission_report() over every lane, missions in sequential insertion order
+static int save_lanes_report(const Replay* replay, const char* filename) {
+    char path[512];
+    const char *prefix = replay->config->report_prefix != NULL ? replay->config->report_prefix : "";
+    if (filename[0] == '\0' ||
+        snprintf(path, sizeof(path), "%s%s", prefix, filename) >= (int)sizeof(path)) {
+        return -1;
+    }
+    int mission_count = 0;
+    for (int l = 0; l < replay->lane_count; l++) {
+        mission_count += replay->lanes[l].system->mission_count;
+    }
+    ReportEntry *entries = malloc((mission_count > 0 ? (size_t)mission_count : 1) *
+                                  sizeof(ReportEntry));
+    if (entries == NULL) {
+        return -1;
+    }
+    int n = 0;
+    for (int l = 0; l < replay->lane_count; l++) {
+        const MissionControl *system = replay->lanes[l].system;
+        for (int i = 0; i < system->mission_count; i++) {
+            entries[n].key = replay->lanes[l].order_keys[i];
+            entries[n].mission = &system->missions[i];
+            entries[n].cold = MISSION_COLD(system, i);
+            n++;
+        }
+    }
+    qsort(entries, (size_t)n, sizeof(ReportEntry), compare_report_entries);
+
+    FILE *fp = fopen(path, "w");
+    if (fp == NULL) {
+        free(entries);
+        return -1;
+    }
+    char block[REPORT_BLOCK_MAX];
+    int total_comms = 0;
+    fwrite(block, 1, report_format_header(block, sizeof(block), n), fp);
+    for (int i = 0; i < n; i++) {
+        const Mission *m = entries[i].mission;
+        const MissionCold *cold = entries[i].cold;
+        MissionView view = { m->mission_id, cold->mission_name, cold->launch_date, m->status,
+                             m->communications, m->comm_count };
+        total_comms += m->comm_count;
+        fwrite(block, 1, report_format_mission(block, sizeof(block), i, &view), fp);
+    }
+    fwrite(block, 1, report_format_totals(block, sizeof(block), total_comms), fp);
+    free(entries);
+    return fclose(fp) == 0 ? 0 : -1;
+}
+
+// Same outcomes as the driver's sequential replay of each command
+static int run_barrier(Replay* replay, const ReplayOp* op, long op_index) {
+    switch (op->type) {
+        case OP_CREATE_SYSTEM: {
+            free_lanes(replay);
+            int ok = create_lanes(replay, op->number) == 0;
+            if (!op->expect_success) {
+                // Recover with a small system, as execute_create_system_test() does
+                free_lanes(replay);
+                create_lanes(replay, 5);
+            }
+            return ok;
+        }
+        case OP_LOAD_FILE:
+            return replay->has_system && load_into_lanes(replay, op->text[0], op_index) == 0;
+        case OP_SAVE_REPORT:
+            return replay->has_system && save_lanes_report(replay, op->text[0]) == 0;
+        case OP_FREE_SYSTEM:
+            free_lanes(replay);
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+static int is_barrier(const ReplayOp* op) {
+    return op->type != OP_CREATE_MISSION && op->type != OP_ADD_COMM;
+}
+
+/* ========================================
+ * PUBLIC API
+ * ======================================== */
+int run_parallel_replay(const char* filename, const ParallelReplayConfig* config,
+                        ReplayResultCallback on_result, void* context,
+                        ParallelReplayStats* stats) {
+    ParallelReplayStats local;
+    if (stats == NULL) {
+        stats = &local;
+    }
+    memset(stats, 0, sizeof(ParallelReplayStats));
+    if (filename == NULL || config == NULL) {
+        return -1;
+    }
+
+    Replay replay;
+    memset(&replay, 0, sizeof(replay));
+    replay.config = config;
+    replay.thread_count = config->thread_count > 0 ? config->thread_count : online_cpu_count();
+    replay.lane_count = replay.thread_count > 1 ? replay.thread_count * REPLAY_LANES_PER_THREAD : 1;
+
+    char *buffer = NULL;
+    if (parse_file(filename, &buffer, &replay, &stats->malformed) != 0) {
+        return -1;
+    }
+    replay.lanes = calloc((size_t)replay.lane_count, sizeof(ReplayLane));
+    replay.busy = malloc((size_t)replay.lane_count * sizeof(int));
+    replay.routed = malloc((replay.op_count > 0 ? (size_t)replay.op_count : 1) * sizeof(int));
+    if (replay.lanes == NULL || replay.busy == NULL || replay.routed == NULL) {
+        free(replay.lanes);
+        free(replay.busy);
+        free(replay.routed);
+        free(replay.ops);
+        free(buffer);
+        return -1;
+    }
+    stats->threads = replay.thread_count;
+    stats->lanes = replay.lane_count;
+
+    long begin = 0;
+    for (long i = 0; i <= replay.op_count && !cancelled(&replay); i++) {
+        if (i < replay.op_count && !is_barrier(&replay.ops[i])) {
+            continue;
+        }
+        if (i > begin) {
+            run_segment(&replay, begin, i);
+            stats->segments++;
+        }
+        if (i < replay.op_count && !cancelled(&replay)) {
+            replay.ops[i].result = (signed char)run_barrier(&replay, &replay.ops[i], i);
+        }
+
+        // Results go out in file order, segment by segment
+        long last = i < replay.op_count ? i : replay.op_count - 1;
+        for (long j = begin; j <= last; j++) {
+            const ReplayOp *op = &replay.ops[j];
+            if (op->result == REPLAY_NOT_RUN) {
+                continue;
+            }
+            stats->commands++;
+            if (on_result != NULL) {
+                on_result(context, op->line_number, op->keyword, op->expect_success, op->result);
+            }
+        }
+        begin = i + 1;
+    }
+
+    free_lanes(&replay);
+    free(replay.lanes);
+    free(replay.busy);
+    free(replay.routed);
+    free(replay.ops);
+    free(buffer);
+    return 0;
+}
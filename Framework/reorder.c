@@ -0,0 +1,318 @@
+/**
+ * @file reorder.c
+ * @brief Space Mission Control System - Out-of-Order Arrival Buffer
+ *
+ * While reordering is enabled an accepted log is not appended at once:
+ * it is inserted, by timestamp, into its mission's reorder buffer. Once
+ * the mission has seen a log `lateness` minutes newer, nothing that may
+ * still arrive in time can sort before the buffer's oldest entry, so the
+ * front of the buffer is committed to the communications array in order.
+ * A log older than the newest one already committed is too late: it is
+ * refused with COMM_ADD_TOO_LATE and counted in the too_late statistic.
+ * Committed logs are therefore always in timestamp order, and time-range
+ * lookups binary-search them.
+ *
+ * Arrivals are nearly sorted, so the insertion point is found by scanning
+ * back from the newest entry. A mission's buffer never holds more than
+ * `max_buffered` logs: beyond that the oldest are committed early, which
+ * only narrows the window for later arrivals.
+ *
+ * A mission's buffer is allocated with its first buffered log.
+ */
+
+#include "mission_internal.h"
+
+#include <limits.h>
+
+#define REORDER_DEFAULT_MAX_BUFFERED 1024
+#define REORDER_INITIAL_CAPACITY 8
+
+typedef struct {
+    long minute;                            // Epoch minute of timestamp, the sort key
+    uint64_t fingerprint;                   // From dedup_check(), for dedup_record()
+    int fingerprinted;                      // 0 if dedup was disabled on arrival
+    MessagePriority priority;
+    char timestamp[MAX_TIMESTAMP_LENGTH];
+    char message[MAX_MESSAGE_LENGTH];
+} ReorderEntry;
+
+struct CommReorderBuffer {
+    long newest_minute;         // Newest timestamp seen for the mission
+    long committed_minute;      // Newest timestamp committed (LONG_MIN before any)
+    int count;                  // Buffered entries, oldest first
+    int capacity;
+    ReorderEntry *entries;
+};
+
+struct CommReorder {
+    long lateness;              // Minutes a log may trail the mission's newest
+    int max_buffered;           // Per-mission buffer bound
+    long reordered;             // Committed logs that arrived behind a newer one
+    long too_late;              // Logs refused for arriving too late
+    MissionSideTable buffers;   // CommReorderBuffer* by mission position
+};
+
+/* ========================================
+ * BUFFER MAINTENANCE
+ * ======================================== */
+static CommReorderBuffer* create_buffer(const MissionControl* system, int position) {
+    CommReorderBuffer *buffer = malloc(sizeof(CommReorderBuffer));
+    if (buffer == NULL) {
+        return NULL;
+    }
+    buffer->count = 0;
+    buffer->capacity = 0;
+    buffer->entries = NULL;
+    buffer->newest_minute = LONG_MIN;
+    buffer->committed_minute = LONG_MIN;
+
+    // Logs committed before reordering was enabled set the starting point
+    const Mission *mission = &system->missions[position];
+    long minute;
+    if (mission->comm_count > 0 &&
+        timestamp_to_epoch_minute(mission->communications[mission->comm_count - 1].timestamp,
+                                  &minute)) {
+        buffer->newest_minute = minute;
+        buffer->committed_minute = minute;
+    }
+    return buffer;
+}
+
+// Index at which an entry for `minute` goes: after every entry not newer
+static int insertion_point(const CommReorderBuffer* buffer, long minute) {
+    int index = buffer->count;
+    while (index > 0 && buffer->entries[index - 1].minute > minute) {
+        index--;
+    }
+    return index;
+}
+
+// Is an identical log already waiting? Entries with the same minute sit
+// just before `index`
+static int buffers_duplicate(const CommReorderBuffer* buffer, int index,
+                             const ReorderEntry* entry) {
+    for (int i = index - 1; i >= 0 && buffer->entries[i].minute == entry->minute; i--) {
+        const ReorderEntry *other = &buffer->entries[i];
+        if (other->priority == entry->priority &&
+            strcmp(other->timestamp, entry->timestamp) == 0 &&
+            strcmp(other->message, entry->message) == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Commit the buffered logs at or before `through_minute`, plus as many of
+ * the oldest as needed to leave at most `keep_at_most` buffered. Stops at
+ * the first commit that fails (allocation), leaving the rest buffered.
+ * @return Logs committed, or -1 if a commit failed
+ */
+static int release(MissionControl* system, int position, CommReorderBuffer* buffer,
+                   long through_minute, int keep_at_most) {
+    int released = 0;
+    int result = 0;
+    while (released < buffer->count &&
+           (buffer->entries[released].minute <= through_minute ||
+            buffer->count - released > keep_at_most)) {
+        const ReorderEntry *entry = &buffer->entries[released];
+        uint64_t fingerprint = entry->fingerprint;
+        if (MISSION_SYSTEM(system)->dedup != NULL && !entry->fingerprinted) {
+            fingerprint = comm_fingerprint(entry->timestamp, entry->priority, entry->message);
+        }
+        if (commit_communication(system, position, entry->timestamp, entry->priority,
+                                 entry->message, fingerprint) != 0) {
+            result = -1;
+            break;
+        }
+        buffer->committed_minute = entry->minute;
+        released++;
+    }
+    if (released > 0) {
+        buffer->count -= released;
+        memmove(buffer->entries, buffer->entries + released,
+                (size_t)buffer->count * sizeof(ReorderEntry));
+    }
+    return result == 0 ? released : -1;
+}
+
+/* ========================================
+ * APPEND HOOK
+ * ======================================== */
+CommAddStatus reorder_add(MissionControl* system, int position, const char* timestamp,
+                          MessagePriority priority, const char* message, uint64_t fingerprint) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    CommReorder *reorder = sys->reorder;
+    ReorderEntry entry;
+    if (!timestamp_to_epoch_minute(timestamp, &entry.minute)) {
+        return -1;  // Cannot be placed in time
+    }
+
+    CommReorderBuffer *buffer = side_table_get(&reorder->buffers, position);
+    if (buffer == NULL) {
+        buffer = create_buffer(system, position);
+        if (buffer == NULL || side_table_set(&reorder->buffers, system, position, buffer) != 0) {
+            free(buffer);
+            return -1;
+        }
+    }
+    if (entry.minute < buffer->committed_minute) {
+        reorder->too_late++;
+        return COMM_ADD_TOO_LATE;
+    }
+
+    entry.fingerprint = fingerprint;
+    entry.fingerprinted = sys->dedup != NULL;
+    entry.priority = priority;
+    strncpy(entry.timestamp, timestamp, sizeof(entry.timestamp) - 1);
+    entry.timestamp[sizeof(entry.timestamp) - 1] = '\0';
+    strncpy(entry.message, message, sizeof(entry.message) - 1);
+    entry.message[sizeof(entry.message) - 1] = '\0';
+
+    int index = insertion_point(buffer, entry.minute);
+    if (sys->dedup != NULL && buffers_duplicate(buffer, index, &entry)) {
+        dedup_note_duplicate(system);
+        return COMM_ADD_DUPLICATE;
+    }
+    if (buffer->count >= buffer->capacity) {
+        int capacity = buffer->capacity > 0 ? buffer->capacity * 2 : REORDER_INITIAL_CAPACITY;
+        ReorderEntry *grown = realloc(buffer->entries, (size_t)capacity * sizeof(ReorderEntry));
+        if (grown == NULL) {
+            return -1;
+        }
+        buffer->entries = grown;
+        buffer->capacity = capacity;
+    }
+    memmove(&buffer->entries[index + 1], &buffer->entries[index],
+            (size_t)(buffer->count - index) * sizeof(ReorderEntry));
+    buffer->entries[index] = entry;
+    buffer->count++;
+
+    if (entry.minute < buffer->newest_minute) {
+        reorder->reordered++;
+    } else {
+        buffer->newest_minute = entry.minute;
+    }
+    // The log itself is buffered even if committing older ones failed
+    release(system, position, buffer, buffer->newest_minute - reorder->lateness,
+            reorder->max_buffered);
+    return 0;
+}
+
+static void free_buffer(CommReorderBuffer* buffer) {
+    if (buffer != NULL) {
+        free(buffer->entries);
+        free(buffer);
+    }
+}
+
+void reorder_remove_mission(MissionControl* system, int position) {
+    free_buffer(side_table_take(&MISSION_SYSTEM(system)->reorder->buffers, position,
+                                system->mission_count - 1));
+}
+
+void reorder_free(MissionControl* system) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    if (sys->reorder == NULL) {
+        return;
+    }
+    for (int i = 0; i < sys->reorder->buffers.capacity; i++) {
+        free_buffer(sys->reorder->buffers.entries[i]);
+    }
+    side_table_free(&sys->reorder->buffers);
+    free(sys->reorder);
+    sys->reorder = NULL;
+}
+
+void reorder_memory(const MissionControl* system, MemoryFigure* figure) {
+    const CommReorder *reorder = MISSION_SYSTEM(system)->reorder;
+    if (reorder == NULL) {
+        return;
+    }
+    figure->used += sizeof(CommReorder);
+    figure->reserved += sizeof(CommReorder);
+    side_table_memory(&reorder->buffers, figure);
+    for (int i = 0; i < system->mission_count; i++) {
+        const CommReorderBuffer *buffer = side_table_get(&reorder->buffers, i);
+        if (buffer != NULL) {
+            figure->used += sizeof(CommReorderBuffer) +
+                            (size_t)buffer->count * sizeof(ReorderEntry);
+            figure->reserved += sizeof(CommReorderBuffer) +
+                                (size_t)buffer->capacity * sizeof(ReorderEntry);
+        }
+    }
+}
+
+/* ========================================
+ * ENABLE / FLUSH / DISABLE
+ * ======================================== */
+int enable_comm_reorder(MissionControl* system, int lateness_minutes, int max_buffered) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    if (system == NULL || lateness_minutes < 0 || max_buffered < 0) {
+        return -1;
+    }
+    if (sys->reorder != NULL) {
+        return 0;
+    }
+    CommReorder *reorder = calloc(1, sizeof(CommReorder));
+    if (reorder == NULL) {
+        return -1;
+    }
+    reorder->lateness = lateness_minutes;
+    reorder->max_buffered = max_buffered > 0 ? max_buffered : REORDER_DEFAULT_MAX_BUFFERED;
+    reorder->reordered = 0;
+    reorder->too_late = 0;
+    sys->reorder = reorder;
+    return 0;
+}
+
+long flush_comm_reorder(MissionControl* system) {
+    if (system == NULL) {
+        return -1;
+    }
+    const CommReorder *reorder = MISSION_SYSTEM(system)->reorder;
+    if (reorder == NULL) {
+        return 0;
+    }
+    long committed = 0;
+    for (int i = 0; i < system->mission_count; i++) {
+        CommReorderBuffer *buffer = side_table_get(&reorder->buffers, i);
+        if (buffer == NULL || buffer->count == 0) {
+            continue;
+        }
+        int released = release(system, i, buffer, LONG_MAX, 0);
+        if (released < 0) {
+            return -1;
+        }
+        committed += released;
+    }
+    return committed;
+}
+
+int disable_comm_reorder(MissionControl* system) {
+    if (system == NULL || flush_comm_reorder(system) < 0) {
+        return -1;
+    }
+    reorder_free(system);
+    return 0;
+}
+
+int get_comm_reorder_stats(const MissionControl* system, CommReorderStats* out) {
+    const MissionSystem *sys = MISSION_SYSTEM(system);
+    if (system == NULL || out == NULL) {
+        return -1;
+    }
+    memset(out, 0, sizeof(CommReorderStats));
+    if (sys->reorder == NULL) {
+        return 0;
+    }
+    for (int i = 0; i < system->mission_count; i++) {
+        const CommReorderBuffer *buffer = side_table_get(&sys->reorder->buffers, i);
+        if (buffer != NULL) {
+            out->buffered += buffer->count;
+        }
+    }
+    out->reordered = sys->reorder->reordered;
+    out->too_late = sys->reorder->too_late;
+    return 0;
+}
@@ -0,0 +1,417 @@
+/**
+ * @file report_async.c
+ * @brief Space Mission Control System - Background Report Saving
+ *
+ * save_mission_report_async() only opens a snapshot (fixing the report's
+ * point in time) and queues a job, so its cost does not depend on report
+ * size. Two service threads do the rest:
+ *
+ *   formatter: captures the snapshot and formats the report into one of
+ *              two reusable buffers, handing each full buffer over
+ *   writer:    write()s buffers to "<filename>.<job>.tmp" in order, then fsync,
+ *              close and rename() over the target, so readers only ever
+ *              see a complete report
+ *
+ * While the writer drains one buffer the formatter fills the other. The
+ * buffers live as long as the service, so steady-state saves allocate
+ * nothing for output.
+ *
+ * Snapshots version appends and creations but not removals (see
+ * snapshot.c), so remove_mission() and purge_communications() first
+ * capture every job still queued; the report then matches the system as
+ * of the save call rather than as of the moment the formatter reached it.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mission_internal.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+
+#define REPORT_BUFFER_BYTES (64 * 1024)
+#define REPORT_SUFFIX_MAX 32     // ".<job>.tmp" for any unsigned long job number
+
+enum { BUFFER_FREE = 0, BUFFER_FULL = 1, BUFFER_WRITING = 2 };
+
+struct MissionReportHandle {
+    pthread_mutex_t lock;
+    pthread_cond_t finished;
+    int done;                   // Set once the file is in place or the job failed
+    int result;                 // 0 on success, -1 on failure
+    int refs;                   // Caller + service
+};
+
+typedef struct ReportJob {
+    MissionReportHandle *handle;
+    MissionSnapshot *snapshot;
+    char *path;
+    char *temp_path;
+    int fd;
+    int captured;               // 1 once the snapshot holds its counts, -1 if that failed
+    int failed;                 // Any write error; checked when the job finishes
+    struct ReportJob *next;
+} ReportJob;
+
+typedef struct {
+    char *data;
+    size_t length;
+    int state;                  // BUFFER_*
+    ReportJob *job;             // Job the contents belong to
+    int final;                  // Last buffer of its job
+} ReportBuffer;
+
+struct ReportService {
+    const MissionControl *system;
+    pthread_mutex_t lock;
+    pthread_cond_t changed;     // Queue, buffer state or shutdown changed
+    pthread_mutex_t capture_lock;   // Held to dequeue or capture; taken after `lock`
+    ReportJob *head;
+    ReportJob *tail;
+    int stopping;
+    int formatter_done;
+    ReportBuffer buffers[2];
+    int fill_index;             // Buffer the formatter is filling
+    unsigned long jobs_queued;  // Numbers temp files, so saves to one file never share one
+    pthread_t formatter;
+    pthread_t writer;
+};
+
+/* ========================================
+ * HANDLES
+ * ======================================== */
+static void complete_handle(MissionReportHandle* handle, int result) {
+    pthread_mutex_lock(&handle->lock);
+    handle->result = result;
+    __atomic_store_n(&handle->done, 1, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&handle->finished);
+    pthread_mutex_unlock(&handle->lock);
+    mission_report_release(handle);
+}
+
+static void free_job(ReportJob* job) {
+    free(job->path);
+    free(job->temp_path);
+    free(job);
+}
+
+/* ========================================
+ * WRITER THREAD
+ * ======================================== */
+static int write_all(int fd, const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t written = write(fd, data, length);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        data += written;
+        length -= (size_t)written;
+    }
+    return 0;
+}
+
+static void finish_job(ReportJob* job) {
+    int result = job->failed ? -1 : 0;
+    if (result == 0 && fsync(job->fd) != 0) {
+        result = -1;
+    }
+    if (close(job->fd) != 0) {
+        result = -1;
+    }
+    if (result == 0 && rename(job->temp_path, job->path) != 0) {
+        result = -1;
+    }
+    if (result != 0) {
+        unlink(job->temp_path);
+    }
+    complete_handle(job->handle, result);
+    free_job(job);
+}
+
+static void* writer_main(void* arg) {
+    ReportService *service = arg;
+    int index = 0;
+    for (;;) {
+        ReportBuffer *buffer = &service->buffers[index];
+        pthread_mutex_lock(&service->lock);
+        while (buffer->state != BUFFER_FULL && !service->formatter_done) {
+            pthread_cond_wait(&service->changed, &service->lock);
+        }
+        if (buffer->state != BUFFER_FULL) {
+            pthread_mutex_unlock(&service->lock);
+            return NULL;
+        }
+        buffer->state = BUFFER_WRITING;
+        pthread_mutex_unlock(&service->lock);
+
+        ReportJob *job = buffer->job;
+        if (!job->failed && write_all(job->fd, buffer->data, buffer->length) != 0) {
+            job->failed = 1;
+        }
+        if (buffer->final) {
+            finish_job(job);
+        }
+
+        pthread_mutex_lock(&service->lock);
+        buffer->state = BUFFER_FREE;
+        pthread_cond_broadcast(&service->changed);
+        pthread_mutex_unlock(&service->lock);
+        index ^= 1;
+    }
+}
+
+/* ========================================
+ * FORMATTER THREAD
+ * ======================================== */
+// Hand the current buffer to the writer and wait until the other one is free
+static void submit_buffer(ReportService* service, ReportJob* job, int final) {
+    pthread_mutex_lock(&service->lock);
+    ReportBuffer *buffer = &service->buffers[service->fill_index];
+    buffer->job = job;
+    buffer->final = final;
+    buffer->state = BUFFER_FULL;
+    pthread_cond_broadcast(&service->changed);
+
+    service->fill_index ^= 1;
+    ReportBuffer *next = &service->buffers[service->fill_index];
+    while (next->state != BUFFER_FREE) {
+        pthread_cond_wait(&service->changed, &service->lock);
+    }
+    next->length = 0;
+    pthread_mutex_unlock(&service->lock);
+}
+
+typedef struct {
+    ReportService *service;
+    ReportJob *job;
+} FormatContext;
+
+static int buffer_sink(void* context, const char* data, size_t length) {
+    FormatContext *format = context;
+    ReportService *service = format->service;
+    ReportBuffer *buffer = &service->buffers[service->fill_index];
+    if (buffer->length + length > REPORT_BUFFER_BYTES) {
+        submit_buffer(service, format->job, 0);
+        buffer = &service->buffers[service->fill_index];
+    }
+    memcpy(buffer->data + buffer->length, data, length);
+    buffer->length += length;
+    return 0;
+}
+
+static void capture_job(const ReportService* service, ReportJob* job) {
+    if (job->captured == 0) {
+        job->captured = snapshot_capture(job->snapshot, service->system) == 0 ? 1 : -1;
+    }
+}
+
+static void format_job(ReportService* service, ReportJob* job) {
+    if (job->captured > 0) {
+        job->fd = open(job->temp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    }
+    if (job->fd < 0) {
+        end_mission_snapshot(job->snapshot);
+        complete_handle(job->handle, -1);
+        free_job(job);
+        return;
+    }
+
+    FormatContext context = { service, job };
+    emit_snapshot_report(job->snapshot, buffer_sink, &context);
+    end_mission_snapshot(job->snapshot);
+    job->snapshot = NULL;
+    submit_buffer(service, job, 1);
+}
+
+static void* formatter_main(void* arg) {
+    ReportService *service = arg;
+    for (;;) {
+        pthread_mutex_lock(&service->lock);
+        while (service->head == NULL && !service->stopping) {
+            pthread_cond_wait(&service->changed, &service->lock);
+        }
+        ReportJob *job = service->head;
+        if (job == NULL) {
+            service->formatter_done = 1;
+            pthread_cond_broadcast(&service->changed);
+            pthread_mutex_unlock(&service->lock);
+            return NULL;
+        }
+        // Dequeue and capture as one step for report_service_capture_queued()
+        pthread_mutex_lock(&service->capture_lock);
+        service->head = job->next;
+        if (service->head == NULL) {
+            service->tail = NULL;
+        }
+        pthread_mutex_unlock(&service->lock);
+        capture_job(service, job);
+        pthread_mutex_unlock(&service->capture_lock);
+
+        format_job(service, job);
+    }
+}
+
+/* ========================================
+ * SERVICE LIFECYCLE
+ * ======================================== */
+static void free_service(ReportService* service) {
+    free(service->buffers[0].data);
+    free(service->buffers[1].data);
+    pthread_cond_destroy(&service->changed);
+    pthread_mutex_destroy(&service->capture_lock);
+    pthread_mutex_destroy(&service->lock);
+    free(service);
+}
+
+static int start_service(MissionControl* system) {
+    ReportService *service = calloc(1, sizeof(ReportService));
+    if (service == NULL) {
+        return -1;
+    }
+    service->system = system;
+    service->buffers[0].data = malloc(REPORT_BUFFER_BYTES);
+    service->buffers[1].data = malloc(REPORT_BUFFER_BYTES);
+    if (service->buffers[0].data == NULL || service->buffers[1].data == NULL ||
+        pthread_mutex_init(&service->lock, NULL) != 0) {
+        free(service->buffers[0].data);
+        free(service->buffers[1].data);
+        free(service);
+        return -1;
+    }
+    pthread_mutex_init(&service->capture_lock, NULL);
+    pthread_cond_init(&service->changed, NULL);
+
+    if (pthread_create(&service->writer, NULL, writer_main, service) != 0) {
+        free_service(service);
+        return -1;
+    }
+    if (pthread_create(&service->formatter, NULL, formatter_main, service) != 0) {
+        pthread_mutex_lock(&service->lock);
+        service->formatter_done = 1;
+        pthread_cond_broadcast(&service->changed);
+        pthread_mutex_unlock(&service->lock);
+        pthread_join(service->writer, NULL);
+        free_service(service);
+        return -1;
+    }
+    MISSION_SYSTEM(system)->report_service = service;
+    return 0;
+}
+
+void report_service_capture_queued(MissionControl* system) {
+    ReportService *service = MISSION_SYSTEM(system)->report_service;
+    // Only the formatter dequeues, under capture_lock, and only this thread
+    // enqueues, so the queue is stable while capture_lock is held
+    pthread_mutex_lock(&service->capture_lock);
+    for (ReportJob *job = service->head; job != NULL; job = job->next) {
+        capture_job(service, job);
+    }
+    pthread_mutex_unlock(&service->capture_lock);
+}
+
+void report_service_stop(MissionControl* system) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    ReportService *service = sys->report_service;
+    if (service == NULL) {
+        return;
+    }
+    // Queued jobs still run to completion before the threads exit
+    pthread_mutex_lock(&service->lock);
+    service->stopping = 1;
+    pthread_cond_broadcast(&service->changed);
+    pthread_mutex_unlock(&service->lock);
+    pthread_join(service->formatter, NULL);
+    pthread_join(service->writer, NULL);
+    free_service(service);
+    sys->report_service = NULL;
+}
+
+/* ========================================
+ * PUBLIC API
+ * ======================================== */
+MissionReportHandle* save_mission_report_async(MissionControl* system, const char* filename) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    if (system == NULL || filename == NULL || filename[0] == '\0') {
+        return NULL;
+    }
+    if (enable_mission_snapshots(system) != 0 ||
+        (sys->report_service == NULL && start_service(system) != 0)) {
+        return NULL;
+    }
+
+    MissionReportHandle *handle = calloc(1, sizeof(MissionReportHandle));
+    ReportJob *job = calloc(1, sizeof(ReportJob));
+    size_t path_length = strlen(filename);
+    if (handle == NULL || job == NULL ||
+        (job->path = strdup(filename)) == NULL ||
+        (job->temp_path = malloc(path_length + REPORT_SUFFIX_MAX)) == NULL) {
+        free(handle);
+        if (job != NULL) {
+            free_job(job);
+        }
+        return NULL;
+    }
+    snprintf(job->temp_path, path_length + REPORT_SUFFIX_MAX, "%s.%lu.tmp", filename,
+             sys->report_service->jobs_queued++);
+
+    pthread_mutex_init(&handle->lock, NULL);
+    pthread_cond_init(&handle->finished, NULL);
+    handle->refs = 2;
+    job->handle = handle;
+    job->fd = -1;
+
+    // The report reflects the system as of this call
+    job->snapshot = snapshot_open(system);
+    if (job->snapshot == NULL) {
+        pthread_cond_destroy(&handle->finished);
+        pthread_mutex_destroy(&handle->lock);
+        free(handle);
+        free_job(job);
+        return NULL;
+    }
+
+    ReportService *service = sys->report_service;
+    pthread_mutex_lock(&service->lock);
+    if (service->tail != NULL) {
+        service->tail->next = job;
+    } else {
+        service->head = job;
+    }
+    service->tail = job;
+    pthread_cond_broadcast(&service->changed);
+    pthread_mutex_unlock(&service->lock);
+    return handle;
+}
+
+int mission_report_poll(const MissionReportHandle* handle) {
+    if (handle == NULL) {
+        return -1;
+    }
+    return __atomic_load_n(&handle->done, __ATOMIC_ACQUIRE);
+}
+
+int mission_report_wait(MissionReportHandle* handle) {
+    if (handle == NULL) {
+        return -1;
+    }
+    pthread_mutex_lock(&handle->lock);
+    while (!handle->done) {
+        pthread_cond_wait(&handle->finished, &handle->lock);
+    }
+    int result = handle->result;
+    pthread_mutex_unlock(&handle->lock);
+    return result;
+}
+
+void mission_report_release(MissionReportHandle* handle) {
+    if (handle == NULL || __atomic_sub_fetch(&handle->refs, 1, __ATOMIC_ACQ_REL) > 0) {
+        return;
+    }
+    pthread_cond_destroy(&handle->finished);
+    pthread_mutex_destroy(&handle->lock);
+    free(handle);
+}
@@ -0,0 +1,298 @@
+/**
+ * @file rollups.c
+ * @brief Space Mission Control System - Time-Bucketed Communication Rollups
+ *
+ * While rollups are enabled every accepted log bumps one counter per
+ * granularity (minute, hour, day) in its mission's rings, broken down by
+ * priority. A ring of N buckets holds the most recent N periods: period p
+ * lives in slot p mod N, and a slot is reset when a newer period claims
+ * it. Series queries therefore read at most one bucket per point, however
+ * many logs the mission holds.
+ *
+ * A mission's rings are allocated on its first log. Logs older than what
+ * a ring retains are not counted there, and the affected points are
+ * reported as unavailable. Without rollups, queries scan and parse the
+ * logs instead (same results, no retention limit).
+ */
+
+#include "mission_internal.h"
+
+#include <limits.h>
+
+#define ROLLUP_DEFAULT_MINUTES 120      // 2 hours
+#define ROLLUP_DEFAULT_HOURS 168        // 7 days
+#define ROLLUP_DEFAULT_DAYS 366         // 1 year
+#define ROLLUP_EMPTY LONG_MIN           // Bucket never used
+
+typedef struct {
+    long period;                        // Epoch minute/hour/day, or ROLLUP_EMPTY
+    unsigned int counts[EMERGENCY];     // Indexed by priority - 1
+} RollupBucket;
+
+struct MissionRollup {
+    RollupBucket *rings[ROLLUP_GRANULARITY_COUNT];   // Carved from one allocation
+};
+
+struct CommRollups {
+    int ring_sizes[ROLLUP_GRANULARITY_COUNT];
+    int total_buckets;
+    MissionSideTable per_mission;       // MissionRollup* by mission position
+};
+
+static const long g_minutes_per_period[ROLLUP_GRANULARITY_COUNT] = { 1, 60, 24 * 60 };
+
+/* ========================================
+ * PERIOD ARITHMETIC
+ * ======================================== */
+// "YYYY-MM-DD HH:MM" -> minutes since 1970-01-01 00:00; 0 if the date or time is out of range
+int timestamp_to_epoch_minute(const char* timestamp, long* epoch_minute) {
+    char date[MAX_DATE_LENGTH];
+    int epoch_day;
+    if (!is_valid_timestamp_format(timestamp)) {
+        return 0;
+    }
+    memcpy(date, timestamp, 10);
+    date[10] = '\0';
+    if (!parse_date_to_epoch_day(date, &epoch_day)) {
+        return 0;
+    }
+    int hour = (timestamp[11] - '0') * 10 + (timestamp[12] - '0');
+    int minute = (timestamp[14] - '0') * 10 + (timestamp[15] - '0');
+    if (hour > 23 || minute > 59) {
+        return 0;
+    }
+    *epoch_minute = (long)epoch_day * 24 * 60 + hour * 60 + minute;
+    return 1;
+}
+
+// Floor division, so periods before 1970 still group correctly
+static long period_of(long epoch_minute, RollupGranularity granularity) {
+    long size = g_minutes_per_period[granularity];
+    return epoch_minute >= 0 ? epoch_minute / size : -((-epoch_minute + size - 1) / size);
+}
+
+static int ring_slot(long period, int ring_size) {
+    long slot = period % ring_size;
+    return (int)(slot < 0 ? slot + ring_size : slot);
+}
+
+/* ========================================
+ * RING MAINTENANCE
+ * ======================================== */
+static MissionRollup* create_mission_rollup(const CommRollups* rollups) {
+    MissionRollup *rollup = malloc(sizeof(MissionRollup) +
+                                   (size_t)rollups->total_buckets * sizeof(RollupBucket));
+    if (rollup == NULL) {
+        return NULL;
+    }
+    RollupBucket *bucket = (RollupBucket*)(rollup + 1);
+    for (int g = 0; g < ROLLUP_GRANULARITY_COUNT; g++) {
+        rollup->rings[g] = bucket;
+        bucket += rollups->ring_sizes[g];
+    }
+    RollupBucket *end = bucket;
+    for (bucket = (RollupBucket*)(rollup + 1); bucket < end; bucket++) {
+        bucket->period = ROLLUP_EMPTY;
+    }
+    return rollup;
+}
+
+static void count_log(const CommRollups* rollups, MissionRollup* rollup, long epoch_minute,
+                      MessagePriority priority) {
+    for (int g = 0; g < ROLLUP_GRANULARITY_COUNT; g++) {
+        long period = period_of(epoch_minute, (RollupGranularity)g);
+        RollupBucket *bucket = &rollup->rings[g][ring_slot(period, rollups->ring_sizes[g])];
+        if (bucket->period != period) {
+            if (bucket->period != ROLLUP_EMPTY && bucket->period > period) {
+                continue;   // Older than this ring retains
+            }
+            bucket->period = period;
+            memset(bucket->counts, 0, sizeof(bucket->counts));
+        }
+        bucket->counts[priority - 1]++;
+    }
+}
+
+int rollups_record(MissionControl* system, int position, const CommLog* log) {
+    CommRollups *rollups = MISSION_SYSTEM(system)->rollups;
+    long epoch_minute;
+    if (!timestamp_to_epoch_minute(log->timestamp, &epoch_minute) ||
+        log->priority < ROUTINE || log->priority > EMERGENCY) {
+        return 0;   // Cannot be placed in a period
+    }
+    MissionRollup *rollup = side_table_get(&rollups->per_mission, position);
+    if (rollup == NULL) {
+        rollup = create_mission_rollup(rollups);
+        if (rollup == NULL ||
+            side_table_set(&rollups->per_mission, system, position, rollup) != 0) {
+            // Queries fall back to scanning, so losing the rollups is not fatal
+            free(rollup);
+            rollups_free(system);
+            return -1;
+        }
+    }
+    count_log(rollups, rollup, epoch_minute, log->priority);
+    return 0;
+}
+
+void rollups_remove_mission(MissionControl* system, int position) {
+    free(side_table_take(&MISSION_SYSTEM(system)->rollups->per_mission, position,
+                         system->mission_count - 1));
+}
+
+void rollups_free(MissionControl* system) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    if (sys->rollups == NULL) {
+        return;
+    }
+    for (int i = 0; i < sys->rollups->per_mission.capacity; i++) {
+        free(sys->rollups->per_mission.entries[i]);
+    }
+    side_table_free(&sys->rollups->per_mission);
+    free(sys->rollups);
+    sys->rollups = NULL;
+}
+
+void rollups_memory(const MissionControl* system, MemoryFigure* figure) {
+    const CommRollups *rollups = MISSION_SYSTEM(system)->rollups;
+    if (rollups == NULL) {
+        return;
+    }
+    size_t rollup_bytes = sizeof(MissionRollup) +
+                          (size_t)rollups->total_buckets * sizeof(RollupBucket);
+    size_t bytes = sizeof(CommRollups);
+    for (int i = 0; i < system->mission_count; i++) {
+        if (side_table_get(&rollups->per_mission, i) != NULL) {
+            bytes += rollup_bytes;
+        }
+    }
+    figure->used += bytes;
+    figure->reserved += bytes;
+    side_table_memory(&rollups->per_mission, figure);
+}
+
+/* ========================================
+ * ENABLE / DISABLE
+ * ======================================== */
+int enable_comm_rollups(MissionControl* system, int minute_buckets, int hour_buckets,
+                        int day_buckets) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    if (system == NULL || minute_buckets < 0 || hour_buckets < 0 || day_buckets < 0) {
+        return -1;
+    }
+    if (sys->rollups != NULL) {
+        return 0;
+    }
+    CommRollups *rollups = calloc(1, sizeof(CommRollups));
+    if (rollups == NULL) {
+        return -1;
+    }
+    rollups->ring_sizes[ROLLUP_MINUTE] = minute_buckets > 0 ? minute_buckets : ROLLUP_DEFAULT_MINUTES;
+    rollups->ring_sizes[ROLLUP_HOUR] = hour_buckets > 0 ? hour_buckets : ROLLUP_DEFAULT_HOURS;
+    rollups->ring_sizes[ROLLUP_DAY] = day_buckets > 0 ? day_buckets : ROLLUP_DEFAULT_DAYS;
+    rollups->total_buckets = rollups->ring_sizes[ROLLUP_MINUTE] +
+                             rollups->ring_sizes[ROLLUP_HOUR] + rollups->ring_sizes[ROLLUP_DAY];
+    sys->rollups = rollups;
+
+    // Backfill from the logs already held
+    for (int i = 0; i < system->mission_count; i++) {
+        const Mission *mission = &system->missions[i];
+        for (int j = 0; j < mission->comm_count; j++) {
+            if (rollups_record(system, i, &mission->communications[j]) != 0) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+void disable_comm_rollups(MissionControl* system) {
+    if (system != NULL) {
+        rollups_free(system);
+    }
+}
+
+/* ========================================
+ * SERIES QUERIES
+ * ======================================== */
+static void add_from_rollup(const CommRollups* rollups, const MissionRollup* rollup,
+                            RollupGranularity granularity, long first_period, int count,
+                            RollupPoint* points) {
+    int ring_size = rollups->ring_sizes[granularity];
+    for (int i = 0; i < count; i++) {
+        long period = first_period + i;
+        const RollupBucket *bucket = &rollup->rings[granularity][ring_slot(period, ring_size)];
+        if (bucket->period == period) {
+            for (int p = ROUTINE; p <= EMERGENCY; p++) {
+                points[i].counts[p] += (int)bucket->counts[p - 1];
+                points[i].counts[0] += (int)bucket->counts[p - 1];
+            }
+        } else if (bucket->period != ROLLUP_EMPTY && bucket->period > period) {
+            points[i].available = 0;    // Overwritten by a newer period
+        }
+    }
+}
+
+static void add_from_scan(const Mission* mission, RollupGranularity granularity,
+                          long first_period, int count, RollupPoint* points) {
+    for (int j = 0; j < mission->comm_count; j++) {
+        const CommLog *log = &mission->communications[j];
+        long epoch_minute;
+        if (!timestamp_to_epoch_minute(log->timestamp, &epoch_minute) ||
+            log->priority < ROUTINE || log->priority > EMERGENCY) {
+            continue;
+        }
+        long offset = period_of(epoch_minute, granularity) - first_period;
+        if (offset >= 0 && offset < count) {
+            points[offset].counts[log->priority]++;
+            points[offset].counts[0]++;
+        }
+    }
+}
+
+static void add_mission(const MissionControl* system, int position,
+                        RollupGranularity granularity, long first_period, int count,
+                        RollupPoint* points) {
+    const CommRollups *rollups = MISSION_SYSTEM(system)->rollups;
+    if (rollups == NULL) {
+        add_from_scan(&system->missions[position], granularity, first_period, count, points);
+        return;
+    }
+    const MissionRollup *rollup = side_table_get(&rollups->per_mission, position);
+    if (rollup != NULL) {
+        add_from_rollup(rollups, rollup, granularity, first_period, count, points);
+    }
+}
+
+int get_comm_rollup_series(const MissionControl* system, int mission_id,
+                           RollupGranularity granularity, const char* from_timestamp,
+                           int count, RollupPoint* points) {
+    long epoch_minute;
+    if (system == NULL || points == NULL || count < 0 || mission_id < 0 ||
+        granularity < ROLLUP_MINUTE || granularity >= ROLLUP_GRANULARITY_COUNT ||
+        from_timestamp == NULL || !timestamp_to_epoch_minute(from_timestamp, &epoch_minute)) {
+        return -1;
+    }
+
+    long first_period = period_of(epoch_minute, granularity);
+    for (int i = 0; i < count; i++) {
+        memset(&points[i], 0, sizeof(RollupPoint));
+        points[i].start_minute = (first_period + i) * g_minutes_per_period[granularity];
+        points[i].available = 1;
+    }
+
+    if (mission_id > 0) {
+        int position = mission_index_find(system, mission_id);
+        if (position < 0) {
+            // A pending lazily loaded mission has no logs to count
+            return MISSION_SYSTEM(system)->catalog != NULL &&
+                   catalog_is_pending(system, mission_id) ? count : -1;
+        }
+        add_mission(system, position, granularity, first_period, count, points);
+    } else {
+        for (int i = 0; i < system->mission_count; i++) {
+            add_mission(system, i, granularity, first_period, count, points);
+        }
+    }
+    return count;
+}
@@ -0,0 +1,594 @@
+/**
+ * @file sharded.c
+ * @brief Space Mission Control System - Shard-per-Core Front-End
+ *
+ * Missions are partitioned by a hash of their ID across N independent
+ * MissionControl shards. Each shard is owned by one worker thread, which
+ * is the only thread that touches it while operations are in flight, so
+ * shards share no locks and no written cache lines. The front-end thread
+ * hands each operation to its shard through a single-producer /
+ * single-consumer ring: the producer owns `tail`, the consumer owns
+ * `head`, each on its own cache line, and a slot is handed over by a
+ * release store of the index past it.
+ *
+ * A worker creates its shard itself, so with glibc the shard's memory
+ * comes from that thread's malloc arena rather than one shared by all
+ * shards. Idle workers spin briefly and then sleep on a condition
+ * variable; the producer only takes the mutex when a worker is asleep.
+ *
+ * Cross-shard operations (load, report, counts) first wait for every
+ * ring to drain. The workers are idle then, so the front-end can read
+ * the shards directly.
+ */
+
+#define _GNU_SOURCE     // pthread_setaffinity_np(), CPU_SET()
+
+#include "mission_internal.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+
+#define SHARD_RING_CAPACITY 4096        // Commands per ring (power of two)
+#define SHARD_IDLE_SPINS 4096           // Empty polls before a worker sleeps
+#define SHARD_HEAD_BATCH 64             // Commands applied between head updates
+#define SHARD_CACHE_LINE 64
+
+typedef enum {
+    SHARD_OP_CREATE,
+    SHARD_OP_ADD_COMM,
+    SHARD_OP_ACK,
+    SHARD_OP_BULK,
+    SHARD_OP_STOP
+} ShardOp;
+
+typedef struct {
+    ShardOp op;
+    int mission_id;
+    union {
+        struct {
+            char name[MAX_NAME_LENGTH];
+            char launch_date[MAX_DATE_LENGTH];
+        } mission;
+        struct {
+            MessagePriority priority;
+            char timestamp[MAX_TIMESTAMP_LENGTH];
+            char message[MAX_MESSAGE_LENGTH];
+        } comm;
+        int log_id;
+        struct {
+            const MissionSpec *specs;
+            int count;
+        } bulk;
+    } u;
+} ShardCommand;
+
+typedef struct {
+    // Producer side
+    _Alignas(SHARD_CACHE_LINE) unsigned long tail;
+    unsigned long cached_head;          // Last head seen; refreshed when the ring looks full
+    // Consumer side
+    _Alignas(SHARD_CACHE_LINE) unsigned long head;
+    long rejected;                      // Refused operations since the last sync
+    int bulk_created;                   // Result of the last SHARD_OP_BULK
+    int sleeping;                       // Worker is (about to be) blocked on `wake`
+    // Shared, read-mostly
+    _Alignas(SHARD_CACHE_LINE) ShardCommand *ring;
+    MissionControl *system;
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    int initial_capacity;
+    int cpu;                            // CPU to pin to, or -1
+    int first_log_id;                   // Shard k of N numbers its logs k + 1, k + 1 + N, ...
+    int log_id_stride;                  // N
+    int ready;                          // 1 once `system` exists, -1 if it could not be created
+} Shard;
+
+struct ShardedMissionControl {
+    Shard *shards;
+    int shard_count;
+};
+
+/* ========================================
+ * ROUTING
+ * ======================================== */
+static Shard* owning_shard(const ShardedMissionControl* sharded, int mission_id) {
+    // Fibonacci hash, then scale to [0, shard_count) without a division
+    uint32_t hash = (uint32_t)mission_id * 2654435769u;
+    return &sharded->shards[((uint64_t)hash * (uint32_t)sharded->shard_count) >> 32];
+}
+
+/* ========================================
+ * WORKER (consumer side)
+ * ======================================== */
+static void apply_command(Shard* shard, const ShardCommand* command) {
+    int result = 0;
+    switch (command->op) {
+        case SHARD_OP_CREATE:
+            result = create_mission_with_crew(shard->system, command->mission_id,
+                                              command->u.mission.name,
+                                              command->u.mission.launch_date);
+            break;
+        case SHARD_OP_ADD_COMM:
+            result = add_communication(shard->system, command->mission_id,
+                                       command->u.comm.timestamp, command->u.comm.priority,
+                                       command->u.comm.message);
+            break;
+        case SHARD_OP_ACK:
+            result = command->mission_id > 0
+                         ? acknowledge_communication(shard->system, command->mission_id,
+                                                     command->u.log_id)
+                         : acknowledge_communication_by_id(shard->system, command->u.log_id);
+            break;
+        case SHARD_OP_BULK:
+            shard->bulk_created = create_missions_bulk(shard->system, command->u.bulk.specs,
+                                                       command->u.bulk.count);
+            break;
+        case SHARD_OP_STOP:
+            break;
+    }
+    if (result != 0) {
+        __atomic_store_n(&shard->rejected, shard->rejected + 1, __ATOMIC_RELAXED);
+    }
+}
+
+static void wait_for_work(Shard* shard, unsigned long head) {
+    for (int spin = 0; spin < SHARD_IDLE_SPINS; spin++) {
+        if (__atomic_load_n(&shard->tail, __ATOMIC_ACQUIRE) != head) {
+            return;
+        }
+    }
+    // Pairs with the seq_cst tail store / sleeping load in publish_command()
+    pthread_mutex_lock(&shard->lock);
+    __atomic_store_n(&shard->sleeping, 1, __ATOMIC_SEQ_CST);
+    while (__atomic_load_n(&shard->tail, __ATOMIC_SEQ_CST) == head) {
+        pthread_cond_wait(&shard->wake, &shard->lock);
+    }
+    __atomic_store_n(&shard->sleeping, 0, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&shard->lock);
+}
+
+static void pin_to_cpu(int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    // Best effort: an unpinned worker is slower, not wrong
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+static void* shard_main(void* arg) {
+    Shard *shard = arg;
+    if (shard->cpu >= 0) {
+        pin_to_cpu(shard->cpu);
+    }
+    shard->system = create_mission_control(shard->initial_capacity);
+    if (shard->system != NULL) {
+        set_log_id_sequence(shard->system, shard->first_log_id, shard->log_id_stride);
+    }
+    __atomic_store_n(&shard->ready, shard->system != NULL ? 1 : -1, __ATOMIC_RELEASE);
+    if (shard->system == NULL) {
+        return NULL;
+    }
+
+    unsigned long head = shard->head;
+    for (;;) {
+        unsigned long tail = __atomic_load_n(&shard->tail, __ATOMIC_ACQUIRE);
+        if (head == tail) {
+            wait_for_work(shard, head);
+            continue;
+        }
+        while (head != tail) {
+            const ShardCommand *command = &shard->ring[head & (SHARD_RING_CAPACITY - 1)];
+            if (command->op == SHARD_OP_STOP) {
+                __atomic_store_n(&shard->head, head + 1, __ATOMIC_RELEASE);
+                return NULL;
+            }
+            apply_command(shard, command);
+            head++;
+            // Free slots in batches so the producer's cache line is not hit per command
+            if ((head & (SHARD_HEAD_BATCH - 1)) == 0) {
+                __atomic_store_n(&shard->head, head, __ATOMIC_RELEASE);
+            }
+        }
+        __atomic_store_n(&shard->head, head, __ATOMIC_RELEASE);
+    }
+}
+
+/* ========================================
+ * SUBMISSION (producer side)
+ * ======================================== */
+// Next free slot, waiting while the ring is full
+static ShardCommand* reserve_command(Shard* shard) {
+    while (shard->tail - shard->cached_head >= SHARD_RING_CAPACITY) {
+        shard->cached_head = __atomic_load_n(&shard->head, __ATOMIC_ACQUIRE);
+        if (shard->tail - shard->cached_head >= SHARD_RING_CAPACITY) {
+            sched_yield();
+        }
+    }
+    return &shard->ring[shard->tail & (SHARD_RING_CAPACITY - 1)];
+}
+
+static void publish_command(Shard* shard) {
+    __atomic_store_n(&shard->tail, shard->tail + 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&shard->sleeping, __ATOMIC_SEQ_CST)) {
+        pthread_mutex_lock(&shard->lock);
+        pthread_cond_signal(&shard->wake);
+        pthread_mutex_unlock(&shard->lock);
+    }
+}
+
+static void wait_until_drained(Shard* shard) {
+    while (__atomic_load_n(&shard->head, __ATOMIC_ACQUIRE) != shard->tail) {
+        sched_yield();
+    }
+    shard->cached_head = shard->tail;
+}
+
+// Copy `text` into a fixed field; fails instead of truncating
+static int copy_field(char* out, size_t size, const char* text) {
+    size_t length = strlen(text);
+    if (length >= size) {
+        return -1;
+    }
+    memcpy(out, text, length + 1);
+    return 0;
+}
+
+// Copy `text` into a fixed field, cut to fit as create_mission_with_crew() cuts names
+static void copy_truncated(char* out, size_t size, const char* text) {
+    size_t length = strnlen(text, size - 1);
+    memcpy(out, text, length);
+    out[length] = '\0';
+}
+
+/* ========================================
+ * LIFECYCLE
+ * ======================================== */
+static void stop_shard(Shard* shard) {
+    reserve_command(shard)->op = SHARD_OP_STOP;
+    publish_command(shard);
+    pthread_join(shard->thread, NULL);
+}
+
+static void destroy_shards(ShardedMissionControl* sharded, int started) {
+    for (int i = 0; i < started; i++) {
+        Shard *shard = &sharded->shards[i];
+        if (__atomic_load_n(&shard->ready, __ATOMIC_ACQUIRE) == 1) {
+            stop_shard(shard);
+        } else {
+            pthread_join(shard->thread, NULL);
+        }
+        free_mission_control(shard->system);
+        free(shard->ring);
+        pthread_cond_destroy(&shard->wake);
+        pthread_mutex_destroy(&shard->lock);
+    }
+    free(sharded->shards);
+    free(sharded);
+}
+
+ShardedMissionControl* create_sharded_mission_control(int shard_count, int initial_capacity,
+                                                      int pin_threads) {
+    if (shard_count < 0 || initial_capacity <= 0) {
+        return NULL;
+    }
+    if (shard_count == 0) {
+        shard_count = online_cpu_count();
+    }
+    ShardedMissionControl *sharded = calloc(1, sizeof(ShardedMissionControl));
+    if (sharded == NULL) {
+        return NULL;
+    }
+    size_t bytes = (size_t)shard_count * sizeof(Shard);
+    sharded->shards = aligned_alloc(SHARD_CACHE_LINE, bytes);
+    if (sharded->shards == NULL) {
+        free(sharded);
+        return NULL;
+    }
+    memset(sharded->shards, 0, bytes);
+    sharded->shard_count = shard_count;
+
+    int cpus = online_cpu_count();
+    int started = 0;
+    for (; started < shard_count; started++) {
+        Shard *shard = &sharded->shards[started];
+        shard->initial_capacity = initial_capacity;
+        shard->cpu = pin_threads ? started % cpus : -1;
+        shard->first_log_id = started + 1;
+        shard->log_id_stride = shard_count;
+        shard->ring = malloc(SHARD_RING_CAPACITY * sizeof(ShardCommand));
+        if (shard->ring == NULL) {
+            break;
+        }
+        pthread_mutex_init(&shard->lock, NULL);
+        pthread_cond_init(&shard->wake, NULL);
+        if (pthread_create(&shard->thread, NULL, shard_main, shard) != 0) {
+            free(shard->ring);
+            pthread_cond_destroy(&shard->wake);
+            pthread_mutex_destroy(&shard->lock);
+            break;
+        }
+    }
+
+    int failed = started < shard_count;
+    for (int i = 0; i < started; i++) {
+        int ready;
+        while ((ready = __atomic_load_n(&sharded->shards[i].ready, __ATOMIC_ACQUIRE)) == 0) {
+            sched_yield();
+        }
+        failed |= ready < 0;
+    }
+    if (failed) {
+        destroy_shards(sharded, started);
+        return NULL;
+    }
+    return sharded;
+}
+
+void free_sharded_mission_control(ShardedMissionControl* sharded) {
+    if (sharded != NULL) {
+        destroy_shards(sharded, sharded->shard_count);
+    }
+}
+
+int sharded_shard_count(const ShardedMissionControl* sharded) {
+    return sharded != NULL ? sharded->shard_count : 0;
+}
+
+/* ========================================
+ * ROUTED OPERATIONS
+ * ======================================== */
+int sharded_create_mission(ShardedMissionControl* sharded, int mission_id, const char* name,
+                           const char* launch_date) {
+    if (sharded == NULL || mission_id <= 0 || name == NULL || launch_date == NULL) {
+        return -1;
+    }
+    Shard *shard = owning_shard(sharded, mission_id);
+    ShardCommand *command = reserve_command(shard);
+    if (copy_field(command->u.mission.launch_date, sizeof(command->u.mission.launch_date),
+                   launch_date) != 0) {
+        return -1;
+    }
+    copy_truncated(command->u.mission.name, sizeof(command->u.mission.name), name);
+    command->op = SHARD_OP_CREATE;
+    command->mission_id = mission_id;
+    publish_command(shard);
+    return 0;
+}
+
+int sharded_add_communication(ShardedMissionControl* sharded, int mission_id,
+                              const char* timestamp, MessagePriority priority,
+                              const char* message) {
+    if (sharded == NULL || mission_id <= 0 || timestamp == NULL || message == NULL) {
+        return -1;
+    }
+    Shard *shard = owning_shard(sharded, mission_id);
+    ShardCommand *command = reserve_command(shard);
+    if (copy_field(command->u.comm.timestamp, sizeof(command->u.comm.timestamp), timestamp) != 0 ||
+        copy_field(command->u.comm.message, sizeof(command->u.comm.message), message) != 0) {
+        return -1;
+    }
+    command->op = SHARD_OP_ADD_COMM;
+    command->mission_id = mission_id;
+    command->u.comm.priority = priority;
+    publish_command(shard);
+    return 0;
+}
+
+int sharded_acknowledge_communication(ShardedMissionControl* sharded, int mission_id,
+                                      int log_id) {
+    if (sharded == NULL || mission_id <= 0 || log_id <= 0) {
+        return -1;
+    }
+    Shard *shard = owning_shard(sharded, mission_id);
+    ShardCommand *command = reserve_command(shard);
+    command->op = SHARD_OP_ACK;
+    command->mission_id = mission_id;
+    command->u.log_id = log_id;
+    publish_command(shard);
+    return 0;
+}
+
+int sharded_acknowledge_communication_by_id(ShardedMissionControl* sharded, int log_id) {
+    if (sharded == NULL || log_id <= 0) {
+        return -1;
+    }
+    // The shards' ID sequences interleave, so the ID names its shard
+    Shard *shard = &sharded->shards[(log_id - 1) % sharded->shard_count];
+    ShardCommand *command = reserve_command(shard);
+    command->op = SHARD_OP_ACK;
+    command->mission_id = 0;
+    command->u.log_id = log_id;
+    publish_command(shard);
+    return 0;
+}
+
+/* ========================================
+ * CROSS-SHARD OPERATIONS
+ * ======================================== */
+long sharded_sync(ShardedMissionControl* sharded) {
+    if (sharded == NULL) {
+        return 0;
+    }
+    long rejected = 0;
+    for (int i = 0; i < sharded->shard_count; i++) {
+        Shard *shard = &sharded->shards[i];
+        wait_until_drained(shard);
+        rejected += __atomic_exchange_n(&shard->rejected, 0, __ATOMIC_RELAXED);
+    }
+    return rejected;
+}
+
+int sharded_mission_count(ShardedMissionControl* sharded) {
+    if (sharded == NULL) {
+        return 0;
+    }
+    sharded_sync(sharded);
+    int count = 0;
+    for (int i = 0; i < sharded->shard_count; i++) {
+        count += sharded->shards[i].system->mission_count;
+    }
+    return count;
+}
+
+const MissionControl* sharded_get_shard(ShardedMissionControl* sharded, int index) {
+    if (sharded == NULL || index < 0 || index >= sharded->shard_count) {
+        return NULL;
+    }
+    wait_until_drained(&sharded->shards[index]);
+    return sharded->shards[index].system;
+}
+
+// Specs routed to one shard, in file order
+typedef struct {
+    MissionSpec *specs;
+    int count;
+} ShardBatch;
+
+int sharded_load_missions_from_file(ShardedMissionControl* sharded, const char* filename) {
+    if (sharded == NULL || filename == NULL || filename[0] == '\0') {
+        return -1;
+    }
+    FILE *fp = fopen(filename, "r");
+    if (fp == NULL) {
+        return -1;
+    }
+    int declared;
+    if (fscanf(fp, "%d", &declared) != 1 || declared < 0) {
+        fclose(fp);
+        return -1;
+    }
+    MissionRecord *records;
+    int parsed = read_mission_records(fp, declared, &records);
+    fclose(fp);
+    if (parsed < 0) {
+        return -1;
+    }
+    int result = parsed == declared ? 0 : -1;
+
+    size_t slots = parsed > 0 ? (size_t)parsed : 1;
+    MissionSpec *specs = malloc(slots * sizeof(MissionSpec));
+    ShardBatch *batches = calloc((size_t)sharded->shard_count, sizeof(ShardBatch));
+    int *order = malloc(slots * sizeof(int));
+    if (specs == NULL || batches == NULL || order == NULL) {
+        free(records);
+        free(specs);
+        free(batches);
+        free(order);
+        return -1;
+    }
+
+    // Cut the batch where load_missions_from_file() would stop, before it
+    // is split: at a repeated ID, or one already in its shard
+    sharded_sync(sharded);
+    int accepted = first_repeated_record(records, parsed);
+    for (int i = 0; i < accepted; i++) {
+        int id = records[i].mission_id;
+        if (mission_index_find(owning_shard(sharded, id)->system, id) >= 0) {
+            accepted = i;
+        }
+    }
+    if (accepted != parsed) {
+        parsed = accepted > 0 ? accepted : 0;
+        result = -1;
+    }
+
+    // Counting sort by shard keeps file order within each shard
+    for (int i = 0; i < parsed; i++) {
+        order[i] = (int)(owning_shard(sharded, records[i].mission_id) - sharded->shards);
+        batches[order[i]].count++;
+    }
+    int offset = 0;
+    for (int s = 0; s < sharded->shard_count; s++) {
+        batches[s].specs = specs + offset;
+        offset += batches[s].count;
+        batches[s].count = 0;
+    }
+    for (int i = 0; i < parsed; i++) {
+        ShardBatch *batch = &batches[order[i]];
+        MissionSpec *spec = &batch->specs[batch->count++];
+        spec->mission_id = records[i].mission_id;
+        spec->name = records[i].mission_name;
+        spec->launch_date = records[i].launch_date;
+    }
+
+    // The shards insert their batches in parallel
+    for (int s = 0; s < sharded->shard_count; s++) {
+        if (batches[s].count == 0) {
+            continue;
+        }
+        ShardCommand *command = reserve_command(&sharded->shards[s]);
+        command->op = SHARD_OP_BULK;
+        command->u.bulk.specs = batches[s].specs;
+        command->u.bulk.count = batches[s].count;
+        publish_command(&sharded->shards[s]);
+    }
+    sharded_sync(sharded);
+    for (int s = 0; s < sharded->shard_count; s++) {
+        if (batches[s].count > 0 && sharded->shards[s].bulk_created != batches[s].count) {
+            result = -1;
+        }
+    }
+
+    free(records);
+    free(specs);
+    free(batches);
+    free(order);
+    return result;
+}
+
+typedef struct {
+    int mission_id;
+    const Mission *mission;
+    const MissionCold *cold;
+} ReportEntry;
+
+static int compare_report_entries(const void* a, const void* b) {
+    int ia = ((const ReportEntry*)a)->mission_id;
+    int ib = ((const ReportEntry*)b)->mission_id;
+    return (ia > ib) - (ia < ib);
+}
+
+int sharded_save_mission_report(ShardedMissionControl* sharded, const char* filename) {
+    if (sharded == NULL || filename == NULL || filename[0] == '\0') {
+        return -1;
+    }
+    int mission_count = sharded_mission_count(sharded);
+    ReportEntry *entries = malloc((mission_count > 0 ? (size_t)mission_count : 1) *
+                                  sizeof(ReportEntry));
+    if (entries == NULL) {
+        return -1;
+    }
+    int n = 0;
+    for (int s = 0; s < sharded->shard_count; s++) {
+        const MissionControl *system = sharded->shards[s].system;
+        for (int i = 0; i < system->mission_count; i++) {
+            entries[n].mission_id = system->missions[i].mission_id;
+            entries[n].mission = &system->missions[i];
+            entries[n].cold = MISSION_COLD(system, i);
+            n++;
+        }
+    }
+    qsort(entries, (size_t)n, sizeof(ReportEntry), compare_report_entries);
+
+    FILE *fp = fopen(filename, "w");
+    if (fp == NULL) {
+        free(entries);
+        return -1;
+    }
+    char block[REPORT_BLOCK_MAX];
+    int total_comms = 0;
+    fwrite(block, 1, report_format_header(block, sizeof(block), n), fp);
+    for (int i = 0; i < n; i++) {
+        const Mission *m = entries[i].mission;
+        const MissionCold *cold = entries[i].cold;
+        MissionView view = { m->mission_id, cold->mission_name, cold->launch_date, m->status,
+                             m->communications, m->comm_count };
+        total_comms += m->comm_count;
+        fwrite(block, 1, report_format_mission(block, sizeof(block), i, &view), fp);
+    }
+    fwrite(block, 1, report_format_totals(block, sizeof(block), total_comms), fp);
+    free(entries);
+    return fclose(fp) == 0 ? 0 : -1;
+}
@@ -0,0 +1,163 @@
+/**
+ * @file shm_reader.c
+ * @brief Space Mission Control System - Shared-Memory View Reader Library
+ *
+ * Read-only client for the segment published by enable_shared_view().
+ * After shm_view_open() every query is plain loads from the mapping: no
+ * syscalls, no locks, and nothing the publishing process has to service.
+ * Built standalone (libspace_mission_shm.a) so dashboards do not link the
+ * core.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "space_mission_shm.h"
+
+#include <fcntl.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define SHM_READ_SPINS 1000         // Busy retries before yielding the CPU
+#define SHM_READ_ATTEMPTS 100000    // Give up on a slot that never settles
+
+struct SharedMissionView {
+    void *base;
+    size_t size;
+    const ShmViewHeader *header;
+    const ShmMissionSlot *slots;
+    const int32_t *index;
+};
+
+/* ========================================
+ * OPEN / CLOSE
+ * ======================================== */
+SharedMissionView* shm_view_open(const char* name) {
+    if (name == NULL) {
+        return NULL;
+    }
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) {
+        return NULL;
+    }
+    struct stat st;
+    void *base = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(ShmViewHeader)) {
+        base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (base == MAP_FAILED) {
+        return NULL;
+    }
+
+    // Validate the layout before trusting any offsets derived from it
+    const ShmViewHeader *header = base;
+    size_t size = (size_t)st.st_size;
+    size_t slots_bytes = (size_t)header->capacity * sizeof(ShmMissionSlot);
+    size_t index_bytes = (size_t)header->index_capacity * sizeof(int32_t);
+    SharedMissionView *view = malloc(sizeof(SharedMissionView));
+    if (view == NULL || __atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) != SHM_VIEW_MAGIC ||
+        header->version != SHM_VIEW_VERSION || header->capacity <= 0 ||
+        header->index_capacity <= 0 || (header->index_capacity & (header->index_capacity - 1)) != 0 ||
+        sizeof(ShmViewHeader) + slots_bytes + index_bytes > size) {
+        free(view);
+        munmap(base, size);
+        return NULL;
+    }
+    view->base = base;
+    view->size = size;
+    view->header = header;
+    view->slots = (const ShmMissionSlot*)((const char*)base + sizeof(ShmViewHeader));
+    view->index = (const int32_t*)((const char*)view->slots + slots_bytes);
+    return view;
+}
+
+void shm_view_close(SharedMissionView* view) {
+    if (view == NULL) {
+        return;
+    }
+    munmap(view->base, view->size);
+    free(view);
+}
+
+/* ========================================
+ * SEQLOCK READS
+ * ======================================== */
+static int read_slot(const ShmMissionSlot* slot, SharedMissionInfo* out) {
+    for (int attempt = 0; attempt < SHM_READ_ATTEMPTS; attempt++) {
+        if (attempt >= SHM_READ_SPINS) {
+            sched_yield();
+        }
+        uint32_t begin = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+        if (begin & 1u) {
+            continue;
+        }
+        out->mission_id = __atomic_load_n(&slot->mission_id, __ATOMIC_RELAXED);
+        out->launch_day = __atomic_load_n(&slot->launch_day, __ATOMIC_RELAXED);
+        out->status = __atomic_load_n(&slot->status, __ATOMIC_RELAXED);
+        out->comm_count = __atomic_load_n(&slot->comm_count, __ATOMIC_RELAXED);
+        out->unacked_count = __atomic_load_n(&slot->unacked_count, __ATOMIC_RELAXED);
+        for (int p = 0; p < SHM_PRIORITY_LEVELS; p++) {
+            out->priority_counts[p] = __atomic_load_n(&slot->priority_counts[p], __ATOMIC_RELAXED);
+        }
+        memcpy(out->mission_name, slot->mission_name, sizeof(out->mission_name));
+        memcpy(out->launch_date, slot->launch_date, sizeof(out->launch_date));
+        memcpy(out->last_timestamp, slot->last_timestamp, sizeof(out->last_timestamp));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) == begin) {
+            // Strings come from shared memory; never hand out unterminated ones
+            out->mission_name[sizeof(out->mission_name) - 1] = '\0';
+            out->launch_date[sizeof(out->launch_date) - 1] = '\0';
+            out->last_timestamp[sizeof(out->last_timestamp) - 1] = '\0';
+            return 0;
+        }
+    }
+    return -1;  // The publisher died mid-update
+}
+
+/* ========================================
+ * QUERIES
+ * ======================================== */
+int shm_view_mission_count(const SharedMissionView* view) {
+    if (view == NULL) {
+        return 0;
+    }
+    int count = __atomic_load_n(&view->header->mission_count, __ATOMIC_ACQUIRE);
+    return count <= view->header->capacity ? count : view->header->capacity;
+}
+
+long shm_view_total_communications(const SharedMissionView* view) {
+    return view != NULL ? (long)__atomic_load_n(&view->header->total_comms, __ATOMIC_RELAXED) : 0;
+}
+
+int shm_view_get_mission(const SharedMissionView* view, int index, SharedMissionInfo* out) {
+    if (view == NULL || out == NULL || index < 0 || index >= shm_view_mission_count(view)) {
+        return -1;
+    }
+    return read_slot(&view->slots[index], out);
+}
+
+int shm_view_find_mission(const SharedMissionView* view, int mission_id, SharedMissionInfo* out) {
+    if (view == NULL || out == NULL || mission_id <= 0) {
+        return -1;
+    }
+    int32_t index_capacity = view->header->index_capacity;
+    uint32_t mask = (uint32_t)(index_capacity - 1);
+    uint32_t slot = shm_view_index_slot(mission_id, index_capacity);
+    for (int32_t probes = 0; probes < index_capacity; probes++, slot = (slot + 1) & mask) {
+        int32_t entry = __atomic_load_n(&view->index[slot], __ATOMIC_ACQUIRE);
+        if (entry == 0) {
+            return -1;
+        }
+        // A removal may move another mission into the slot while we read it
+        if (entry > 0 && entry <= view->header->capacity &&
+            __atomic_load_n(&view->slots[entry - 1].mission_id, __ATOMIC_RELAXED) == mission_id &&
+            read_slot(&view->slots[entry - 1], out) == 0 && out->mission_id == mission_id) {
+            return 0;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,303 @@
+/**
+ * @file shm_view.c
+ * @brief Space Mission Control System - Shared-Memory View Publisher
+ *
+ * Mirrors mission metadata and per-mission counters into a POSIX
+ * shared-memory segment (layout in space_mission_shm.h) so dashboards in
+ * other processes can read them without syscalls or copies through the
+ * ingest process. Slot i mirrors system->missions[i]; the writer updates a
+ * slot in place under its seqlock whenever that mission changes. The
+ * slot's log counters are the view's own: a mission's logs are counted
+ * once when it is mirrored, and the append, ack and purge hooks apply
+ * their change to them.
+ *
+ * The segment is sized once, when the view is enabled. Missions created
+ * after the slots run out are counted in missions_dropped but not mirrored.
+ * remove_mission() is mirrored as the same swap-remove: the last slot's
+ * mission moves into the freed slot and the removed ID's index entry
+ * becomes a tombstone, reused by later insertions.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mission_internal.h"
+#include "space_mission_shm.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+
+#define INDEX_REMOVED (-1)
+
+_Static_assert(SHM_NAME_LENGTH == MAX_NAME_LENGTH, "shared name length mismatch");
+_Static_assert(SHM_DATE_LENGTH == MAX_DATE_LENGTH, "shared date length mismatch");
+_Static_assert(SHM_TIMESTAMP_LENGTH == MAX_TIMESTAMP_LENGTH, "shared timestamp length mismatch");
+_Static_assert(SHM_PRIORITY_LEVELS == EMERGENCY + 1, "shared priority levels mismatch");
+
+struct SharedView {
+    char *name;
+    void *base;
+    size_t size;
+    ShmViewHeader *header;
+    ShmMissionSlot *slots;
+    int32_t *index;
+};
+
+/* ========================================
+ * SLOT PUBLISHING
+ * ======================================== */
+static void write_identity(ShmMissionSlot* slot, const Mission* mission, const MissionCold* cold) {
+    int launch_day = 0;
+    parse_date_to_epoch_day(cold->launch_date, &launch_day);
+    __atomic_store_n(&slot->mission_id, mission->mission_id, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot->launch_day, launch_day, __ATOMIC_RELAXED);
+    memcpy(slot->mission_name, cold->mission_name, sizeof(slot->mission_name));
+    memcpy(slot->launch_date, cold->launch_date, sizeof(slot->launch_date));
+}
+
+// The counts a slot currently publishes; only the writer calls this
+static void slot_counts(const ShmMissionSlot* slot, MissionLogCounts* out) {
+    out->unacked_count = slot->unacked_count;
+    for (int p = 0; p < SHM_PRIORITY_LEVELS; p++) {
+        out->priority_counts[p] = slot->priority_counts[p];
+    }
+}
+
+// The counts of a mission that is not mirrored yet
+static void mission_log_counts(const MissionControl* system, int position, MissionLogCounts* out) {
+    const Mission *mission = &system->missions[position];
+    count_mission_logs(mission->communications, mission->comm_count, out);
+}
+
+// Seqlock write side; the writer is the only thread that touches `seq`
+static void publish_slot(ShmMissionSlot* slot, const MissionControl* system, int position,
+                         int with_identity, const MissionLogCounts* counts) {
+    const Mission *mission = &system->missions[position];
+    const MissionCold *cold = MISSION_COLD(system, position);
+    uint32_t seq = slot->seq;
+    __atomic_store_n(&slot->seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    // Readers discard copies taken while seq was odd or changed
+    if (with_identity) {
+        write_identity(slot, mission, cold);
+    }
+    __atomic_store_n(&slot->status, (int32_t)mission->status, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot->comm_count, mission->comm_count, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot->unacked_count, counts->unacked_count, __ATOMIC_RELAXED);
+    for (int p = 0; p < SHM_PRIORITY_LEVELS; p++) {
+        __atomic_store_n(&slot->priority_counts[p], counts->priority_counts[p], __ATOMIC_RELAXED);
+    }
+    if (mission->comm_count > 0) {
+        memcpy(slot->last_timestamp, mission->communications[mission->comm_count - 1].timestamp,
+               sizeof(slot->last_timestamp));
+    } else {
+        memset(slot->last_timestamp, 0, sizeof(slot->last_timestamp));
+    }
+
+    __atomic_store_n(&slot->seq, seq + 2, __ATOMIC_RELEASE);
+}
+
+static void index_insert(SharedView* view, int32_t mission_id, int32_t position) {
+    uint32_t mask = (uint32_t)(view->header->index_capacity - 1);
+    uint32_t slot = shm_view_index_slot(mission_id, view->header->index_capacity);
+    while (view->index[slot] > 0) {
+        slot = (slot + 1) & mask;
+    }
+    __atomic_store_n(&view->index[slot], position + 1, __ATOMIC_RELEASE);
+}
+
+// Rewrite the entry of `mission_id` that points at `position`
+static void index_replace(SharedView* view, int32_t mission_id, int32_t position, int32_t entry) {
+    uint32_t mask = (uint32_t)(view->header->index_capacity - 1);
+    uint32_t slot = shm_view_index_slot(mission_id, view->header->index_capacity);
+    for (int32_t probes = 0; probes < view->header->index_capacity && view->index[slot] != 0;
+         probes++, slot = (slot + 1) & mask) {
+        if (view->index[slot] == position + 1) {
+            __atomic_store_n(&view->index[slot], entry, __ATOMIC_RELEASE);
+            return;
+        }
+    }
+}
+
+/* ========================================
+ * MAINTENANCE HOOKS
+ * ======================================== */
+void shared_view_add_missions(MissionControl* system, int first, int count) {
+    SharedView *view = MISSION_SYSTEM(system)->shared_view;
+    ShmViewHeader *header = view->header;
+    int mirrored = 0;
+    for (int i = 0; i < count; i++) {
+        int position = first + i;
+        if (position >= header->capacity) {
+            break;
+        }
+        // The slot becomes reachable only once mission_count covers it
+        MissionLogCounts counts;
+        mission_log_counts(system, position, &counts);
+        publish_slot(&view->slots[position], system, position, 1, &counts);
+        mirrored++;
+    }
+
+    if (mirrored > 0) {
+        __atomic_store_n(&header->mission_count, first + mirrored, __ATOMIC_RELEASE);
+        for (int i = 0; i < mirrored; i++) {
+            index_insert(view, system->missions[first + i].mission_id, first + i);
+        }
+    }
+    if (mirrored < count) {
+        __atomic_store_n(&header->missions_dropped, header->missions_dropped + (count - mirrored),
+                         __ATOMIC_RELAXED);
+    }
+}
+
+void shared_view_update(MissionControl* system, int position, const MissionLogCounts* delta) {
+    SharedView *view = MISSION_SYSTEM(system)->shared_view;
+    if (position >= view->header->capacity) {
+        return;
+    }
+    MissionLogCounts counts;
+    slot_counts(&view->slots[position], &counts);
+    int new_logs = 0;
+    for (int p = ROUTINE; p <= EMERGENCY; p++) {
+        counts.priority_counts[p] += delta->priority_counts[p];
+        new_logs += delta->priority_counts[p];
+    }
+    counts.unacked_count += delta->unacked_count;
+    publish_slot(&view->slots[position], system, position, 0, &counts);
+    if (new_logs != 0) {
+        __atomic_store_n(&view->header->total_comms, view->header->total_comms + new_logs,
+                         __ATOMIC_RELAXED);
+    }
+}
+
+void shared_view_remove_mission(MissionControl* system, int position) {
+    SharedView *view = MISSION_SYSTEM(system)->shared_view;
+    ShmViewHeader *header = view->header;
+    int last = system->mission_count - 1;
+    if (position >= header->capacity) {
+        // Neither the removed nor the last mission is mirrored
+        __atomic_store_n(&header->missions_dropped, header->missions_dropped - 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    const Mission *removed = &system->missions[position];
+    const Mission *moved = &system->missions[last];
+    long total_comms = header->total_comms - removed->comm_count;
+    index_replace(view, removed->mission_id, position, INDEX_REMOVED);
+    if (last == position) {
+        __atomic_store_n(&header->mission_count, last, __ATOMIC_RELEASE);
+    } else if (last < header->capacity) {
+        MissionLogCounts counts;
+        slot_counts(&view->slots[last], &counts);
+        publish_slot(&view->slots[position], system, last, 1, &counts);
+        index_replace(view, moved->mission_id, last, position + 1);
+        __atomic_store_n(&header->mission_count, last, __ATOMIC_RELEASE);
+    } else {
+        // The moved mission was not mirrored until now
+        MissionLogCounts counts;
+        mission_log_counts(system, last, &counts);
+        publish_slot(&view->slots[position], system, last, 1, &counts);
+        index_insert(view, moved->mission_id, position);
+        total_comms += moved->comm_count;
+        __atomic_store_n(&header->missions_dropped, header->missions_dropped - 1, __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&header->total_comms, total_comms, __ATOMIC_RELAXED);
+}
+
+void shared_view_free(MissionControl* system) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    SharedView *view = sys->shared_view;
+    if (view == NULL) {
+        return;
+    }
+    munmap(view->base, view->size);
+    shm_unlink(view->name);
+    free(view->name);
+    free(view);
+    sys->shared_view = NULL;
+}
+
+/* ========================================
+ * PUBLIC API
+ * ======================================== */
+static int create_segment(const char* name, size_t size) {
+    int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0 && errno == EEXIST) {
+        // Left behind by a publisher that did not shut down cleanly
+        shm_unlink(name);
+        fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644);
+    }
+    if (fd >= 0 && ftruncate(fd, (off_t)size) != 0) {
+        close(fd);
+        shm_unlink(name);
+        fd = -1;
+    }
+    return fd;
+}
+
+int enable_shared_view(MissionControl* system, const char* name, int max_missions) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    if (system == NULL || name == NULL || name[0] != '/' || max_missions <= 0 ||
+        max_missions > (1 << 28)) {
+        return -1;
+    }
+    if (sys->shared_view != NULL) {
+        return 0;
+    }
+
+    int index_capacity = 16;
+    while (index_capacity < max_missions * 2) {
+        index_capacity *= 2;
+    }
+    size_t slots_offset = sizeof(ShmViewHeader);
+    size_t index_offset = slots_offset + (size_t)max_missions * sizeof(ShmMissionSlot);
+    size_t size = index_offset + (size_t)index_capacity * sizeof(int32_t);
+
+    SharedView *view = calloc(1, sizeof(SharedView));
+    if (view == NULL || (view->name = strdup(name)) == NULL) {
+        free(view);
+        return -1;
+    }
+    int fd = create_segment(name, size);
+    if (fd < 0) {
+        free(view->name);
+        free(view);
+        return -1;
+    }
+    view->base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (view->base == MAP_FAILED) {
+        shm_unlink(name);
+        free(view->name);
+        free(view);
+        return -1;
+    }
+    view->size = size;
+    view->header = view->base;
+    view->slots = (ShmMissionSlot*)((char*)view->base + slots_offset);
+    view->index = (int32_t*)((char*)view->base + index_offset);
+
+    // The fresh segment is zero-filled; readers reject it until magic is set
+    view->header->version = SHM_VIEW_VERSION;
+    view->header->capacity = max_missions;
+    view->header->index_capacity = index_capacity;
+    sys->shared_view = view;
+
+    long total_comms = 0;
+    for (int i = 0; i < system->mission_count && i < max_missions; i++) {
+        total_comms += system->missions[i].comm_count;
+    }
+    view->header->total_comms = total_comms;
+    if (system->mission_count > 0) {
+        shared_view_add_missions(system, 0, system->mission_count);
+    }
+    __atomic_store_n(&view->header->magic, SHM_VIEW_MAGIC, __ATOMIC_RELEASE);
+    return 0;
+}
+
+void disable_shared_view(MissionControl* system) {
+    if (system != NULL) {
+        shared_view_free(system);
+    }
+}
@@ -0,0 +1,386 @@
+/**
+ * @file snapshot.c
+ * @brief Space Mission Control System - Consistent Snapshots Under Ingest
+ *
+ * Creations and appends are ordered by marks derived from the log
+ * directory: the k-th log committed (log_id first_log_id + k * stride) has
+ * mark 2k + 2, and a mission created after L logs has mark 2L + 1, kept
+ * by position in a table owned by this module. The writer fills in the
+ * entry, publishes the new count with a release store and only then
+ * raises `published` past the entry's mark, so a reader that loads
+ * published = S first is guaranteed to see every entry with a mark below
+ * S. The snapshot is "everything before S": per mission, the captured
+ * count is the live count minus the few tail entries appended since S.
+ * Missions that existed when snapshots were enabled have mark 0.
+ *
+ * Logs are append-only, so contents are shared with the live arrays
+ * rather than copied. The only hazard is the writer freeing an array a
+ * reader still holds: while snapshots are enabled, grown arrays are
+ * copied, the replacement is published, and the old block is handed to
+ * retire_shared_array(), which frees it immediately when no snapshot is
+ * open and otherwise defers it until the last open snapshot ends. The
+ * writer never blocks on a reader beyond an uncontended mutex on growth.
+ *
+ * remove_mission() and purge_communications() are not versioned: a
+ * snapshot reflects the removals made before it was captured. They copy
+ * the arrays they rearrange the same way growth does, and bracket the
+ * change with system->layout_generation (a seqlock) so that capture
+ * retries rather than mixing counts and arrays from either side of it.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mission_internal.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+// Creation marks by mission position; replaced, never resized in place
+typedef struct {
+    int capacity;
+    long marks[];
+} MissionMarks;
+
+struct MissionSnapshots {
+    long published;             // Entries with a lower mark are visible (atomic)
+    MissionMarks *missions;     // Creation mark of each mission (atomic pointer)
+    int active;                 // Open snapshots (atomic)
+    pthread_mutex_t lock;       // Guards the retired list
+    void **retired;             // Arrays waiting for active to drop to zero
+    int retired_count;
+    int retired_capacity;
+};
+
+struct MissionSnapshot {
+    MissionSnapshots *owner;
+    long cutoff;                // Entries with a lower mark are visible
+    int mission_count;
+    const Mission **missions;   // Mission records (identity fields are immutable)
+    const MissionCold **colds;  // Their names and launch dates (see MISSION_COLD)
+    const CommLog **comms;      // Log array each count refers to
+    int *comm_counts;           // Logs visible to the snapshot
+};
+
+/* ========================================
+ * DEFERRED RECLAMATION
+ * ======================================== */
+static void free_retired(MissionSnapshots* state) {
+    for (int i = 0; i < state->retired_count; i++) {
+        free(state->retired[i]);
+    }
+    state->retired_count = 0;
+}
+
+void retire_shared_array(MissionControl* system, void* old_array) {
+    MissionSnapshots *state = MISSION_SYSTEM(system)->snapshots;
+    if (old_array == NULL) {
+        return;
+    }
+    // Pairs with the seq_cst increment in begin_mission_snapshot(): either
+    // that reader already loads the new pointer, or we see it as active
+    if (__atomic_load_n(&state->active, __ATOMIC_SEQ_CST) == 0) {
+        free(old_array);
+        return;
+    }
+
+    pthread_mutex_lock(&state->lock);
+    if (state->retired_count >= state->retired_capacity) {
+        int new_capacity = state->retired_capacity > 0 ? state->retired_capacity * 2 : 16;
+        void **grown = realloc(state->retired, new_capacity * sizeof(void*));
+        if (grown == NULL) {
+            // Leaking is the only safe option left; the array may be in use
+            pthread_mutex_unlock(&state->lock);
+            return;
+        }
+        state->retired = grown;
+        state->retired_capacity = new_capacity;
+    }
+    state->retired[state->retired_count++] = old_array;
+    pthread_mutex_unlock(&state->lock);
+}
+
+void layout_change_begin(MissionControl* system) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    __atomic_store_n(&sys->layout_generation, sys->layout_generation + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+void layout_change_end(MissionControl* system) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    __atomic_store_n(&sys->layout_generation, sys->layout_generation + 1, __ATOMIC_RELEASE);
+}
+
+/* ========================================
+ * MARKS
+ * ======================================== */
+static long log_mark(const MissionSystem* sys, int log_id) {
+    return 2 * (((long)log_id - sys->first_log_id) / sys->log_id_stride) + 2;
+}
+
+// Zeroed marks for `capacity` missions
+static MissionMarks* create_marks(int capacity) {
+    MissionMarks *marks = calloc(1, sizeof(MissionMarks) + (size_t)capacity * sizeof(long));
+    if (marks != NULL) {
+        marks->capacity = capacity;
+    }
+    return marks;
+}
+
+int snapshot_resize_marks(MissionControl* system, int new_capacity) {
+    MissionSnapshots *state = MISSION_SYSTEM(system)->snapshots;
+    MissionMarks *old_marks = state->missions;
+    MissionMarks *new_marks = create_marks(new_capacity);
+    if (new_marks == NULL) {
+        return -1;
+    }
+    memcpy(new_marks->marks, old_marks->marks, (size_t)system->mission_count * sizeof(long));
+    __atomic_store_n(&state->missions, new_marks, __ATOMIC_SEQ_CST);
+    retire_shared_array(system, old_marks);
+    return 0;
+}
+
+void snapshot_mark_missions(MissionControl* system, int first, int count) {
+    const MissionSystem *sys = MISSION_SYSTEM(system);
+    long mark = 2L * sys->logs_committed + 1;
+    for (int i = first; i < first + count; i++) {
+        __atomic_store_n(&sys->snapshots->missions->marks[i], mark, __ATOMIC_RELAXED);
+    }
+}
+
+void snapshot_move_mark(MissionControl* system, int last, int position) {
+    long *marks = MISSION_SYSTEM(system)->snapshots->missions->marks;
+    __atomic_store_n(&marks[position], marks[last], __ATOMIC_RELAXED);
+}
+
+void snapshot_publish_missions(MissionControl* system) {
+    const MissionSystem *sys = MISSION_SYSTEM(system);
+    __atomic_store_n(&sys->snapshots->published, 2L * sys->logs_committed + 2, __ATOMIC_RELEASE);
+}
+
+void snapshot_publish_log(MissionControl* system) {
+    const MissionSystem *sys = MISSION_SYSTEM(system);
+    __atomic_store_n(&sys->snapshots->published, 2L * sys->logs_committed + 1, __ATOMIC_RELEASE);
+}
+
+/* ========================================
+ * ENABLE / DISABLE
+ * ======================================== */
+int enable_mission_snapshots(MissionControl* system) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    if (system == NULL) {
+        return -1;
+    }
+    if (sys->snapshots != NULL) {
+        return 0;
+    }
+    MissionSnapshots *state = calloc(1, sizeof(MissionSnapshots));
+    if (state == NULL) {
+        return -1;
+    }
+    state->missions = create_marks(system->capacity);
+    if (state->missions == NULL) {
+        free(state);
+        return -1;
+    }
+    if (pthread_mutex_init(&state->lock, NULL) != 0) {
+        free(state->missions);
+        free(state);
+        return -1;
+    }
+    // Everything committed so far is visible; existing missions keep mark 0
+    state->published = 2L * sys->logs_committed + 1;
+    sys->snapshots = state;
+    return 0;
+}
+
+void disable_mission_snapshots(MissionControl* system) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    if (system == NULL || sys->snapshots == NULL) {
+        return;
+    }
+    MissionSnapshots *state = sys->snapshots;
+    free_retired(state);
+    free(state->retired);
+    free(state->missions);
+    pthread_mutex_destroy(&state->lock);
+    free(state);
+    sys->snapshots = NULL;
+}
+
+/* ========================================
+ * SNAPSHOT LIFECYCLE
+ * ======================================== */
+MissionSnapshot* snapshot_open(const MissionControl* system) {
+    const MissionSystem *sys = MISSION_SYSTEM(system);
+    MissionSnapshot *snapshot = calloc(1, sizeof(MissionSnapshot));
+    if (snapshot == NULL) {
+        return NULL;
+    }
+    MissionSnapshots *state = sys->snapshots;
+    snapshot->owner = state;
+    __atomic_add_fetch(&state->active, 1, __ATOMIC_SEQ_CST);
+    snapshot->cutoff = __atomic_load_n(&state->published, __ATOMIC_ACQUIRE);
+    return snapshot;
+}
+
+static int alloc_capture(MissionSnapshot* snapshot, int mission_count) {
+    size_t slots = mission_count > 0 ? (size_t)mission_count : 1;
+    free(snapshot->missions);
+    free(snapshot->colds);
+    free(snapshot->comms);
+    free(snapshot->comm_counts);
+    snapshot->missions = malloc(slots * sizeof(const Mission*));
+    snapshot->colds = malloc(slots * sizeof(const MissionCold*));
+    snapshot->comms = malloc(slots * sizeof(const CommLog*));
+    snapshot->comm_counts = malloc(slots * sizeof(int));
+    if (snapshot->missions == NULL || snapshot->colds == NULL || snapshot->comms == NULL ||
+        snapshot->comm_counts == NULL) {
+        return -1;
+    }
+    return 0;
+}
+
+int snapshot_capture(MissionSnapshot* snapshot, const MissionControl* system) {
+    const MissionSystem *sys = MISSION_SYSTEM(system);
+    // Order matters: counts after the cut-off was read, then the arrays the
+    // counts index (a newer array always holds at least as many entries).
+    // Arrays loaded now are protected because the snapshot is already open.
+    long cutoff = snapshot->cutoff;
+    const MissionSnapshots *state = sys->snapshots;
+    for (;;) {
+        unsigned long generation = __atomic_load_n(&sys->layout_generation, __ATOMIC_ACQUIRE);
+        if (generation & 1ul) {
+            sched_yield();
+            continue;
+        }
+        int mission_count = __atomic_load_n(&system->mission_count, __ATOMIC_ACQUIRE);
+        const Mission *missions = __atomic_load_n(&system->missions, __ATOMIC_ACQUIRE);
+#ifdef MISSION_HOT_COLD
+        const MissionCold *colds = __atomic_load_n(&sys->mission_cold, __ATOMIC_ACQUIRE);
+#else
+        const MissionCold *colds = missions;
+#endif
+        const MissionMarks *marks = __atomic_load_n(&state->missions, __ATOMIC_ACQUIRE);
+        if (alloc_capture(snapshot, mission_count) != 0) {
+            return -1;
+        }
+
+        int captured = 0;
+        for (int i = 0; i < mission_count; i++) {
+            const Mission *mission = &missions[i];
+            // Not only at the tail: removals move the last mission forward
+            if (__atomic_load_n(&marks->marks[i], __ATOMIC_RELAXED) >= cutoff) {
+                continue;
+            }
+            int count = __atomic_load_n(&mission->comm_count, __ATOMIC_ACQUIRE);
+            const CommLog *comms = __atomic_load_n(&mission->communications, __ATOMIC_ACQUIRE);
+            while (count > 0 && log_mark(sys, comms[count - 1].log_id) >= cutoff) {
+                count--;
+            }
+            snapshot->missions[captured] = mission;
+            snapshot->colds[captured] = &colds[i];
+            snapshot->comms[captured] = comms;
+            snapshot->comm_counts[captured] = count;
+            captured++;
+        }
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&sys->layout_generation, __ATOMIC_RELAXED) == generation) {
+            snapshot->mission_count = captured;
+            return 0;
+        }
+    }
+}
+
+MissionSnapshot* begin_mission_snapshot(const MissionControl* system) {
+    if (system == NULL || MISSION_SYSTEM(system)->snapshots == NULL) {
+        return NULL;
+    }
+    MissionSnapshot *snapshot = snapshot_open(system);
+    if (snapshot != NULL && snapshot_capture(snapshot, system) != 0) {
+        end_mission_snapshot(snapshot);
+        return NULL;
+    }
+    return snapshot;
+}
+
+void end_mission_snapshot(MissionSnapshot* snapshot) {
+    if (snapshot == NULL) {
+        return;
+    }
+    MissionSnapshots *state = snapshot->owner;
+    pthread_mutex_lock(&state->lock);
+    if (__atomic_sub_fetch(&state->active, 1, __ATOMIC_SEQ_CST) == 0) {
+        free_retired(state);
+    }
+    pthread_mutex_unlock(&state->lock);
+
+    free(snapshot->missions);
+    free(snapshot->colds);
+    free(snapshot->comms);
+    free(snapshot->comm_counts);
+    free(snapshot);
+}
+
+/* ========================================
+ * READING
+ * ======================================== */
+int snapshot_mission_count(const MissionSnapshot* snapshot) {
+    return snapshot != NULL ? snapshot->mission_count : 0;
+}
+
+int snapshot_get_mission(const MissionSnapshot* snapshot, int index, MissionView* out) {
+    if (snapshot == NULL || out == NULL || index < 0 || index >= snapshot->mission_count) {
+        return -1;
+    }
+    const Mission *mission = snapshot->missions[index];
+    out->mission_id = mission->mission_id;
+    out->mission_name = snapshot->colds[index]->mission_name;
+    out->launch_date = snapshot->colds[index]->launch_date;
+    out->status = mission->status;
+    out->communications = snapshot->comms[index];
+    out->comm_count = snapshot->comm_counts[index];
+    return 0;
+}
+
+int emit_snapshot_report(const MissionSnapshot* snapshot, ReportSink sink, void* context) {
+    char block[REPORT_BLOCK_MAX];
+    int length = report_format_header(block, sizeof(block), snapshot->mission_count);
+    if (sink(context, block, (size_t)length) != 0) {
+        return -1;
+    }
+
+    int total_comms = 0;
+    for (int i = 0; i < snapshot->mission_count; i++) {
+        MissionView view;
+        snapshot_get_mission(snapshot, i, &view);
+
+        total_comms += view.comm_count;
+        length = report_format_mission(block, sizeof(block), i, &view);
+        if (sink(context, block, (size_t)length) != 0) {
+            return -1;
+        }
+    }
+
+    length = report_format_totals(block, sizeof(block), total_comms);
+    return sink(context, block, (size_t)length);
+}
+
+static int file_sink(void* context, const char* data, size_t length) {
+    return fwrite(data, 1, length, (FILE*)context) == length ? 0 : -1;
+}
+
+int save_mission_report_snapshot(const MissionSnapshot* snapshot, const char* filename) {
+    if (snapshot == NULL || filename == NULL || filename[0] == '\0') {
+        return -1;
+    }
+    FILE *fp = fopen(filename, "w");
+    if (fp == NULL) {
+        return -1;
+    }
+    int result = emit_snapshot_report(snapshot, file_sink, fp);
+    if (fclose(fp) != 0) {
+        result = -1;
+    }
+    return result;
+}
@@ -81,13 +81,36 @@ typedef struct {
  * @brief Communication log structure
  */
 typedef struct {
-    int log_id;                           // Unique log entry identifier
+    int log_id;                           // System-wide unique, increasing in commit order
     char timestamp[MAX_TIMESTAMP_LENGTH]; // "YYYY-MM-DD HH:MM"
     MessagePriority priority;             // Message priority level
     char message[MAX_MESSAGE_LENGTH];     // Message content
     int acknowledged;                     // 0 = no, 1 = yes
 } CommLog;
 
+#ifdef MISSION_HOT_COLD
+/**
+ * @brief Mission structure, hot half (hot/cold layout, see `make HOTCOLD=1`)
+ *
+ * Only what full-system scans read lives here; the rest is in the
+ * MissionCold entry at the same position. Use mission_cold_at() to reach it.
+ */
+typedef struct {
+    int mission_id;                     // Unique mission identifier
+    MissionStatus status;               // Current mission status
+    CommLog *communications;            // Dynamic array of communication logs
+    int comm_count;                     // Current number of communications
+} Mission;
+
+/**
+ * @brief Mission structure, cold half: identity strings and log capacity
+ */
+typedef struct {
+    char mission_name[MAX_NAME_LENGTH]; // Mission name/designation
+    char launch_date[MAX_DATE_LENGTH];  // Launch date "YYYY-MM-DD"
+    int comm_capacity;                  // Current communication array capacity
+} MissionCold;
+#else
 /**
  * @brief Mission structure
  */
@@ -103,8 +126,94 @@ typedef struct {
     int comm_capacity;                  // Current communication array capacity
 } Mission;
 
+/**
+ * @brief In the default layout the cold fields are part of Mission itself
+ */
+typedef Mission MissionCold;
+#endif
+
+/* =============================================================================
+ * INSTRUMENTATION (compiled in with -DMISSION_METRICS, see `make METRICS=1`)
+ * ============================================================================= */
+
+#define METRIC_HISTOGRAM_SUB_BITS 3     // 8 linear sub-buckets per power of two
+#define METRIC_HISTOGRAM_BUCKETS 360    // Covers values up to 2^47 ticks
+
+/**
+ * @brief Instrumented public API entry points
+ */
+typedef enum {
+    METRIC_API_CREATE_MISSION = 0,
+    METRIC_API_ADD_COMM = 1,
+    METRIC_API_LOAD_FILE = 2,
+    METRIC_API_SAVE_REPORT = 3,
+    METRIC_API_COUNT = 4
+} MetricApi;
+
+/**
+ * @brief Dynamic arrays whose growth is tracked
+ */
+typedef enum {
+    METRIC_GROWTH_MISSIONS = 0,
+    METRIC_GROWTH_COMMS = 1,
+    METRIC_GROWTH_COUNT = 2
+} MetricGrowth;
+
+/**
+ * @brief HDR-style log-linear latency histogram (values in ticks)
+ */
+typedef struct {
+    long count;                               // Samples recorded
+    long total_ticks;                         // Sum of all samples
+    long max_ticks;                           // Largest sample
+    long buckets[METRIC_HISTOGRAM_BUCKETS];   // Sample counts per bucket
+} LatencyHistogram;
+
+/**
+ * @brief Per-API call outcome counters
+ */
+typedef struct {
+    long calls;         // Total calls
+    long successes;     // Calls that returned 0
+    long failures;      // Calls that returned non-zero
+} ApiCallStats;
+
+/**
+ * @brief Array growth counters
+ */
+typedef struct {
+    long reallocs;      // Number of growth reallocations
+    long bytes_copied;  // Bytes moved when realloc could not grow in place
+} GrowthStats;
+
+/**
+ * @brief Snapshot of a system's instrumentation counters
+ */
+typedef struct {
+    double ns_per_tick;                        // Tick to nanosecond conversion
+    ApiCallStats api[METRIC_API_COUNT];        // Call counts per API
+    LatencyHistogram latency[METRIC_API_COUNT]; // Latency per API
+    GrowthStats growth[METRIC_GROWTH_COUNT];   // Realloc activity per array
+    long lookups;                              // Mission lookups by ID
+    long lookup_probes;                        // Entries examined by those lookups
+    int max_lookup_probes;                     // Longest single lookup
+} MissionControlStats;
+
+/**
+ * @brief How the missions and log arrays grow when full (see set_growth_policy())
+ */
+typedef struct {
+    int growth_percent;     // Capacity added, as a percentage of the current capacity
+    int chunk_threshold;    // From this capacity on, add chunk_entries instead (0 = never)
+    int chunk_entries;      // Fixed growth step for large arrays
+} GrowthPolicy;
+
 /**
  * @brief Main mission control system structure
+ *
+ * The system functions below (indexes, snapshots, leaderboards and the
+ * rest) keep their state next to this structure, so they need a system
+ * returned by create_mission_control(), never one declared by the caller.
  */
 typedef struct {
     Mission *missions;      // Dynamic array of missions
@@ -155,6 +264,995 @@ int save_mission_report(const MissionControl* system, const char* filename);
  */
 void free_mission_control(MissionControl* system);
 
+/* =============================================================================
+ * CAPACITY RESERVATION AND BULK CREATION
+ * ============================================================================= */
+
+/**
+ * @brief Input for create_missions_bulk()
+ */
+typedef struct {
+    int mission_id;             // Unique mission identifier (> 0)
+    const char* name;           // Mission name (non-empty)
+    const char* launch_date;    // Launch date "YYYY-MM-DD"
+} MissionSpec;
+
+/**
+ * @brief Ensure the missions array (and ID index) can hold `capacity` missions
+ * @return 0 on success, -1 on invalid arguments or allocation failure
+ */
+int reserve_missions(MissionControl* system, int capacity);
+
+/**
+ * @brief Ensure a mission's communications array can hold `capacity` logs
+ * @return 0 on success, -1 if the mission is unknown or allocation fails
+ */
+int reserve_communications(MissionControl* system, int mission_id, int capacity);
+
+/**
+ * @brief Validate and insert an array of missions in order
+ *
+ * Applies the same checks as create_mission_with_crew() and stops at the
+ * first spec that fails them; the specs before it are inserted. All
+ * inserted missions share one pooled allocation for their initial
+ * communications buffers, and the missions array grows at most once.
+ *
+ * @return Number of missions inserted (count on full success; spec[result]
+ *         is the rejected one otherwise), or -1 on invalid arguments or
+ *         allocation failure (nothing inserted)
+ */
+int create_missions_bulk(MissionControl* system, const MissionSpec* specs, int count);
+
+/* =============================================================================
+ * MEMORY FOOTPRINT
+ * ============================================================================= */
+
+/**
+ * @brief Bytes holding live data versus bytes allocated for it
+ */
+typedef struct {
+    size_t used;
+    size_t reserved;
+} MemoryFigure;
+
+/**
+ * @brief Heap footprint of a MissionControl, by structure
+ */
+typedef struct {
+    MemoryFigure missions;      // Missions array
+    MemoryFigure comm_logs;     // Log arrays, including bulk-creation pools
+    MemoryFigure indexes;       // ID index, log directory, leaderboards, launch index, rollups,
+                                // lazy catalog
+    MemoryFigure total;         // All of the above plus the MissionControl itself
+} MemoryUsage;
+
+/**
+ * @brief Report used versus reserved bytes
+ *
+ * Walks every mission, so it costs O(N). Thread stacks, queued reports,
+ * subscriptions and the shared-memory segment are not included.
+ * @return 0 on success, -1 on invalid arguments
+ */
+int mission_control_memory_usage(const MissionControl* system, MemoryUsage* out);
+
+/**
+ * @brief Release the slack left by growth, purges and removals
+ *
+ * Reallocates the missions array, every private log array and the
+ * indexes to what they currently hold. Log arrays carved from a
+ * bulk-creation pool are left in place. The next insertion into a
+ * shrunk array grows it again per the growth policy.
+ * @return 0 on success, -1 if an allocation failed (everything still valid)
+ */
+int mission_control_shrink_to_fit(MissionControl* system);
+
+/**
+ * @brief Choose how the missions and log arrays grow from now on
+ *
+ * An array with capacity C grows to C + C * growth_percent / 100 (at
+ * least one more entry), or to C + chunk_entries once C reaches
+ * chunk_threshold. Fixed chunks bound the slack of large arrays at the
+ * cost of copying them more often. NULL restores the default
+ * { 100, 0, 0 }, i.e. doubling.
+ * @return 0 on success, -1 on invalid arguments
+ */
+int set_growth_policy(MissionControl* system, const GrowthPolicy* policy);
+
+/* =============================================================================
+ * DELETION
+ * ============================================================================= */
+
+/**
+ * @brief Remove a mission and all of its logs
+ *
+ * The last mission is moved into the freed position (swap-remove), so
+ * mission order is not preserved. The ID index, leaderboards, launch index
+ * and shared view are updated in O(1) / O(log N); the launch index uses
+ * tombstones that are compacted in bulk later. While snapshots are enabled
+ * the missions array (and cold table) is copied instead of modified in
+ * place, as for growth.
+ * @return 0 on success, -1 if the mission does not exist
+ */
+int remove_mission(MissionControl* system, int mission_id);
+
+/**
+ * @brief Delete the logs of `mission_id` whose IDs lie in [from_log_id, to_log_id]
+ *
+ * Log IDs are never reused. Purging from the oldest live log onwards costs
+ * O(removed): the start of the array just advances. Other ranges also
+ * shift the later logs down. The freed memory is reclaimed in bounded
+ * steps (see compact_communications()); rollup counters are history and
+ * are not reduced.
+ * @return Number of logs removed, or -1 on invalid arguments or an unknown mission
+ */
+long purge_communications(MissionControl* system, int mission_id, int from_log_id, int to_log_id);
+
+/**
+ * @brief Reclaim memory left by purges, copying roughly `max_logs` logs at most
+ *
+ * purge_communications() already runs a small step itself; call this
+ * when idle to finish sooner. Also rebuilds the log_id directory once the
+ * entries of purged and removed logs outnumber those of stored ones.
+ * @return Missions still waiting to be compacted
+ */
+int compact_communications(MissionControl* system, int max_logs);
+
+/* =============================================================================
+ * MISSION LAYOUT
+ * ============================================================================= */
+
+/**
+ * @brief Name, launch date and log capacity of the mission at `position`
+ *
+ * With the MISSION_HOT_COLD layout those fields are not in Mission; this
+ * reaches them under either layout, so callers build unchanged with both.
+ * The entry moves with its mission (e.g. on remove_mission()).
+ * @return The entry, or NULL if `position` is not in [0, mission_count)
+ */
+const MissionCold* mission_cold_at(const MissionControl* system, int position);
+
+/* =============================================================================
+ * MISSION TOTALS
+ * ============================================================================= */
+
+/**
+ * @brief System-wide counts gathered by get_mission_totals()
+ */
+typedef struct {
+    int missions;                       // Including pending lazily loaded ones
+    int by_status[ABORTED + 1];         // Missions per MissionStatus
+    long communications;                // Logs across all missions
+} MissionTotals;
+
+/**
+ * @brief Count missions per status and logs in one pass over the missions
+ *
+ * Reads only hot fields, so with the MISSION_HOT_COLD layout the pass
+ * touches 32 bytes per mission.
+ * @return 0 on success, -1 on invalid arguments
+ */
+int get_mission_totals(const MissionControl* system, MissionTotals* out);
+
+/* =============================================================================
+ * LEADERBOARDS
+ * ============================================================================= */
+
+/**
+ * @brief Per-mission counts that can be ranked
+ */
+typedef enum {
+    LEADERBOARD_EMERGENCY = 0,      // EMERGENCY priority logs
+    LEADERBOARD_TOTAL_COMMS = 1,    // All logs
+    LEADERBOARD_UNACKNOWLEDGED = 2, // Logs not yet acknowledged
+    LEADERBOARD_METRIC_COUNT = 3
+} LeaderboardMetric;
+
+/**
+ * @brief One ranked mission
+ */
+typedef struct {
+    int mission_id;
+    int count;
+} LeaderboardEntry;
+
+/**
+ * @brief Start maintaining top-K heaps for every LeaderboardMetric
+ *
+ * Afterwards each count change costs O(log N) and get_top_missions()
+ * costs O(K log K). Idempotent.
+ * @return 0 on success, -1 on invalid system or allocation failure
+ */
+int enable_mission_leaderboard(MissionControl* system);
+
+/**
+ * @brief Stop maintaining the heaps and release them
+ */
+void disable_mission_leaderboard(MissionControl* system);
+
+/**
+ * @brief Fill `out` with up to k missions ranked by `metric`
+ *
+ * Ordered by count (descending), then mission ID (ascending). Missions
+ * with a zero count are included. Without an enabled leaderboard every
+ * mission's logs are counted instead (O(N log K) plus one pass over the
+ * logs, except for LEADERBOARD_TOTAL_COMMS).
+ * @return Number of entries written, or -1 on invalid arguments or
+ *         allocation failure
+ */
+int get_top_missions(const MissionControl* system, LeaderboardMetric metric, int k,
+                     LeaderboardEntry* out);
+
+/**
+ * @brief Mark a communication log as acknowledged
+ * @return 0 on success (including already acknowledged), -1 if the mission
+ *         or log does not exist
+ */
+int acknowledge_communication(MissionControl* system, int mission_id, int log_id);
+
+/**
+ * @brief Find a communication by log_id alone
+ *
+ * Log IDs are unique across the system, and a directory indexed by ID
+ * leads to the log in O(1) (O(log n) for an old log among mostly purged
+ * ones, or within the mission for a log in front of a purged range).
+ * @param mission_id If non-NULL, set to the owning mission's ID when found
+ * @return The log, or NULL if no stored log has that ID (never assigned,
+ *         purged, or its mission removed)
+ */
+const CommLog* get_communication(const MissionControl* system, int log_id, int* mission_id);
+
+/**
+ * @brief acknowledge_communication() without knowing the mission
+ * @return 0 on success (including already acknowledged), -1 if no stored
+ *         log has that ID
+ */
+int acknowledge_communication_by_id(MissionControl* system, int log_id);
+
+/* =============================================================================
+ * LAUNCH DATE QUERIES
+ * ============================================================================= */
+
+/**
+ * @brief Start maintaining a launch-date ordered index of all missions
+ *
+ * A sorted array plus a sorted insertion buffer of about sqrt(N) entries,
+ * merged when full: inserts cost amortised O(sqrt N), range queries
+ * O(log N + output). Idempotent.
+ * @return 0 on success, -1 on invalid system or allocation failure
+ */
+int enable_launch_index(MissionControl* system);
+
+/**
+ * @brief Stop maintaining the launch-date index and release it
+ */
+void disable_launch_index(MissionControl* system);
+
+/**
+ * @brief IDs of missions launching between from_date and to_date (inclusive)
+ *
+ * Written in launch date order, ties by mission ID. Without an enabled
+ * index every mission is scanned and the matches sorted.
+ * @return Number of IDs written (at most max_ids), or -1 on invalid
+ *         arguments, invalid dates or allocation failure
+ */
+int find_missions_by_launch_date(const MissionControl* system, const char* from_date,
+                                 const char* to_date, int* mission_ids, int max_ids);
+
+/**
+ * @brief IDs of the first `count` missions launching on or after from_date
+ * @return Number of IDs written, or -1 on invalid arguments or allocation failure
+ */
+int get_upcoming_launches(const MissionControl* system, const char* from_date, int count,
+                          int* mission_ids);
+
+/* =============================================================================
+ * CONSISTENT SNAPSHOTS
+ * One writer thread (every mutating call) may keep ingesting while any
+ * number of reporter threads read point-in-time snapshots.
+ * ============================================================================= */
+
+/**
+ * @brief Point-in-time view of every mission (see begin_mission_snapshot())
+ */
+typedef struct MissionSnapshot MissionSnapshot;
+
+/**
+ * @brief One mission as seen by a snapshot
+ */
+typedef struct {
+    int mission_id;
+    const char* mission_name;
+    const char* launch_date;
+    MissionStatus status;
+    const CommLog* communications;  // Logs in append order
+    int comm_count;                 // Logs that existed when the snapshot began
+} MissionView;
+
+/**
+ * @brief Allow snapshots to be taken from other threads
+ *
+ * Call from the writer thread before starting any reporter. While enabled,
+ * growing arrays are copied rather than realloc()ed and old copies are
+ * freed only once no snapshot can still see them, so the writer never
+ * waits on a reporter.
+ * @return 0 on success, -1 on invalid system or allocation failure
+ */
+int enable_mission_snapshots(MissionControl* system);
+
+/**
+ * @brief Stop snapshot support; no snapshot may be open
+ */
+void disable_mission_snapshots(MissionControl* system);
+
+/**
+ * @brief Capture the missions and log counts as of this instant
+ *
+ * Safe to call concurrently with the writer. Captures O(1) data per
+ * mission; log contents are shared with the live system, not copied.
+ * Acknowledged flags are read live.
+ * @return New snapshot, or NULL if snapshots are disabled or allocation fails
+ */
+MissionSnapshot* begin_mission_snapshot(const MissionControl* system);
+
+/**
+ * @brief Number of missions in the snapshot
+ */
+int snapshot_mission_count(const MissionSnapshot* snapshot);
+
+/**
+ * @brief View of the snapshot's `index`-th mission (0-based, creation order)
+ * @return 0 on success, -1 on invalid arguments
+ */
+int snapshot_get_mission(const MissionSnapshot* snapshot, int index, MissionView* out);
+
+/**
+ * @brief Write a save_mission_report()-format report of the snapshot
+ * @return 0 on success, -1 on failure
+ */
+int save_mission_report_snapshot(const MissionSnapshot* snapshot, const char* filename);
+
+/**
+ * @brief Release a snapshot (and any arrays only it was keeping alive)
+ */
+void end_mission_snapshot(MissionSnapshot* snapshot);
+
+/* =============================================================================
+ * ASYNCHRONOUS REPORTS
+ * ============================================================================= */
+
+/**
+ * @brief Completion handle for save_mission_report_async()
+ */
+typedef struct MissionReportHandle MissionReportHandle;
+
+/**
+ * @brief Save a report of the system as of this call on background threads
+ *
+ * Call from the writer thread; enables snapshots if needed. The caller's
+ * cost is O(1) in report size: formatting (into two reused buffers) and
+ * writing overlap on a formatter and a writer thread. The report goes to
+ * "<filename>.<n>.tmp" and is rename()d into place once complete, so
+ * `filename` always holds either the previous or the new full report.
+ * free_mission_control() waits for queued reports to finish.
+ *
+ * @return Handle to poll/wait on and then release, or NULL on invalid
+ *         arguments or allocation failure
+ */
+MissionReportHandle* save_mission_report_async(MissionControl* system, const char* filename);
+
+/**
+ * @brief 1 if the report has finished (successfully or not), 0 if still running
+ */
+int mission_report_poll(const MissionReportHandle* handle);
+
+/**
+ * @brief Block until the report has finished
+ * @return 0 if the report was written and renamed into place, -1 otherwise
+ */
+int mission_report_wait(MissionReportHandle* handle);
+
+/**
+ * @brief Release the caller's reference (the report still completes)
+ */
+void mission_report_release(MissionReportHandle* handle);
+
+/* =============================================================================
+ * STREAMING EXPORT
+ * ============================================================================= */
+
+/**
+ * @brief Output formats for export_communications()
+ */
+typedef enum {
+    EXPORT_CSV = 0,         // RFC 4180 CSV with a header row
+    EXPORT_JSON_LINES = 1   // One JSON object per line
+} ExportFormat;
+
+/**
+ * @brief Which logs to export (zero/NULL fields do not filter)
+ */
+typedef struct {
+    int mission_id;             // Only this mission (0 = every mission)
+    int min_priority;           // Only logs at or above this MessagePriority (0 = any)
+    const char* from_timestamp; // "YYYY-MM-DD HH:MM", inclusive (NULL = unbounded)
+    const char* to_timestamp;   // "YYYY-MM-DD HH:MM", inclusive (NULL = unbounded)
+} ExportFilter;
+
+/**
+ * @brief Stream every matching log to `filename`
+ *
+ * Rows are emitted in mission order, then log order, through a fixed
+ * 256 KiB buffer, so memory use does not grow with the export size.
+ * Columns: mission_id, log_id, timestamp, priority, acknowledged, message.
+ * @param filter NULL exports everything
+ * @return Number of logs exported, or -1 on invalid arguments or I/O error
+ */
+long export_communications(const MissionControl* system, const char* filename,
+                           ExportFormat format, const ExportFilter* filter);
+
+/**
+ * @brief export_communications() to an already open descriptor (e.g. a pipe)
+ */
+long export_communications_fd(const MissionControl* system, int fd, ExportFormat format,
+                              const ExportFilter* filter);
+
+/* =============================================================================
+ * COMMUNICATION SUBSCRIPTIONS
+ * ============================================================================= */
+
+/**
+ * @brief Registered callback (see subscribe_communications())
+ */
+typedef struct CommSubscription CommSubscription;
+
+/**
+ * @brief Invoked for each accepted log that matches a subscription
+ *
+ * `log` is only valid for the duration of the call.
+ */
+typedef void (*CommCallback)(const CommLog* log, int mission_id, void* user_data);
+
+/**
+ * @brief Call `callback` for every log added to `mission_id` with priority >= `min_priority`
+ *
+ * Callbacks run inside add_communication() unless a dispatcher is running.
+ * Dispatch only visits matching subscribers. Callbacks must not subscribe
+ * or unsubscribe. The mission does not need to exist yet.
+ * @param mission_id 0 subscribes to every mission
+ * @return Subscription handle, or NULL on invalid arguments or allocation failure
+ */
+CommSubscription* subscribe_communications(MissionControl* system, int mission_id,
+                                           MessagePriority min_priority,
+                                           CommCallback callback, void* user_data);
+
+/**
+ * @brief Remove a subscription; no callbacks for it start after this returns
+ * @return 0 on success, -1 on invalid arguments
+ */
+int unsubscribe_communications(MissionControl* system, CommSubscription* subscription);
+
+/**
+ * @brief Deliver callbacks on a dispatcher thread instead of inside add_communication()
+ *
+ * Matching logs are copied into a ring of `queue_capacity` events; when it
+ * is full new events are dropped (see subscription_events_dropped()).
+ * @return 0 on success (or if already running), -1 on failure
+ */
+int start_subscription_dispatcher(MissionControl* system, int queue_capacity);
+
+/**
+ * @brief Deliver every queued event, then return to inline callbacks
+ */
+void stop_subscription_dispatcher(MissionControl* system);
+
+/**
+ * @brief Events dropped because the dispatcher queue was full, counted over
+ *        every dispatcher the system has run
+ */
+long subscription_events_dropped(const MissionControl* system);
+
+/* =============================================================================
+ * TIME-BUCKETED ROLLUPS
+ * ============================================================================= */
+
+/**
+ * @brief Bucket width for get_comm_rollup_series()
+ */
+typedef enum {
+    ROLLUP_MINUTE = 0,
+    ROLLUP_HOUR = 1,
+    ROLLUP_DAY = 2,
+    ROLLUP_GRANULARITY_COUNT = 3
+} RollupGranularity;
+
+/**
+ * @brief Log counts for one period of a series
+ */
+typedef struct {
+    long start_minute;                  // Period start, minutes since 1970-01-01 00:00
+    int available;                      // 0 if the period is older than the rollups retain
+    int counts[EMERGENCY + 1];          // Per priority; counts[0] is the total
+} RollupPoint;
+
+/**
+ * @brief Maintain per-mission minute/hour/day log counters on every append
+ *
+ * Each mission keeps the most recent `minute_buckets` minutes,
+ * `hour_buckets` hours and `day_buckets` days (0 selects 120, 168 and 366),
+ * allocated with its first log. Existing logs are counted immediately.
+ * @return 0 on success (or if already enabled), -1 on invalid arguments or allocation failure
+ */
+int enable_comm_rollups(MissionControl* system, int minute_buckets, int hour_buckets,
+                        int day_buckets);
+
+/**
+ * @brief Drop the rollups; series queries then scan the logs
+ */
+void disable_comm_rollups(MissionControl* system);
+
+/**
+ * @brief Fill `points` with `count` consecutive periods starting at the one
+ *        containing `from_timestamp` ("YYYY-MM-DD HH:MM")
+ *
+ * Costs O(count) per mission with rollups enabled, independent of log
+ * volume. Logs whose timestamp is not a real date and time are not counted.
+ * @param mission_id 0 sums every mission
+ * @return `count`, or -1 on invalid arguments or an unknown mission
+ */
+int get_comm_rollup_series(const MissionControl* system, int mission_id,
+                           RollupGranularity granularity, const char* from_timestamp,
+                           int count, RollupPoint* points);
+
+/* =============================================================================
+ * DUPLICATE SUPPRESSION
+ * ============================================================================= */
+
+/**
+ * @brief Refuse logs that repeat one of their mission's last `window` logs
+ *
+ * A log is a duplicate when its mission already holds one with the same
+ * timestamp, priority and message among the last `window` appended (0
+ * selects 32). add_communication() then stores nothing, returns -1 and
+ * counts the log in comm_duplicates_suppressed(); add_communication_ex()
+ * returns COMM_ADD_DUPLICATE. Membership is a per-mission hash lookup on
+ * a 64-bit fingerprint, confirmed against the stored log. The most recent
+ * logs already held are remembered immediately.
+ * @return 0 on success (or if already enabled), -1 on invalid arguments or allocation failure
+ */
+int enable_comm_dedup(MissionControl* system, int window);
+
+/**
+ * @brief Forget every fingerprint; add_communication() accepts repeats again
+ */
+void disable_comm_dedup(MissionControl* system);
+
+/**
+ * @brief Appends refused as duplicates since dedup was enabled
+ */
+long comm_duplicates_suppressed(const MissionControl* system);
+
+/**
+ * @brief Outcome of add_communication_ex()
+ */
+typedef enum {
+    COMM_ADD_REJECTED = -1,     // Invalid arguments, unknown mission or allocation failure
+    COMM_ADD_OK = 0,            // Stored, or buffered while reordering is enabled
+    COMM_ADD_DUPLICATE = 1,     // Refused as a repeat (see enable_comm_dedup())
+    COMM_ADD_TOO_LATE = 2       // Refused as too late to order (see enable_comm_reorder())
+} CommAddStatus;
+
+/**
+ * @brief add_communication() that tells duplicates and late logs apart from
+ *        other rejections
+ *
+ * add_communication() keeps its 0/-1 contract and returns -1 for all of
+ * them; callers that must answer differently (the ingest daemon) use this.
+ * @return COMM_ADD_OK exactly when add_communication() would return 0
+ */
+CommAddStatus add_communication_ex(MissionControl* system, int mission_id, const char* timestamp,
+                                   MessagePriority priority, const char* message);
+
+/* =============================================================================
+ * TIME-ORDERED LOGS
+ * ============================================================================= */
+
+/**
+ * @brief Counters from get_comm_reorder_stats()
+ */
+typedef struct {
+    long buffered;      // Logs accepted but not yet committed
+    long reordered;     // Logs that arrived behind a newer one and were placed in order
+    long too_late;      // Logs refused because they arrived too late to be placed in order
+} CommReorderStats;
+
+/**
+ * @brief Keep every mission's committed logs in timestamp order despite
+ *        out-of-order arrival
+ *
+ * add_communication() holds each log in its mission's buffer until the
+ * mission has received one `lateness_minutes` newer, then commits it in
+ * timestamp order (logs with equal timestamps keep arrival order). A log
+ * older than the mission's newest committed one is refused with -1
+ * (COMM_ADD_TOO_LATE from add_communication_ex()) and counted in
+ * CommReorderStats.too_late; one whose timestamp is not a real date and
+ * time is refused with -1 too. At most `max_buffered` logs wait per
+ * mission (0 selects 1024); beyond that the oldest are committed early.
+ * Buffered logs are not yet visible to queries, reports or subscribers,
+ * and get their log_id when committed.
+ * @return 0 on success (or if already enabled), -1 on invalid arguments or allocation failure
+ */
+int enable_comm_reorder(MissionControl* system, int lateness_minutes, int max_buffered);
+
+/**
+ * @brief Commit every buffered log now, in order
+ * @return Logs committed, or -1 if an allocation failed (the rest stay buffered)
+ */
+long flush_comm_reorder(MissionControl* system);
+
+/**
+ * @brief Flush, then stop buffering; add_communication() appends directly again
+ * @return 0 on success, -1 if the flush failed (reordering stays enabled)
+ */
+int disable_comm_reorder(MissionControl* system);
+
+/**
+ * @brief Fill `out` with the reorder counters (all zero while disabled)
+ * @return 0 on success, -1 on invalid arguments
+ */
+int get_comm_reorder_stats(const MissionControl* system, CommReorderStats* out);
+
+/**
+ * @brief Find a mission's committed logs with `from` <= timestamp <= `to`
+ *
+ * A binary search over the communications array, so O(log n); NULL bounds
+ * are open. Available while the mission's logs are in timestamp order,
+ * which enable_comm_reorder() guarantees and in-order arrival preserves.
+ * @param first Set to the first matching log, or NULL if there is none
+ * @return Number of matching logs (consecutive from *first), or -1 on
+ *         invalid arguments, an unknown mission or logs out of order
+ */
+int find_communications_by_time(const MissionControl* system, int mission_id, const char* from,
+                                const char* to, const CommLog** first);
+
+/* =============================================================================
+ * SHARED-MEMORY VIEW
+ * ============================================================================= */
+
+/**
+ * @brief Publish mission metadata and counters in the POSIX shared-memory
+ *        object `name` (e.g. "/space_mission")
+ *
+ * The segment has room for `max_missions`; later missions are counted but
+ * not mirrored. Slots are updated in place under seqlocks as missions and
+ * logs are added, so readers using space_mission_shm.h never contact this
+ * process. Existing missions are mirrored immediately.
+ * @return 0 on success (or if already enabled), -1 on invalid arguments or failure
+ */
+int enable_shared_view(MissionControl* system, const char* name, int max_missions);
+
+/**
+ * @brief Stop publishing and unlink the shared-memory object
+ */
+void disable_shared_view(MissionControl* system);
+
+/* =============================================================================
+ * INGEST DAEMON
+ * ============================================================================= */
+
+/**
+ * @brief Where run_ingest_daemon() listens
+ */
+typedef struct {
+    const char* unix_path;  // Unix domain socket path (NULL to listen on TCP)
+    int tcp_port;           // 127.0.0.1 port, used when unix_path is NULL
+} IngestConfig;
+
+/**
+ * @brief Counters filled in by run_ingest_daemon()
+ */
+typedef struct {
+    long connections;   // Producers accepted
+    long requests;      // Request lines answered
+    long rejected;      // Well-formed requests the system refused ("-")
+    long malformed;     // Requests that could not be parsed ("?")
+    long duplicates;    // Logs refused as already stored ("=", see enable_comm_dedup())
+} IngestStats;
+
+/**
+ * @brief Serve the line protocol described in ingest_daemon.c until a client
+ *        sends "X" or the process receives SIGINT/SIGTERM
+ *
+ * Single-threaded: the calling thread is the only writer to `system` while
+ * the daemon runs. Pipelined requests are applied in batches per read.
+ * @param stats May be NULL
+ * @return 0 after a clean shutdown, -1 if the socket could not be set up
+ */
+int run_ingest_daemon(MissionControl* system, const IngestConfig* config, IngestStats* stats);
+
+/* =============================================================================
+ * PARALLEL LOADING
+ * ============================================================================= */
+
+/**
+ * @brief Outcome of loading one file in load_missions_from_files()
+ */
+typedef enum {
+    LOAD_FILE_OK = 0,           // Every declared record was read
+    LOAD_FILE_OPEN_FAILED = 1,  // File could not be opened
+    LOAD_FILE_BAD_HEADER = 2,   // Mission count missing or negative
+    LOAD_FILE_TRUNCATED = 3     // Malformed record or fewer records than declared
+} LoadFileStatus;
+
+/**
+ * @brief Per-file summary filled in by load_missions_from_files()
+ */
+typedef struct {
+    LoadFileStatus status;  // Overall file outcome
+    int declared;           // Mission count from the header line
+    int parsed;             // Records read before EOF or the first malformed record
+    int loaded;             // Records inserted into the system
+    int duplicates;         // Records dropped because their ID was already taken
+    int invalid;            // Records dropped for a bad ID or launch date
+    int error_record;       // 1-based record number that stopped parsing (0 if none)
+} LoadFileSummary;
+
+/**
+ * @brief Load several mission files concurrently into one system
+ *
+ * Files are parsed on up to `thread_count` threads (0 = one per CPU) and
+ * merged in list order. Duplicate IDs are resolved deterministically:
+ * missions already in the system win, then the earliest file in the
+ * list, then the earliest record in that file. Invalid records are
+ * skipped and counted rather than aborting the load.
+ *
+ * @param summaries Optional array of `file_count` entries, one per file
+ * @return 0 if every file loaded without errors or invalid records,
+ *         -1 on bad arguments, allocation failure, or any per-file problem
+ */
+int load_missions_from_files(MissionControl* system, const char* const* filenames,
+                             int file_count, int thread_count, LoadFileSummary* summaries);
+
+/**
+ * @brief Load one large mission file using several parser threads
+ *
+ * The file is split into chunks at newline boundaries after the header
+ * count; chunks are parsed concurrently into thread-local buffers and
+ * inserted in file order. Results and the failure return match
+ * load_missions_from_file(): records before the first invalid one are
+ * kept and the call returns -1.
+ *
+ * @param thread_count Parser threads (0 = one per CPU)
+ * @return 0 on success, -1 on failure
+ */
+int load_missions_from_file_parallel(MissionControl* system, const char* filename,
+                                     int thread_count);
+
+/* =============================================================================
+ * LAZY LOADING
+ * ============================================================================= */
+
+/**
+ * @brief Index a mission file without creating its missions
+ *
+ * Accepts the same files, and the same valid prefix, as
+ * load_missions_from_file(), but only records each mission's ID and file
+ * offset (about 32 bytes per mission). A mission is created the first
+ * time it is looked up by ID (add_communication(), purge, acknowledge,
+ * reserve_communications()); its log array is allocated by its first
+ * append. The file is kept open until free_mission_control() and must
+ * not change meanwhile; a pipe or FIFO cannot be read back, so its
+ * missions are created right away as by load_missions_from_file().
+ *
+ * Duplicate checks and remove_mission() cover pending missions too.
+ * save_mission_report() lists every mission, reading pending ones back
+ * from the file: lazily loaded missions come first in file order, then
+ * the others in insertion order, so a lazy load into an empty system
+ * reports exactly like an eager one. Everything else that walks the
+ * missions array (snapshots, leaderboards, exports, the shared view)
+ * sees a mission once it has been created.
+ *
+ * @return 0 on success, -1 on failure
+ */
+int load_missions_from_file_lazy(MissionControl* system, const char* filename);
+
+/**
+ * @brief Lazily loaded missions not created yet
+ */
+int pending_mission_count(const MissionControl* system);
+
+/* =============================================================================
+ * SHARDED FRONT-END
+ * ============================================================================= */
+
+/**
+ * @brief N independent MissionControl shards, each owned by a worker thread
+ *
+ * Missions are partitioned by a hash of their ID. Submissions are queued
+ * to the owning shard and applied there asynchronously; every other call
+ * waits for the shards to drain first. All calls must come from one
+ * thread (the queues are single-producer).
+ */
+typedef struct ShardedMissionControl ShardedMissionControl;
+
+/**
+ * @brief Start `shard_count` workers (0 = one per CPU), each with its own system
+ * @param pin_threads Non-zero to pin worker i to CPU i (modulo the CPU count)
+ * @return Front-end handle, or NULL on invalid arguments or failure
+ */
+ShardedMissionControl* create_sharded_mission_control(int shard_count, int initial_capacity,
+                                                      int pin_threads);
+
+/**
+ * @brief Drain the queues, stop the workers and free every shard
+ */
+void free_sharded_mission_control(ShardedMissionControl* sharded);
+
+/**
+ * @brief Number of shards
+ */
+int sharded_shard_count(const ShardedMissionControl* sharded);
+
+/**
+ * @brief Queue create_mission_with_crew() on the owning shard
+ * @return 0 if queued, -1 if the arguments are invalid (nothing queued);
+ *         refusals by the shard are counted in sharded_sync()
+ */
+int sharded_create_mission(ShardedMissionControl* sharded, int mission_id, const char* name,
+                           const char* launch_date);
+
+/**
+ * @brief Queue add_communication() on the owning shard
+ * @return 0 if queued, -1 if the arguments are invalid (nothing queued)
+ */
+int sharded_add_communication(ShardedMissionControl* sharded, int mission_id,
+                              const char* timestamp, MessagePriority priority,
+                              const char* message);
+
+/**
+ * @brief Queue acknowledge_communication() on the owning shard
+ * @return 0 if queued, -1 if the arguments are invalid (nothing queued)
+ */
+int sharded_acknowledge_communication(ShardedMissionControl* sharded, int mission_id,
+                                      int log_id);
+
+/**
+ * @brief Queue acknowledge_communication_by_id() on the shard that
+ *        committed `log_id`
+ *
+ * Shard k of N numbers its logs k + 1, k + 1 + N, k + 1 + 2N, ..., so log
+ * IDs are unique across shards and route without a lookup.
+ * @return 0 if queued, -1 if the arguments are invalid (nothing queued)
+ */
+int sharded_acknowledge_communication_by_id(ShardedMissionControl* sharded, int log_id);
+
+/**
+ * @brief Wait until every queued operation has been applied
+ * @return Operations the shards refused since the previous sync
+ */
+long sharded_sync(ShardedMissionControl* sharded);
+
+/**
+ * @brief Missions across all shards (syncs first)
+ */
+int sharded_mission_count(ShardedMissionControl* sharded);
+
+/**
+ * @brief The system behind shard `index`, for queries not covered here
+ *
+ * Only valid between sharded_sync() and the next submission: the worker
+ * is idle then and the caller may read (not modify) it.
+ */
+const MissionControl* sharded_get_shard(ShardedMissionControl* sharded, int index);
+
+/**
+ * @brief load_missions_from_file() split across the shards
+ *
+ * The file is parsed and checked on the calling thread; each shard then
+ * bulk-inserts its share in parallel. As with load_missions_from_file(),
+ * only the records before the first invalid or duplicate one are kept.
+ * @return 0 on success, -1 on failure (as load_missions_from_file())
+ */
+int sharded_load_missions_from_file(ShardedMissionControl* sharded, const char* filename);
+
+/**
+ * @brief save_mission_report() over every shard, missions in ID order
+ * @return 0 on success, -1 on failure
+ */
+int sharded_save_mission_report(ShardedMissionControl* sharded, const char* filename);
+
+/* =============================================================================
+ * PARALLEL REPLAY
+ * ============================================================================= */
+
+/**
+ * @brief Options for run_parallel_replay()
+ */
+typedef struct {
+    int thread_count;           // Worker threads (0 = one per CPU)
+    const char* report_prefix;  // Prepended to TEST_SAVE_REPORT file names (may be NULL)
+    volatile int* cancel;       // Polled between commands; non-zero stops the replay (may be NULL)
+} ParallelReplayConfig;
+
+/**
+ * @brief Counters filled in by run_parallel_replay()
+ */
+typedef struct {
+    long commands;      // Commands executed
+    long malformed;     // Lines that could not be parsed
+    long segments;      // Runs of mission commands between two system-level commands
+    int threads;
+    int lanes;          // Independent systems the missions were spread over
+} ParallelReplayStats;
+
+/**
+ * @brief Cursor over a TEST_* command's arguments, shared by both replay modes
+ */
+typedef struct {
+    char* cursor;   // Next unread character of the argument list
+} ReplayArgs;
+
+/**
+ * @brief Next whitespace-delimited token, NUL-terminated in place
+ * @return The token, or NULL at the end of the line or a '#' comment
+ */
+char* replay_next_token(ReplayArgs* args);
+
+/**
+ * @brief Next token as a decimal integer
+ * @return 1 on success, 0 if the token is missing or not a number
+ */
+int replay_next_int(ReplayArgs* args, int* out);
+
+/**
+ * @brief Next token as an expected result (SUCCESS or FAILURE; the first letter decides)
+ * @return 1 on success, 0 if the token is missing
+ */
+int replay_next_expected(ReplayArgs* args, int* expect_success);
+
+/**
+ * @brief Called once per executed command, in file order
+ * @param succeeded 1 if the command succeeded, 0 if it failed
+ */
+typedef void (*ReplayResultCallback)(void* context, long line_number, const char* keyword,
+                                     int expected_success, int succeeded);
+
+/**
+ * @brief Replay a TEST_* command file, running independent missions in parallel
+ *
+ * Commands for one mission keep their file order; TEST_CREATE_SYSTEM,
+ * TEST_LOAD_FILE, TEST_SAVE_REPORT and TEST_FREE_SYSTEM are barriers that
+ * run after every earlier command. Outcomes and saved reports match a
+ * sequential replay.
+ * @param on_result May be NULL
+ * @param stats May be NULL
+ * @return 0 on success, -1 if the file cannot be read or memory runs out
+ */
+int run_parallel_replay(const char* filename, const ParallelReplayConfig* config,
+                        ReplayResultCallback on_result, void* context,
+                        ParallelReplayStats* stats);
+
+/* =============================================================================
+ * INSTRUMENTATION API
+ * ============================================================================= */
+
+/**
+ * @brief Copy the system's instrumentation counters into `out`
+ * @return 0 on success, -1 if metrics are not compiled in or arguments are invalid
+ */
+int get_mission_control_stats(const MissionControl* system, MissionControlStats* out);
+
+/**
+ * @brief Enable/disable appending the counters to save_mission_report() output
+ * @return 0 on success, -1 if metrics are not compiled in or system is NULL
+ */
+int set_mission_control_report_stats(MissionControl* system, int enabled);
+
+/**
+ * @brief Latency at the given percentile (0-100) of a histogram, in nanoseconds
+ */
+double latency_histogram_percentile(const MissionControlStats* stats, MetricApi api,
+                                    double percentile);
+
 /* =============================================================================
  * 💀 FRAMEWORK FUNCTIONS (PROVIDED - Students don't implement)
  * ============================================================================= */
@@ -166,6 +1264,7 @@ const char* priority_to_string(MessagePriority priority);
 
 // Validation utilities
 int is_valid_date_format(const char* date_str);
+int parse_date_to_epoch_day(const char* date_str, int* epoch_day);  // 1 if valid
 int is_valid_timestamp_format(const char* timestamp_str);
 
 // Test framework functions
@@ -181,6 +1280,12 @@ void test_free_system(const char* expected_result);
 // Test file processor
 void process_test_file(const char* filename);
 
+// High-throughput replay of generated command streams (one watchdog for the whole run)
+void replay_test_file(const char* filename, int watchdog_seconds);
+
+// Replay with independent missions run in parallel (same results, file order)
+void replay_parallel_test_file(const char* filename, int thread_count, int watchdog_seconds);
+
 // Timeout protection
 extern volatile int timeout_occurred;
 void setup_timeout_handler(void);
@@ -0,0 +1,137 @@
+/**
+ * @file space_mission_shm.h
+ * @brief Space Mission Control System - Shared-Memory Mission View
+ *
+ * Layout of the POSIX shared-memory segment published by
+ * enable_shared_view(), and the read-only client library (shm_reader.c)
+ * that dashboards in other processes link against. This header does not
+ * depend on space_mission.h.
+ *
+ * Segment layout:
+ *   ShmViewHeader
+ *   ShmMissionSlot slots[capacity]     in mission creation order
+ *   int32_t index[index_capacity]      mission_id -> slot + 1 (0 = empty,
+ *                                      -1 = removed; keep probing)
+ *
+ * Each slot is guarded by a seqlock: the writer makes `seq` odd, updates
+ * the counters and makes it even again, and readers retry a copy whose
+ * `seq` was odd or changed. Reads never enter the kernel or block the
+ * writer.
+ *
+ * When a mission is removed the publisher's last mission moves into its
+ * slot (identity fields included, under the seqlock), so a reader looking
+ * up by ID checks the ID of the copy it gets.
+ */
+
+#ifndef SPACE_MISSION_SHM_H
+#define SPACE_MISSION_SHM_H
+
+#include <stdint.h>
+
+/* =============================================================================
+ * SEGMENT LAYOUT
+ * ============================================================================= */
+
+#define SHM_VIEW_MAGIC 0x31564d53u      // "SMV1"
+#define SHM_VIEW_VERSION 2
+#define SHM_NAME_LENGTH 50              // == MAX_NAME_LENGTH
+#define SHM_DATE_LENGTH 12              // == MAX_DATE_LENGTH
+#define SHM_TIMESTAMP_LENGTH 20         // == MAX_TIMESTAMP_LENGTH
+#define SHM_PRIORITY_LEVELS 4           // Indexed by MessagePriority (0 unused)
+
+/**
+ * @brief Segment header; `magic` is stored last, once the segment is ready
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    int32_t capacity;           // Mission slots
+    int32_t index_capacity;     // Index entries (power of two)
+    int32_t mission_count;      // Slots in use (release-stored after the slot is filled)
+    int32_t missions_dropped;   // Existing missions that did not fit in the slots
+    int64_t total_comms;        // Logs across all mirrored missions
+} ShmViewHeader;
+
+/**
+ * @brief One mission; identity fields change only when another mission is
+ *        moved into the slot by a removal
+ */
+typedef struct {
+    uint32_t seq;                               // Seqlock, odd while being updated
+    int32_t mission_id;
+    int32_t status;                             // MissionStatus
+    int32_t launch_day;                         // Days since 1970-01-01
+    char mission_name[SHM_NAME_LENGTH];
+    char launch_date[SHM_DATE_LENGTH];
+    char last_timestamp[SHM_TIMESTAMP_LENGTH];  // Latest log ("" if none)
+    int32_t comm_count;
+    int32_t unacked_count;
+    int32_t priority_counts[SHM_PRIORITY_LEVELS];
+} ShmMissionSlot;
+
+/**
+ * @brief Home position of `mission_id` in an index of `index_capacity` entries
+ *        (linear probing from there)
+ */
+static inline uint32_t shm_view_index_slot(int32_t mission_id, int32_t index_capacity) {
+    return ((uint32_t)mission_id * 2654435769u) & (uint32_t)(index_capacity - 1);
+}
+
+/* =============================================================================
+ * READER LIBRARY (shm_reader.c)
+ * ============================================================================= */
+
+/**
+ * @brief An open, read-only mapping of a published view
+ */
+typedef struct SharedMissionView SharedMissionView;
+
+/**
+ * @brief Consistent copy of one mission slot
+ */
+typedef struct {
+    int mission_id;
+    int status;
+    int launch_day;
+    char mission_name[SHM_NAME_LENGTH];
+    char launch_date[SHM_DATE_LENGTH];
+    char last_timestamp[SHM_TIMESTAMP_LENGTH];
+    int comm_count;
+    int unacked_count;
+    int priority_counts[SHM_PRIORITY_LEVELS];
+} SharedMissionInfo;
+
+/**
+ * @brief Map the segment published under `name` (e.g. "/space_mission")
+ * @return View handle, or NULL if it does not exist or is not a valid view
+ */
+SharedMissionView* shm_view_open(const char* name);
+
+/**
+ * @brief Unmap the view (the publisher is unaffected)
+ */
+void shm_view_close(SharedMissionView* view);
+
+/**
+ * @brief Missions currently mirrored
+ */
+int shm_view_mission_count(const SharedMissionView* view);
+
+/**
+ * @brief Logs across all mirrored missions
+ */
+long shm_view_total_communications(const SharedMissionView* view);
+
+/**
+ * @brief Copy the mission at `index` (creation order, 0-based)
+ * @return 0 on success, -1 if `index` is out of range
+ */
+int shm_view_get_mission(const SharedMissionView* view, int index, SharedMissionInfo* out);
+
+/**
+ * @brief Copy the mission with `mission_id` via the shared hash index
+ * @return 0 on success, -1 if it is not mirrored
+ */
+int shm_view_find_mission(const SharedMissionView* view, int mission_id, SharedMissionInfo* out);
+
+#endif /* SPACE_MISSION_SHM_H */
@@ -0,0 +1,393 @@
+/**
+ * @file subscriptions.c
+ * @brief Space Mission Control System - Communication Subscriptions
+ *
+ * Subscribers are grouped into sets: one per subscribed mission ID (found
+ * through a small open-addressing map) plus one wildcard set. Within a
+ * set they are bucketed by minimum priority, so a log of priority P only
+ * visits the buckets ROUTINE..P of its mission's set and of the wildcard
+ * set, and every subscriber visited is a match.
+ *
+ * By default callbacks run inline in add_communication(). With
+ * start_subscription_dispatcher() matching logs are copied into a bounded
+ * ring and delivered on a dispatcher thread instead; when the ring is full
+ * the event is dropped and counted rather than stalling the writer. The
+ * sets are read-locked both to deliver and to check for a match, so a
+ * slow callback on the dispatcher never holds up add_communication().
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mission_internal.h"
+
+#include <pthread.h>
+
+struct CommSubscription {
+    CommCallback callback;
+    void *user_data;
+    int min_priority;
+    struct SubscriberSet *set;
+    CommSubscription *prev;
+    CommSubscription *next;
+};
+
+typedef struct SubscriberSet {
+    int mission_id;                                 // 0 for the wildcard set
+    CommSubscription *buckets[EMERGENCY + 1];       // Indexed by min_priority
+} SubscriberSet;
+
+typedef struct {
+    int mission_id;
+    CommLog log;
+} CommEvent;
+
+struct SubscriptionRegistry {
+    pthread_rwlock_t lock;              // Shared to deliver or match, exclusive to change sets
+    SubscriberSet wildcard;
+    SubscriberSet **sets;               // Open addressing by mission_id
+    int set_count;
+    int set_capacity;                   // Power of two
+
+    // Dispatcher mode (dispatcher_running != 0)
+    int dispatcher_running;
+    int dispatcher_stopping;
+    pthread_t dispatcher;
+    pthread_mutex_t queue_lock;
+    pthread_cond_t queue_ready;
+    CommEvent *queue;
+    int queue_capacity;
+    int queue_head;
+    int queue_count;
+    long dropped;
+};
+
+/* ========================================
+ * SUBSCRIBER SETS
+ * ======================================== */
+static unsigned int set_slot(int mission_id, int capacity) {
+    return ((unsigned int)mission_id * 2654435769u) & (unsigned int)(capacity - 1);
+}
+
+static SubscriberSet* find_set(const SubscriptionRegistry* registry, int mission_id) {
+    if (mission_id == 0) {
+        return (SubscriberSet*)&registry->wildcard;
+    }
+    if (registry->set_capacity == 0) {
+        return NULL;
+    }
+    unsigned int mask = (unsigned int)(registry->set_capacity - 1);
+    for (unsigned int slot = set_slot(mission_id, registry->set_capacity);
+         registry->sets[slot] != NULL; slot = (slot + 1) & mask) {
+        if (registry->sets[slot]->mission_id == mission_id) {
+            return registry->sets[slot];
+        }
+    }
+    return NULL;
+}
+
+static int grow_sets(SubscriptionRegistry* registry) {
+    int capacity = registry->set_capacity > 0 ? registry->set_capacity * 2 : 16;
+    SubscriberSet **slots = calloc((size_t)capacity, sizeof(SubscriberSet*));
+    if (slots == NULL) {
+        return -1;
+    }
+    for (int i = 0; i < registry->set_capacity; i++) {
+        SubscriberSet *set = registry->sets[i];
+        if (set == NULL) {
+            continue;
+        }
+        unsigned int slot = set_slot(set->mission_id, capacity);
+        while (slots[slot] != NULL) {
+            slot = (slot + 1) & (unsigned int)(capacity - 1);
+        }
+        slots[slot] = set;
+    }
+    free(registry->sets);
+    registry->sets = slots;
+    registry->set_capacity = capacity;
+    return 0;
+}
+
+// Sets are kept once created; there is at most one per subscribed mission ID
+static SubscriberSet* find_or_add_set(SubscriptionRegistry* registry, int mission_id) {
+    SubscriberSet *set = find_set(registry, mission_id);
+    if (set != NULL) {
+        return set;
+    }
+    if ((registry->set_count + 1) * 2 > registry->set_capacity && grow_sets(registry) != 0) {
+        return NULL;
+    }
+    set = calloc(1, sizeof(SubscriberSet));
+    if (set == NULL) {
+        return NULL;
+    }
+    set->mission_id = mission_id;
+    unsigned int slot = set_slot(mission_id, registry->set_capacity);
+    while (registry->sets[slot] != NULL) {
+        slot = (slot + 1) & (unsigned int)(registry->set_capacity - 1);
+    }
+    registry->sets[slot] = set;
+    registry->set_count++;
+    return set;
+}
+
+static int set_has_match(const SubscriberSet* set, MessagePriority priority) {
+    for (int p = ROUTINE; set != NULL && p <= (int)priority; p++) {
+        if (set->buckets[p] != NULL) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void deliver_to_set(const SubscriberSet* set, int mission_id, const CommLog* log) {
+    for (int p = ROUTINE; set != NULL && p <= (int)log->priority; p++) {
+        for (const CommSubscription *sub = set->buckets[p]; sub != NULL; sub = sub->next) {
+            sub->callback(log, mission_id, sub->user_data);
+        }
+    }
+}
+
+static void deliver(SubscriptionRegistry* registry, int mission_id, const CommLog* log) {
+    pthread_rwlock_rdlock(&registry->lock);
+    deliver_to_set(find_set(registry, mission_id), mission_id, log);
+    deliver_to_set(&registry->wildcard, mission_id, log);
+    pthread_rwlock_unlock(&registry->lock);
+}
+
+/* ========================================
+ * DISPATCHER THREAD
+ * ======================================== */
+static void* dispatcher_main(void* arg) {
+    SubscriptionRegistry *registry = arg;
+    CommEvent event;
+    for (;;) {
+        pthread_mutex_lock(&registry->queue_lock);
+        while (registry->queue_count == 0 && !registry->dispatcher_stopping) {
+            pthread_cond_wait(&registry->queue_ready, &registry->queue_lock);
+        }
+        if (registry->queue_count == 0) {
+            pthread_mutex_unlock(&registry->queue_lock);
+            return NULL;
+        }
+        event = registry->queue[registry->queue_head];
+        registry->queue_head = (registry->queue_head + 1) % registry->queue_capacity;
+        registry->queue_count--;
+        pthread_mutex_unlock(&registry->queue_lock);
+
+        deliver(registry, event.mission_id, &event.log);
+    }
+}
+
+static void enqueue_event(SubscriptionRegistry* registry, int mission_id, const CommLog* log) {
+    pthread_mutex_lock(&registry->queue_lock);
+    if (registry->queue_count == registry->queue_capacity) {
+        registry->dropped++;
+    } else {
+        int tail = (registry->queue_head + registry->queue_count) % registry->queue_capacity;
+        registry->queue[tail].mission_id = mission_id;
+        registry->queue[tail].log = *log;
+        registry->queue_count++;
+        pthread_cond_signal(&registry->queue_ready);
+    }
+    pthread_mutex_unlock(&registry->queue_lock);
+}
+
+/* ========================================
+ * WRITER HOOK
+ * ======================================== */
+void notify_subscribers(MissionControl* system, int mission_id, const CommLog* log) {
+    SubscriptionRegistry *registry = MISSION_SYSTEM(system)->subscriptions;
+    if (!registry->dispatcher_running) {
+        deliver(registry, mission_id, log);
+        return;
+    }
+
+    // Only copy the log into the queue if someone will receive it
+    pthread_rwlock_rdlock(&registry->lock);
+    int matched = set_has_match(find_set(registry, mission_id), log->priority) ||
+                  set_has_match(&registry->wildcard, log->priority);
+    pthread_rwlock_unlock(&registry->lock);
+    if (matched) {
+        enqueue_event(registry, mission_id, log);
+    }
+}
+
+/* ========================================
+ * REGISTRY LIFECYCLE
+ * ======================================== */
+static SubscriptionRegistry* get_registry(MissionControl* system) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    if (sys->subscriptions != NULL) {
+        return sys->subscriptions;
+    }
+    SubscriptionRegistry *registry = calloc(1, sizeof(SubscriptionRegistry));
+    if (registry == NULL) {
+        return NULL;
+    }
+    if (pthread_rwlock_init(&registry->lock, NULL) != 0) {
+        free(registry);
+        return NULL;
+    }
+    sys->subscriptions = registry;
+    return registry;
+}
+
+static void free_set_subscriptions(SubscriberSet* set) {
+    for (int p = ROUTINE; p <= EMERGENCY; p++) {
+        CommSubscription *sub = set->buckets[p];
+        while (sub != NULL) {
+            CommSubscription *next = sub->next;
+            free(sub);
+            sub = next;
+        }
+    }
+}
+
+void subscriptions_free(MissionControl* system) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    SubscriptionRegistry *registry = sys->subscriptions;
+    if (registry == NULL) {
+        return;
+    }
+    stop_subscription_dispatcher(system);
+
+    free_set_subscriptions(&registry->wildcard);
+    for (int i = 0; i < registry->set_capacity; i++) {
+        if (registry->sets[i] != NULL) {
+            free_set_subscriptions(registry->sets[i]);
+            free(registry->sets[i]);
+        }
+    }
+    free(registry->sets);
+    pthread_rwlock_destroy(&registry->lock);
+    free(registry);
+    sys->subscriptions = NULL;
+}
+
+/* ========================================
+ * PUBLIC API
+ * ======================================== */
+CommSubscription* subscribe_communications(MissionControl* system, int mission_id,
+                                           MessagePriority min_priority,
+                                           CommCallback callback, void* user_data) {
+    if (system == NULL || mission_id < 0 || callback == NULL ||
+        min_priority < ROUTINE || min_priority > EMERGENCY) {
+        return NULL;
+    }
+    SubscriptionRegistry *registry = get_registry(system);
+    if (registry == NULL) {
+        return NULL;
+    }
+    CommSubscription *sub = calloc(1, sizeof(CommSubscription));
+    if (sub == NULL) {
+        return NULL;
+    }
+    sub->callback = callback;
+    sub->user_data = user_data;
+    sub->min_priority = min_priority;
+
+    pthread_rwlock_wrlock(&registry->lock);
+    SubscriberSet *set = find_or_add_set(registry, mission_id);
+    if (set == NULL) {
+        pthread_rwlock_unlock(&registry->lock);
+        free(sub);
+        return NULL;
+    }
+    sub->set = set;
+    sub->next = set->buckets[min_priority];
+    if (sub->next != NULL) {
+        sub->next->prev = sub;
+    }
+    set->buckets[min_priority] = sub;
+    pthread_rwlock_unlock(&registry->lock);
+    return sub;
+}
+
+int unsubscribe_communications(MissionControl* system, CommSubscription* subscription) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    if (system == NULL || subscription == NULL || sys->subscriptions == NULL) {
+        return -1;
+    }
+    SubscriptionRegistry *registry = sys->subscriptions;
+    pthread_rwlock_wrlock(&registry->lock);
+    if (subscription->prev != NULL) {
+        subscription->prev->next = subscription->next;
+    } else {
+        subscription->set->buckets[subscription->min_priority] = subscription->next;
+    }
+    if (subscription->next != NULL) {
+        subscription->next->prev = subscription->prev;
+    }
+    pthread_rwlock_unlock(&registry->lock);
+    free(subscription);
+    return 0;
+}
+
+int start_subscription_dispatcher(MissionControl* system, int queue_capacity) {
+    if (system == NULL || queue_capacity <= 0) {
+        return -1;
+    }
+    SubscriptionRegistry *registry = get_registry(system);
+    if (registry == NULL) {
+        return -1;
+    }
+    if (registry->dispatcher_running) {
+        return 0;
+    }
+    registry->queue = malloc((size_t)queue_capacity * sizeof(CommEvent));
+    if (registry->queue == NULL) {
+        return -1;
+    }
+    registry->queue_capacity = queue_capacity;
+    registry->queue_head = 0;
+    registry->queue_count = 0;
+    registry->dispatcher_stopping = 0;
+    pthread_mutex_init(&registry->queue_lock, NULL);
+    pthread_cond_init(&registry->queue_ready, NULL);
+    if (pthread_create(&registry->dispatcher, NULL, dispatcher_main, registry) != 0) {
+        pthread_cond_destroy(&registry->queue_ready);
+        pthread_mutex_destroy(&registry->queue_lock);
+        free(registry->queue);
+        registry->queue = NULL;
+        return -1;
+    }
+    registry->dispatcher_running = 1;
+    return 0;
+}
+
+void stop_subscription_dispatcher(MissionControl* system) {
+    MissionSystem *sys = MISSION_SYSTEM(system);
+    if (system == NULL || sys->subscriptions == NULL ||
+        !sys->subscriptions->dispatcher_running) {
+        return;
+    }
+    // Events already queued are delivered before the thread exits
+    SubscriptionRegistry *registry = sys->subscriptions;
+    pthread_mutex_lock(&registry->queue_lock);
+    registry->dispatcher_stopping = 1;
+    pthread_cond_signal(&registry->queue_ready);
+    pthread_mutex_unlock(&registry->queue_lock);
+    pthread_join(registry->dispatcher, NULL);
+
+    pthread_cond_destroy(&registry->queue_ready);
+    pthread_mutex_destroy(&registry->queue_lock);
+    free(registry->queue);
+    registry->queue = NULL;
+    registry->dispatcher_running = 0;
+}
+
+long subscription_events_dropped(const MissionControl* system) {
+    const MissionSystem *sys = MISSION_SYSTEM(system);
+    if (system == NULL || sys->subscriptions == NULL) {
+        return 0;
+    }
+    SubscriptionRegistry *registry = sys->subscriptions;
+    if (!registry->dispatcher_running) {
+        return registry->dropped;   // Only the dispatcher's queue_lock guards it
+    }
+    pthread_mutex_lock(&registry->queue_lock);
+    long dropped = registry->dropped;
+    pthread_mutex_unlock(&registry->queue_lock);
+    return dropped;
+}
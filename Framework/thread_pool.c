@@ -0,0 +1,76 @@
+/**
+ * @file thread_pool.c
+ * @brief Space Mission Control System - Parallel Task Runner
+ *
+ * Minimal fork/join pool for the bulk loaders: a fixed set of POSIX
+ * threads claims task indices from a shared atomic counter until all
+ * tasks are done, then the caller joins them.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mission_internal.h"
+
+#include <pthread.h>
+
+typedef struct {
+    ParallelTask task;
+    void* context;
+    int task_count;
+    int next_task;      // Claimed with __atomic_fetch_add
+} ParallelJob;
+
+static void drain_tasks(ParallelJob* job) {
+    for (;;) {
+        int index = __atomic_fetch_add(&job->next_task, 1, __ATOMIC_RELAXED);
+        if (index >= job->task_count) {
+            return;
+        }
+        job->task(job->context, index);
+    }
+}
+
+static void* worker_main(void* arg) {
+    drain_tasks((ParallelJob*)arg);
+    return NULL;
+}
+
+int run_parallel_tasks(int task_count, int thread_count, ParallelTask task, void* context) {
+    ParallelJob job = { task, context, task_count, 0 };
+    if (task_count <= 0) {
+        return 0;
+    }
+    if (thread_count > task_count) {
+        thread_count = task_count;
+    }
+    if (thread_count <= 1) {
+        drain_tasks(&job);
+        return 0;
+    }
+
+    // The calling thread is one of the workers
+    pthread_t* threads = malloc((size_t)(thread_count - 1) * sizeof(pthread_t));
+    if (threads == NULL) {
+        drain_tasks(&job);
+        return 0;
+    }
+    int started = 0;
+    for (int i = 0; i < thread_count - 1; i++) {
+        if (pthread_create(&threads[i], NULL, worker_main, &job) != 0) {
+            break;
+        }
+        started++;
+    }
+
+    drain_tasks(&job);
+    for (int i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    free(threads);
+    return 0;
+}
+
+int online_cpu_count(void) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return cpus > 0 ? (int)cpus : 1;
+}
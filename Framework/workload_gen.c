@@ -0,0 +1,335 @@
+/**
+ * @file workload_gen.c
+ * @brief Space Mission Control System - Synthetic Workload Generator
+ *
+ * Produces large TEST_* command streams (and optionally a mission data
+ * file for TEST_LOAD_FILE) whose expected results are exact, so the
+ * streams can be replayed through `space_mission --replay` to load-test
+ * the core at millions of operations.
+ *
+ * Usage: space_mission_gen [options]
+ *   -n count     Total commands to generate (default 100000)
+ *   -r ratio     ADD_COMM commands per CREATE_MISSION command (default 20)
+ *   -p r:u:e     Priority mix weights, routine:urgent:emergency (default 70:25:5)
+ *   -e rate      Fraction of commands that are deliberately invalid (default 0.05)
+ *   -k skew      Hot-mission skew exponent (integer), 1 = uniform (default 2)
+ *   -c capacity  Capacity for TEST_CREATE_SYSTEM (default 16)
+ *   -l count     Also write a mission data file with this many missions
+ *   -d file      Mission data file name (default generated_missions_data.txt)
+ *   -o file      Command stream output (default stdout)
+ *   -s seed      RNG seed (default 1)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ========================================
+ * GENERATOR CONFIGURATION
+ * ======================================== */
+typedef struct {
+    long commands;
+    double comm_ratio;
+    int priority_weights[3];
+    double error_rate;
+    int skew;
+    int capacity;
+    long load_missions;
+    const char* data_file;
+    const char* output_file;
+    unsigned long long seed;
+} GenConfig;
+
+/* ========================================
+ * RANDOM NUMBER GENERATION (xorshift64*)
+ * ======================================== */
+static unsigned long long g_rng_state = 1;
+
+static unsigned long long rng_next(void) {
+    g_rng_state ^= g_rng_state >> 12;
+    g_rng_state ^= g_rng_state << 25;
+    g_rng_state ^= g_rng_state >> 27;
+    return g_rng_state * 2685821657736338717ULL;
+}
+
+static double rng_uniform(void) {
+    return (double)(rng_next() >> 11) / 9007199254740992.0;
+}
+
+static long rng_below(long n) {
+    return (long)(rng_next() % (unsigned long long)n);
+}
+
+static double rng_pow(double x, int exponent) {
+    double result = x;
+    for (int i = 1; i < exponent; i++) {
+        result *= x;
+    }
+    return result;
+}
+
+/* ========================================
+ * CALENDAR HELPERS
+ * ======================================== */
+static void civil_from_days(long days, int* year, int* month, int* day) {
+    // Howard Hinnant's days -> (y, m, d) for the proleptic Gregorian calendar
+    days += 719468;
+    long era = (days >= 0 ? days : days - 146096) / 146097;
+    long doe = days - era * 146097;
+    long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    long mp = (5 * doy + 2) / 153;
+    long d = doy - (153 * mp + 2) / 5 + 1;
+    long m = mp < 10 ? mp + 3 : mp - 9;
+    *year = (int)(yoe + era * 400 + (m <= 2));
+    *month = (int)m;
+    *day = (int)d;
+}
+
+static void format_timestamp(long minutes, char* out, size_t size) {
+    int year, month, day;
+    civil_from_days(minutes / 1440, &year, &month, &day);
+    snprintf(out, size, "%04d-%02d-%02d_%02ld:%02ld",
+             year, month, day, (minutes / 60) % 24, minutes % 60);
+}
+
+static void format_launch_date(char* out, size_t size) {
+    // 2024-01-01 is day 19723 since 1970-01-01; spread over ~6 years
+    int year, month, day;
+    civil_from_days(19723 + rng_below(6 * 365), &year, &month, &day);
+    snprintf(out, size, "%04d-%02d-%02d", year, month, day);
+}
+
+/* ========================================
+ * MESSAGE VOCABULARY
+ * ======================================== */
+static const char* g_routine_messages[] = {
+    "Telemetry_nominal", "Orbit_adjustment_complete", "Crew_status_green",
+    "Daily_systems_check_complete", "Solar_array_output_steady",
+};
+static const char* g_urgent_messages[] = {
+    "Thruster_pressure_drop", "Comm_link_degraded", "Thermal_limit_approaching",
+    "Navigation_drift_detected",
+};
+static const char* g_emergency_messages[] = {
+    "Cabin_pressure_loss", "Fire_alarm_module_B", "Collision_avoidance_required",
+};
+
+#define COUNT_OF(a) ((long)(sizeof(a) / sizeof((a)[0])))
+
+static const char* pick_message(int priority) {
+    switch (priority) {
+        case 1: return g_routine_messages[rng_below(COUNT_OF(g_routine_messages))];
+        case 2: return g_urgent_messages[rng_below(COUNT_OF(g_urgent_messages))];
+        default: return g_emergency_messages[rng_below(COUNT_OF(g_emergency_messages))];
+    }
+}
+
+static int pick_priority(const GenConfig* cfg) {
+    int total = cfg->priority_weights[0] + cfg->priority_weights[1] + cfg->priority_weights[2];
+    long roll = rng_below(total);
+    if (roll < cfg->priority_weights[0]) return 1;
+    if (roll < cfg->priority_weights[0] + cfg->priority_weights[1]) return 2;
+    return 3;
+}
+
+/* ========================================
+ * GENERATION
+ * ======================================== */
+static int write_data_file(const GenConfig* cfg) {
+    FILE* fp = fopen(cfg->data_file, "w");
+    if (fp == NULL) {
+        perror(cfg->data_file);
+        return -1;
+    }
+    char date[16];
+    fprintf(fp, "%ld\n", cfg->load_missions);
+    for (long i = 1; i <= cfg->load_missions; i++) {
+        format_launch_date(date, sizeof(date));
+        fprintf(fp, "%ld Catalog_Mission_%ld %s\n", i, i, date);
+    }
+    if (fclose(fp) != 0) {
+        perror(cfg->data_file);
+        return -1;
+    }
+    return 0;
+}
+
+static long pick_existing_mission(const GenConfig* cfg, long mission_count) {
+    // Skewed toward low IDs so a few missions are "hot"
+    long index = (long)(rng_pow(rng_uniform(), cfg->skew) * (double)mission_count);
+    if (index >= mission_count) {
+        index = mission_count - 1;
+    }
+    return index + 1;
+}
+
+static void generate_create(FILE* out, const GenConfig* cfg, long* mission_count) {
+    char date[16];
+    format_launch_date(date, sizeof(date));
+
+    if (rng_uniform() < cfg->error_rate) {
+        switch (rng_below(3)) {
+            case 0:
+                if (*mission_count > 0) {
+                    long dup = 1 + rng_below(*mission_count);
+                    fprintf(out, "TEST_CREATE_MISSION %ld Duplicate_%ld %s FAILURE\n", dup, dup, date);
+                    return;
+                }
+                /* fall through */
+            case 1:
+                fprintf(out, "TEST_CREATE_MISSION %ld Bad_Date_%ld 2024-13-40 FAILURE\n",
+                        *mission_count + 1, *mission_count + 1);
+                return;
+            default:
+                fprintf(out, "TEST_CREATE_MISSION 0 Zero_ID %s FAILURE\n", date);
+                return;
+        }
+    }
+
+    (*mission_count)++;
+    fprintf(out, "TEST_CREATE_MISSION %ld Mission_%ld %s SUCCESS\n",
+            *mission_count, *mission_count, date);
+}
+
+static void generate_comm(FILE* out, const GenConfig* cfg, long mission_count, long* clock) {
+    char timestamp[32];
+    *clock += rng_below(3);
+    format_timestamp(*clock, timestamp, sizeof(timestamp));
+
+    int priority = pick_priority(cfg);
+    const char* message = pick_message(priority);
+
+    if (mission_count == 0 || rng_uniform() < cfg->error_rate) {
+        switch (mission_count == 0 ? 0 : rng_below(3)) {
+            case 0:
+                fprintf(out, "TEST_ADD_COMM %ld %s %d %s FAILURE\n",
+                        mission_count + 1 + rng_below(1000), timestamp, priority, message);
+                return;
+            case 1:
+                fprintf(out, "TEST_ADD_COMM %ld bad_timestamp %d %s FAILURE\n",
+                        pick_existing_mission(cfg, mission_count), priority, message);
+                return;
+            default:
+                fprintf(out, "TEST_ADD_COMM %ld %s 99 %s FAILURE\n",
+                        pick_existing_mission(cfg, mission_count), timestamp, message);
+                return;
+        }
+    }
+
+    fprintf(out, "TEST_ADD_COMM %ld %s %d %s SUCCESS\n",
+            pick_existing_mission(cfg, mission_count), timestamp, priority, message);
+}
+
+static int generate(const GenConfig* cfg) {
+    if (cfg->load_missions > 0 && write_data_file(cfg) != 0) {
+        return -1;
+    }
+
+    FILE* out = stdout;
+    if (cfg->output_file != NULL) {
+        out = fopen(cfg->output_file, "w");
+        if (out == NULL) {
+            perror(cfg->output_file);
+            return -1;
+        }
+    }
+
+    fprintf(out, "# Generated workload: %ld commands, comm ratio %.2f, priority mix %d:%d:%d, "
+                 "error rate %.3f, seed %llu\n",
+            cfg->commands, cfg->comm_ratio, cfg->priority_weights[0], cfg->priority_weights[1],
+            cfg->priority_weights[2], cfg->error_rate, cfg->seed);
+
+    long emitted = 0;
+    long mission_count = 0;
+    long clock = 19723L * 1440;  // 2024-01-01 00:00 in minutes since epoch
+
+    fprintf(out, "TEST_CREATE_SYSTEM %d SUCCESS\n", cfg->capacity);
+    emitted++;
+    if (cfg->load_missions > 0) {
+        fprintf(out, "TEST_LOAD_FILE %s SUCCESS\n", cfg->data_file);
+        mission_count = cfg->load_missions;
+        emitted++;
+    }
+
+    double create_probability = 1.0 / (1.0 + cfg->comm_ratio);
+    while (emitted < cfg->commands - 1) {
+        if (mission_count == 0 || rng_uniform() < create_probability) {
+            generate_create(out, cfg, &mission_count);
+        } else {
+            generate_comm(out, cfg, mission_count, &clock);
+        }
+        emitted++;
+    }
+
+    fprintf(out, "TEST_FREE_SYSTEM SUCCESS\n");
+
+    if (out != stdout && fclose(out) != 0) {
+        perror(cfg->output_file);
+        return -1;
+    }
+    return 0;
+}
+
+/* ========================================
+ * MAIN FUNCTION
+ * ======================================== */
+static void usage(const char* prog) {
+    fprintf(stderr, "Usage: %s [-n count] [-r ratio] [-p r:u:e] [-e rate] [-k skew] "
+                    "[-c capacity] [-l count] [-d file] [-o file] [-s seed]\n", prog);
+}
+
+int main(int argc, char* argv[]) {
+    GenConfig cfg = {
+        .commands = 100000,
+        .comm_ratio = 20.0,
+        .priority_weights = {70, 25, 5},
+        .error_rate = 0.05,
+        .skew = 2,
+        .capacity = 16,
+        .load_missions = 0,
+        .data_file = "generated_missions_data.txt",
+        .output_file = NULL,
+        .seed = 1,
+    };
+
+    for (int i = 1; i < argc; i++) {
+        if (argv[i][0] != '-' || argv[i][1] == '\0' || argv[i][2] != '\0' || i + 1 >= argc) {
+            usage(argv[0]);
+            return 1;
+        }
+        const char* value = argv[++i];
+        switch (argv[i - 1][1]) {
+            case 'n': cfg.commands = atol(value); break;
+            case 'r': cfg.comm_ratio = atof(value); break;
+            case 'p':
+                if (sscanf(value, "%d:%d:%d", &cfg.priority_weights[0],
+                           &cfg.priority_weights[1], &cfg.priority_weights[2]) != 3) {
+                    usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'e': cfg.error_rate = atof(value); break;
+            case 'k': cfg.skew = atoi(value); break;
+            case 'c': cfg.capacity = atoi(value); break;
+            case 'l': cfg.load_missions = atol(value); break;
+            case 'd': cfg.data_file = value; break;
+            case 'o': cfg.output_file = value; break;
+            case 's': cfg.seed = strtoull(value, NULL, 10); break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (cfg.commands < 2 || cfg.comm_ratio < 0 || cfg.error_rate < 0 || cfg.error_rate > 1 ||
+        cfg.skew < 1 || cfg.capacity <= 0 || cfg.load_missions < 0 ||
+        cfg.priority_weights[0] < 0 || cfg.priority_weights[1] < 0 || cfg.priority_weights[2] < 0 ||
+        cfg.priority_weights[0] + cfg.priority_weights[1] + cfg.priority_weights[2] <= 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    g_rng_state = cfg.seed != 0 ? cfg.seed : 1;
+    return generate(&cfg) == 0 ? 0 : 1;
+}